@@ -0,0 +1,239 @@
+#pragma once
+
+#include <boost/signals2/connection.hpp>
+#include <wechat/core/Event.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace wechat {
+namespace core {
+
+/// 队列满时的处理策略
+enum class OverflowPolicy {
+    Block,      // 发布方阻塞直到有空位
+    DropOldest, // 丢弃队首（最旧）的事件
+    Coalesce,   // 用新事件替换队列中最近一个同类型同主题键的事件，
+                // 找不到可合并的事件时退化为 DropOldest
+};
+
+struct AsyncEventBusOptions {
+    std::size_t capacity = 4096; // 每个优先级道的容量
+    OverflowPolicy overflow = OverflowPolicy::Block;
+    std::size_t maxBatch = 256; // 分发线程一次取出的最大事件数
+    // 非空的低优先级道连续被高优先级道抢先这么多批后，下一批必须轮到它
+    std::size_t starvationLimit = 8;
+};
+
+/// 单个优先级道的统计
+struct LaneStats {
+    std::size_t depth = 0; // 当前排队数
+    std::uint64_t published = 0;
+    std::uint64_t dispatched = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t coalesced = 0;
+    // 入队到开始分发的等待时间
+    std::chrono::microseconds totalLatency{0};
+    std::chrono::microseconds maxLatency{0};
+
+    [[nodiscard]] std::chrono::microseconds averageLatency() const {
+        return dispatched ? totalLatency / static_cast<std::int64_t>(dispatched)
+                          : std::chrono::microseconds{0};
+    }
+};
+
+struct AsyncEventBusStats {
+    // 以下为所有道的合计
+    std::uint64_t published = 0;
+    std::uint64_t dispatched = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t coalesced = 0;
+    std::uint64_t batches = 0;
+    // 按 EventPriority 下标
+    std::array<LaneStats, EventPriorityCount> lanes{};
+
+    [[nodiscard]] LaneStats const &lane(EventPriority priority) const {
+        return lanes[static_cast<std::size_t>(priority)];
+    }
+};
+
+/// 一批同类型、同主题键的事件（只读视图，不拷贝）
+template <typename T> class EventBatch {
+public:
+    class Iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        explicit Iterator(Event const *pos) : pos(pos) {}
+
+        T const &operator*() const { return *std::get_if<T>(pos); }
+        T const *operator->() const { return std::get_if<T>(pos); }
+        Iterator &operator++() {
+            ++pos;
+            return *this;
+        }
+        Iterator operator++(int) { return Iterator(pos++); }
+        bool operator==(Iterator const &) const = default;
+
+    private:
+        Event const *pos = nullptr;
+    };
+
+    explicit EventBatch(std::span<Event const> events) : events(events) {}
+
+    [[nodiscard]] std::size_t size() const { return events.size(); }
+    [[nodiscard]] bool empty() const { return events.empty(); }
+    T const &operator[](std::size_t i) const {
+        return *std::get_if<T>(&events[i]);
+    }
+    T const &front() const { return (*this)[0]; }
+    T const &back() const { return (*this)[size() - 1]; }
+    Iterator begin() const { return Iterator(events.data()); }
+    Iterator end() const { return Iterator(events.data() + events.size()); }
+
+    /// 这批事件共同的主题键（无键类型为空）
+    [[nodiscard]] std::string_view key() const {
+        return events.empty() ? std::string_view{} : topicKey(events.front());
+    }
+
+private:
+    std::span<Event const> events;
+};
+
+/// 异步事件总线
+///
+/// publish 只把事件放进有界队列就返回，由总线自己的分发线程按发布顺序
+/// 调用订阅者，慢订阅者（UI、存储）不会拖住发布方（网络线程）。
+///
+/// 用法:
+///   AsyncEventBus bus({.capacity = 1024,
+///                      .overflow = OverflowPolicy::DropOldest});
+///
+///   // 逐条订阅，用法与 EventBus 相同，但回调在分发线程上执行
+///   bus.subscribe<MessageReceived>([](const MessageReceived& ev) { ... });
+///
+///   // 批量订阅：每次收到分发线程一轮取出的、同一会话的所有新消息
+///   bus.subscribeBatch<MessageReceived>(
+///       [](EventBatch<MessageReceived> batch) {
+///           // batch.key() 条会话里来了 batch.size() 条新消息
+///       });
+///
+///   bus.publish(MessageReceived{makeSnapshot(msg)});
+///   bus.flush(); // 等待已发布的事件全部分发完
+///
+/// 同一批次内，逐条订阅者先按发布顺序收到全部事件，批量订阅者随后按
+/// (类型, 主题键) 分组收到；组内保持发布顺序。
+///
+/// 事件按 EventPriority 进入不同的道，每批只从一个道取：总是先取最高
+/// 优先级的非空道，因此排队中的低优先级事件会被后来的高优先级事件超过。
+/// 为防止饿死，非空道连续被跳过 starvationLimit 批后优先取它。
+/// 同一道内保持发布顺序，不同道之间不保证。
+/// 析构时会先分发完队列中剩余的事件再停止分发线程。
+class AsyncEventBus {
+public:
+    explicit AsyncEventBus(AsyncEventBusOptions options = {});
+    ~AsyncEventBus();
+
+    AsyncEventBus(AsyncEventBus const &) = delete;
+    AsyncEventBus &operator=(AsyncEventBus const &) = delete;
+
+    /// 订阅所有事件
+    boost::signals2::connection
+    subscribe(std::function<void(Event const &)> handler);
+
+    /// 按类型订阅
+    template <typename T>
+    boost::signals2::connection
+    subscribe(std::function<void(T const &)> handler) {
+        return subscribeType(EventIndex<T>,
+                             [h = std::move(handler)](Event const &e) {
+                                 h(*std::get_if<T>(&e));
+                             });
+    }
+
+    /// 按类型 + 主题键订阅
+    template <typename T>
+    boost::signals2::connection
+    subscribe(std::string key, std::function<void(T const &)> handler) {
+        return subscribeTopic(EventIndex<T>, std::move(key),
+                              [h = std::move(handler)](Event const &e) {
+                                  h(*std::get_if<T>(&e));
+                              });
+    }
+
+    /// 批量订阅 T 类型事件，每个主题键一次回调
+    template <typename T>
+    boost::signals2::connection
+    subscribeBatch(std::function<void(EventBatch<T>)> handler) {
+        return subscribeBatchType(
+            EventIndex<T>,
+            [h = std::move(handler)](std::span<Event const> events) {
+                h(EventBatch<T>(events));
+            });
+    }
+
+    /// 批量订阅主题键为 key 的 T 类型事件
+    template <typename T>
+    boost::signals2::connection
+    subscribeBatch(std::string key,
+                   std::function<void(EventBatch<T>)> handler) {
+        return subscribeBatchTopic(
+            EventIndex<T>, std::move(key),
+            [h = std::move(handler)](std::span<Event const> events) {
+                h(EventBatch<T>(events));
+            });
+    }
+
+    /// 发布事件（入队），优先级取 defaultPriority(event)
+    /// 队列满时按 OverflowPolicy 处理；在分发线程内（订阅回调中）发布时
+    /// 不会阻塞，允许暂时超出容量
+    void publish(Event event);
+
+    /// 以指定优先级发布事件
+    void publish(Event event, EventPriority priority);
+
+    /// 阻塞到此前发布的事件全部分发完；在分发线程内调用时直接返回
+    void flush();
+
+    /// 所有道中尚未分发的事件数
+    [[nodiscard]] std::size_t pending() const;
+
+    /// 指定道中尚未分发的事件数
+    [[nodiscard]] std::size_t pending(EventPriority priority) const;
+
+    [[nodiscard]] AsyncEventBusStats stats() const;
+
+    /// 获取当前订阅者数量（逐条 + 批量）
+    [[nodiscard]] std::size_t subscriberCount() const;
+
+    /// 当前登记的主题键数量（逐条 + 批量，诊断用），回收规则同 EventBus
+    [[nodiscard]] std::size_t topicCount() const;
+
+private:
+    boost::signals2::connection
+    subscribeType(std::size_t typeIndex,
+                  std::function<void(Event const &)> handler);
+    boost::signals2::connection
+    subscribeTopic(std::size_t typeIndex, std::string key,
+                   std::function<void(Event const &)> handler);
+    boost::signals2::connection
+    subscribeBatchType(std::size_t typeIndex,
+                       std::function<void(std::span<Event const>)> handler);
+    boost::signals2::connection
+    subscribeBatchTopic(std::size_t typeIndex, std::string key,
+                        std::function<void(std::span<Event const>)> handler);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace core
+} // namespace wechat
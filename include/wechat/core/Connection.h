@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+
+namespace wechat {
+namespace core {
+
+/// 连接体：由具体的事件总线实现
+class ConnectionBody {
+public:
+    virtual ~ConnectionBody() = default;
+    virtual void disconnect() = 0;
+    [[nodiscard]] virtual bool connected() const = 0;
+};
+
+/// 订阅连接句柄（语义同 boost::signals2::connection）
+///
+/// 可复制；断开后所有副本都变为未连接。总线析构后自动视为未连接。
+class Connection {
+public:
+    Connection() = default;
+    explicit Connection(std::weak_ptr<ConnectionBody> body)
+        : body(std::move(body)) {}
+
+    void disconnect() const {
+        if (auto b = body.lock()) b->disconnect();
+    }
+
+    [[nodiscard]] bool connected() const {
+        auto b = body.lock();
+        return b && b->connected();
+    }
+
+private:
+    std::weak_ptr<ConnectionBody> body;
+};
+
+/// 作用域连接（语义同 boost::signals2::scoped_connection）：析构时自动断开
+class ScopedConnection {
+public:
+    ScopedConnection() = default;
+    ScopedConnection(Connection conn) : conn(std::move(conn)) {}
+    ~ScopedConnection() { conn.disconnect(); }
+
+    ScopedConnection(ScopedConnection &&other) noexcept
+        : conn(std::move(other.conn)) {
+        other.conn = Connection{};
+    }
+    ScopedConnection &operator=(ScopedConnection &&other) noexcept {
+        if (this != &other) {
+            conn.disconnect();
+            conn = std::move(other.conn);
+            other.conn = Connection{};
+        }
+        return *this;
+    }
+    ScopedConnection(ScopedConnection const &) = delete;
+    ScopedConnection &operator=(ScopedConnection const &) = delete;
+
+    void disconnect() const { conn.disconnect(); }
+    [[nodiscard]] bool connected() const { return conn.connected(); }
+
+    /// 放弃管理，返回原连接（不断开）
+    Connection release() {
+        auto released = std::move(conn);
+        conn = Connection{};
+        return released;
+    }
+
+private:
+    Connection conn;
+};
+
+} // namespace core
+} // namespace wechat
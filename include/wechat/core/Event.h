@@ -1,5 +1,10 @@
 #pragma once
 
+#include <wechat/core/Message.h>
+
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 
 namespace wechat::core {
@@ -7,6 +12,56 @@ namespace wechat::core {
 // TODO: 替换为实际的事件类型
 struct PlaceholderEvent {};
 
-using Event = std::variant<std::monostate,PlaceholderEvent>;
+/// 收到新消息（共享快照，分发给多个订阅者时不拷贝消息）
+struct MessageReceived {
+    MessagePtr message;
+};
+
+using Event = std::variant<std::monostate, PlaceholderEvent, MessageReceived>;
+
+namespace detail {
+
+template <typename T, typename... Ts>
+constexpr std::size_t variantIndexOf(std::variant<Ts...> const *) {
+    constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) return i;
+    }
+    return sizeof...(Ts);
+}
+
+} // namespace detail
+
+/// 事件类型 T 在 Event 中的下标
+template <typename T>
+inline constexpr std::size_t EventIndex =
+    detail::variantIndexOf<T>(static_cast<Event const *>(nullptr));
+
+/// 事件类型总数
+inline constexpr std::size_t EventTypeCount = std::variant_size_v<Event>;
+
+/// 事件优先级（AsyncEventBus 按优先级分道排队）
+enum class EventPriority {
+    High,   // 用户可见、需要立即响应的事件，如当前会话的新消息
+    Normal,
+    Low,    // 批量后台事件，如历史同步、已读回执
+};
+
+/// 优先级道数
+inline constexpr std::size_t EventPriorityCount = 3;
+
+/// 事件类型的默认优先级，publish 未显式指定时使用
+inline EventPriority defaultPriority(Event const &event) {
+    if (std::holds_alternative<MessageReceived>(event))
+        return EventPriority::High;
+    return EventPriority::Normal;
+}
+
+/// 事件的主题键（用于按键订阅），无键事件返回空
+inline std::string_view topicKey(Event const &event) {
+    if (auto *e = std::get_if<MessageReceived>(&event))
+        return e->message ? e->message->chatId.str() : std::string_view{};
+    return {};
+}
 
 } // namespace wechat::core
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <string>
 #include <wechat/core/Event.h>
 
 namespace wechat {
@@ -22,8 +23,14 @@ namespace core {
 ///       }, e);
 ///   });
 ///
+///   // 按类型订阅：只收到 MessageReceived
+///   bus.subscribe<MessageReceived>([](const MessageReceived& ev) { /* ... */ });
+///
+///   // 按主题键订阅：只收到 chatId == "g1" 的 MessageReceived
+///   bus.subscribe<MessageReceived>("g1", [](const MessageReceived& ev) { /* ... */ });
+///
 ///   // 发布
-///   bus.publish(MessageReceived{msg});
+///   bus.publish(MessageReceived{makeSnapshot(msg)});
 ///
 ///   // 断开
 ///   conn.disconnect();
@@ -45,13 +52,49 @@ public:
     boost::signals2::connection
     subscribe(std::function<void(Event const &)> handler);
 
-    /// 发布事件，分发给所有订阅者
+    /// 按类型订阅，只分发 T 类型的事件
+    template <typename T>
+    boost::signals2::connection
+    subscribe(std::function<void(T const &)> handler) {
+        return subscribeType(EventIndex<T>,
+                             [h = std::move(handler)](Event const &e) {
+                                 h(*std::get_if<T>(&e));
+                             });
+    }
+
+    /// 按类型 + 主题键订阅，只分发 topicKey(event) == key 的 T 类型事件
+    template <typename T>
+    boost::signals2::connection
+    subscribe(std::string key, std::function<void(T const &)> handler) {
+        return subscribeTopic(EventIndex<T>, std::move(key),
+                              [h = std::move(handler)](Event const &e) {
+                                  h(*std::get_if<T>(&e));
+                              });
+    }
+
+    /// 发布事件，分发给全量订阅者、该类型订阅者和该主题订阅者
     void publish(Event const &event);
 
-    /// 获取当前订阅者数量
+    /// 获取当前订阅者数量（全量 + 类型 + 主题）
     [[nodiscard]] std::size_t subscriberCount() const;
 
+    /// 当前登记的主题键数量（诊断用）
+    ///
+    /// 订阅者全部断开的键在下一次发布到该键时删除；之后再没有事件的键
+    /// 在新增主题键时摊还清扫，不会无限累积。
+    [[nodiscard]] std::size_t topicCount() const;
+
 private:
+    // AsyncEventBus 在分发线程上复用本类做逐条分发
+    friend class AsyncEventBus;
+
+    boost::signals2::connection
+    subscribeType(std::size_t typeIndex,
+                  std::function<void(Event const &)> handler);
+    boost::signals2::connection
+    subscribeTopic(std::size_t typeIndex, std::string key,
+                   std::function<void(Event const &)> handler);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
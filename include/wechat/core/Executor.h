@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace wechat {
+namespace core {
+
+/// 任务优先级：同一队列中总是先取高优先级
+enum class TaskPriority {
+    High,   // 用户等待结果的任务，如打开会话时的解码
+    Normal,
+    Low,    // 后台维护，如过期会话回收、索引重建
+};
+
+inline constexpr std::size_t TaskPriorityCount = 3;
+
+/// 任务在开始执行前被取消，future.get() 抛出
+class TaskCancelled : public std::runtime_error {
+public:
+    TaskCancelled() : std::runtime_error("task cancelled") {}
+};
+
+/// 取消令牌（只读端），默认构造的令牌永不取消
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    [[nodiscard]] bool cancelled() const {
+        return state && state->load(std::memory_order_acquire);
+    }
+
+private:
+    friend class CancellationSource;
+    explicit CancellationToken(std::shared_ptr<std::atomic<bool>> state)
+        : state(std::move(state)) {}
+
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+/// 取消令牌的控制端
+///
+/// 取消只影响尚未开始的任务；已在执行的任务可自行轮询 token.cancelled()。
+class CancellationSource {
+public:
+    CancellationSource()
+        : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+    [[nodiscard]] CancellationToken token() const {
+        return CancellationToken(state);
+    }
+    void cancel() { state->store(true, std::memory_order_release); }
+    [[nodiscard]] bool cancelled() const {
+        return state->load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+struct ExecutorOptions {
+    std::size_t threads = 0; // 0 = 硬件线程数
+    /// 在调用方线程同步执行每个任务，不创建线程（用于测试）
+    bool runInline = false;
+};
+
+struct ExecutorStats {
+    std::size_t queueDepth = 0; // 当前排队数
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t cancelled = 0;
+    std::uint64_t steals = 0; // 从其他线程队列窃取的任务数
+    // 入队到开始执行的等待时间
+    std::chrono::microseconds totalLatency{0};
+    std::chrono::microseconds maxLatency{0};
+
+    [[nodiscard]] std::chrono::microseconds averageLatency() const {
+        auto started = completed + cancelled;
+        return started ? totalLatency / static_cast<std::int64_t>(started)
+                       : std::chrono::microseconds{0};
+    }
+};
+
+/// 工作窃取线程池，供 storage / network 等模块的后台任务共用
+///
+/// - 每个工作线程有自己的按优先级分层的双端队列：工作线程提交的任务
+///   进入自己的队列，外部提交的任务轮流分配到各线程队列
+/// - 线程优先从自己的队列取任务，空闲时按优先级从其他线程的队列头部窃取
+/// - submit 返回 std::future；任务异常通过 future 传递，
+///   开始前被取消的任务得到 TaskCancelled
+/// - 析构时执行完所有已提交的任务再退出
+///
+/// 用法:
+///   Executor pool;
+///   auto f = pool.submit([] { return decode(); }, TaskPriority::High);
+///   CancellationSource cancel;
+///   pool.post([] { reindex(); }, TaskPriority::Low, cancel.token());
+class Executor {
+public:
+    using Task = std::move_only_function<void()>;
+
+    explicit Executor(ExecutorOptions options = {});
+    ~Executor();
+
+    Executor(Executor const &) = delete;
+    Executor &operator=(Executor const &) = delete;
+
+    template <typename F>
+    auto submit(F &&fn, TaskPriority priority = TaskPriority::Normal,
+                CancellationToken token = {})
+        -> std::future<std::invoke_result_t<std::decay_t<F> &>> {
+        using R = std::invoke_result_t<std::decay_t<F> &>;
+        auto promise = std::make_shared<std::promise<R>>();
+        auto future = promise->get_future();
+        enqueue(
+            [promise, fn = std::forward<F>(fn)]() mutable {
+                try {
+                    if constexpr (std::is_void_v<R>) {
+                        fn();
+                        promise->set_value();
+                    } else {
+                        promise->set_value(fn());
+                    }
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            },
+            [promise] {
+                promise->set_exception(
+                    std::make_exception_ptr(TaskCancelled()));
+            },
+            priority, std::move(token));
+        return future;
+    }
+
+    /// 提交不关心结果的任务；任务抛出的异常记录日志后丢弃
+    void post(Task task, TaskPriority priority = TaskPriority::Normal,
+              CancellationToken token = {});
+
+    /// 阻塞直到队列为空且没有正在执行的任务
+    void waitIdle();
+
+    [[nodiscard]] std::size_t threadCount() const;
+    /// 当前线程是否是本线程池的工作线程
+    [[nodiscard]] bool inWorkerThread() const;
+    [[nodiscard]] ExecutorStats stats() const;
+
+private:
+    void enqueue(Task run, Task onCancel, TaskPriority priority,
+                 CancellationToken token);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace core
+} // namespace wechat
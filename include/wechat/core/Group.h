@@ -1,15 +1,15 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <wechat/core/Id.h>
+#include <wechat/core/IdSet.h>
 
 namespace wechat {
 namespace core {
 
 struct Group {
-    std::string id;
-    std::string ownerId;
-    std::vector<std::string> memberIds;
+    Id id;
+    Id ownerId;
+    IdSet memberIds; // 按句柄有序，contains 为 O(log n)
 };
 
 } // namespace core
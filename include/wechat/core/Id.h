@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace wechat {
+namespace core {
+
+/// 驻留字符串 ID
+///
+/// 所有 ID 字符串在进程级的驻留表中只存一份，Id 本身只是 32 位句柄：
+/// - 拷贝、比较、哈希都是整数操作，不再比较字符串
+/// - 驻留表线程安全，条目永不释放，str() 返回的引用在进程内一直有效
+///
+/// 从字符串构造会把字符串永久加入驻留表，因此构造是 explicit 的：
+/// 只在确实要保存该 ID 时（注册、建群、发消息、读库）构造；按客户端传入
+/// 的字符串查找时用 Id::find，未知字符串不会进入驻留表。
+/// 转回 std::string 仍是隐式的，存储层（SQLite）和网络层（接口参数、
+/// protobuf）按字符串收发。
+///
+/// 注意：operator< 按句柄（即驻留先后）排序，不是字典序；
+/// 需要字典序时比较 str()。
+class Id {
+public:
+    /// 空 ID（句柄 0，对应空字符串）
+    Id() = default;
+
+    /// 驻留 text 并返回其句柄；驻留表句柄耗尽时终止进程
+    explicit Id(std::string_view text);
+    explicit Id(std::string const &text) : Id(std::string_view(text)) {}
+    explicit Id(char const *text) : Id(std::string_view(text)) {}
+
+    /// 只查不驻留：text 未驻留过时返回空 ID
+    [[nodiscard]] static Id find(std::string_view text);
+
+    /// 驻留表中的字符串
+    [[nodiscard]] std::string const &str() const;
+
+    /// 隐式转换，便于传给以 std::string 为参数的存储 / 网络接口
+    operator std::string const &() const { return str(); }
+
+    [[nodiscard]] bool empty() const { return handle == 0; }
+    [[nodiscard]] std::uint32_t value() const { return handle; }
+
+    friend bool operator==(Id, Id) = default;
+    /// 与字符串比较，不驻留
+    friend bool operator==(Id id, std::string_view text) {
+        return id.str() == text;
+    }
+    friend std::strong_ordering operator<=>(Id, Id) = default;
+
+    friend std::ostream &operator<<(std::ostream &os, Id id) {
+        return os << id.str();
+    }
+
+    /// 已驻留的字符串数（含空字符串）
+    static std::size_t internedCount();
+
+private:
+    std::uint32_t handle = 0;
+};
+
+} // namespace core
+} // namespace wechat
+
+template <> struct std::hash<wechat::core::Id> {
+    std::size_t operator()(wechat::core::Id id) const noexcept {
+        // 句柄是连续小整数，乘以黄金比例常数打散到高位
+        return static_cast<std::size_t>(id.value()) * 0x9E3779B97F4A7C15ULL;
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wechat {
+namespace core {
+
+/// Snowflake 风格的 64 位 ID 生成器
+///
+/// 布局（高位到低位）：1 位保留 | 41 位毫秒时间戳（相对 Epoch）|
+/// 10 位节点号 | 12 位序列号。
+///
+/// - next() 无锁：一个原子变量保存 (时间戳, 序列号)，CAS 推进
+/// - 同一节点生成的 ID 严格递增；不同节点的 ID 按毫秒粗略有序（k-sortable）
+/// - 同一毫秒内序列号耗尽时借用下一毫秒，时钟回拨时沿用上次的时间戳，
+///   两种情况都不会产生重复或倒序
+///
+/// ID 在内部以整数比较；只在需要字符串的边界（core::Id、数据库、协议）
+/// 用 format() 转为定长字符串，字典序与数值序一致，可直接作为分页键。
+class IdGenerator {
+public:
+    /// 时间源，返回 Unix 毫秒
+    using Clock = std::function<int64_t()>;
+
+    static constexpr int SequenceBits = 12;
+    static constexpr int NodeBits = 10;
+    static constexpr int TimestampBits = 41;
+    static constexpr uint32_t MaxNode = (1u << NodeBits) - 1;
+
+    /// 2024-01-01T00:00:00Z，41 位时间戳可用约 69 年
+    static constexpr int64_t Epoch = 1704067200000;
+
+    /// format() 输出的长度（Crockford base32，每位 5 bit）
+    static constexpr std::size_t FormattedLength = 13;
+
+    /// nodeId 超过 MaxNode 时抛出 std::invalid_argument
+    explicit IdGenerator(uint32_t nodeId = 0, Clock clock = {});
+
+    IdGenerator(IdGenerator const &) = delete;
+    IdGenerator &operator=(IdGenerator const &) = delete;
+
+    [[nodiscard]] uint64_t next();
+
+    /// 生成并格式化为 prefix + 定长字符串
+    [[nodiscard]] std::string nextString(std::string_view prefix = {});
+
+    [[nodiscard]] uint32_t node() const { return nodeId; }
+
+    // ── 解析 ──
+
+    /// Unix 毫秒
+    static int64_t timestampOf(uint64_t id);
+    static uint32_t nodeOf(uint64_t id);
+    static uint32_t sequenceOf(uint64_t id);
+
+    /// 定长 Crockford base32（字符按 ASCII 升序，字典序 = 数值序）
+    static std::string format(uint64_t id, std::string_view prefix = {});
+    /// format() 的逆操作，text 不含前缀；格式不合法返回 nullopt
+    static std::optional<uint64_t> parse(std::string_view text);
+
+private:
+    uint32_t nodeId;
+    Clock clock;
+    // (相对毫秒 << SequenceBits) | 序列号，即最近一次发出的时间与序列
+    std::atomic<uint64_t> last{0};
+};
+
+} // namespace core
+} // namespace wechat
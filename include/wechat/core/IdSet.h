@@ -0,0 +1,74 @@
+#pragma once
+
+#include <wechat/core/Id.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+/// 有序扁平 ID 集合（按 Id 句柄排序的 std::vector）
+///
+/// - contains 二分查找 O(log n)，数据连续存放，对缓存友好
+/// - 单个 insert / erase 需要移动元素 O(n)；批量增删先排序再一次归并
+/// - 并 / 交 / 差都是线性归并
+///
+/// 迭代顺序是句柄顺序（即 ID 首次驻留的先后），不是字典序，也不保留
+/// 插入顺序。values() 提供只读的 vector 视图给按 vector 使用的调用方。
+class IdSet {
+public:
+    using value_type = Id;
+    using const_iterator = std::vector<Id>::const_iterator;
+    using iterator = const_iterator;
+
+    IdSet() = default;
+    IdSet(std::initializer_list<Id> ids) : IdSet(std::vector<Id>(ids)) {}
+    IdSet(std::vector<Id> ids);
+
+    template <std::input_iterator It>
+    IdSet(It first, It last) : IdSet(std::vector<Id>(first, last)) {}
+
+    [[nodiscard]] bool contains(Id id) const {
+        return std::binary_search(ids.begin(), ids.end(), id);
+    }
+
+    /// 插入单个 ID，返回 false = 已存在
+    bool insert(Id id);
+    /// 移除单个 ID，返回 false = 不存在
+    bool erase(Id id);
+
+    /// 批量插入，返回实际新增的数量
+    std::size_t insert(std::span<Id const> batch);
+    /// 批量移除，返回实际移除的数量
+    std::size_t erase(std::span<Id const> batch);
+
+    [[nodiscard]] IdSet unionWith(IdSet const &other) const;
+    [[nodiscard]] IdSet intersectionWith(IdSet const &other) const;
+    [[nodiscard]] IdSet differenceWith(IdSet const &other) const;
+
+    [[nodiscard]] std::size_t size() const { return ids.size(); }
+    [[nodiscard]] bool empty() const { return ids.empty(); }
+    void reserve(std::size_t n) { ids.reserve(n); }
+
+    const_iterator begin() const { return ids.begin(); }
+    const_iterator end() const { return ids.end(); }
+
+    /// 只读 vector 视图
+    [[nodiscard]] std::vector<Id> const &values() const { return ids; }
+
+    friend bool operator==(IdSet const &, IdSet const &) = default;
+
+private:
+    /// 排序并去重，返回排序后的 batch
+    static std::vector<Id> normalized(std::span<Id const> batch);
+
+    std::vector<Id> ids;
+};
+
+} // namespace core
+} // namespace wechat
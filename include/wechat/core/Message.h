@@ -1,18 +1,39 @@
 #pragma once
 
+#include <wechat/core/Id.h>
+
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 namespace wechat {
 namespace core {
 
+// 消息内容的字符串和容器都使用 std::pmr：默认走全局堆，与 std::string
+// 用法相同；解码一整页消息时可以统一放进一个 monotonic 内存池（见
+// MessagePage），整页一次释放。拷贝出内存池的对象回到默认资源。
+
 // ── 内容块类型 ──
 
 struct TextContent {
-    std::string text;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    std::pmr::string text;
+
+    TextContent() = default;
+    TextContent(std::string_view text, allocator_type alloc = {})
+        : text(text, alloc) {}
+    TextContent(TextContent const &other, allocator_type alloc)
+        : text(other.text, alloc) {}
+    TextContent(TextContent const &) = default;
+    TextContent(TextContent &&) = default;
+    TextContent &operator=(TextContent const &) = default;
+    TextContent &operator=(TextContent &&) = default;
 };
 
 // ── 资源大类 ──
@@ -35,17 +56,38 @@ enum class ResourceSubtype : uint8_t {
     Pdf, Doc, Xls, Zip, Unknown
 };
 
+// ── 按资源大类区分的媒体属性（定长，不分配内存） ──
+
+struct ImageAttributes {
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+struct VideoAttributes {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t duration = 0; // 秒
+};
+
+struct AudioAttributes {
+    uint32_t duration = 0; // 秒
+};
+
+/// File 及未知媒体为 monostate
+using MediaAttributes = std::variant<std::monostate, ImageAttributes,
+                                     VideoAttributes, AudioAttributes>;
+
+using ResourceExtra = std::pmr::map<std::pmr::string, std::pmr::string>;
+
 struct ResourceMeta {
     std::size_t size;                            // 文件大小 (bytes)
-    std::string filename;                        // 原始文件名
-    std::map<std::string, std::string> extra;    // 扩展元信息
-    // Image: {"width": "800", "height": "600"}
-    // Audio: {"duration": "30"}
-    // Video: {"width": "1920", "height": "1080", "duration": "120"}
+    std::pmr::string filename;                   // 原始文件名
+    MediaAttributes media;                       // 宽高 / 时长等已知属性
+    ResourceExtra extra;                         // 未识别的扩展键，通常为空
 };
 
 struct ResourceContent {
-    std::string resourceId;     // 服务器资源 ID，本地通过固定目录映射
+    std::pmr::string resourceId; // 服务器资源 ID，本地通过固定目录映射
     ResourceType type;
     ResourceSubtype subtype;
     ResourceMeta meta;
@@ -54,15 +96,19 @@ struct ResourceContent {
 // ── 消息内容 = 内容块列表 ──
 
 using ContentBlock = std::variant<std::monostate, TextContent, ResourceContent>;
-using MessageContent = std::vector<ContentBlock>;
+using MessageContent = std::pmr::vector<ContentBlock>;
+
+/// 把 content 深拷贝到 alloc 指定的内存资源（variant 不会自动传播分配器）
+MessageContent copyContent(MessageContent const &content,
+                           std::pmr::polymorphic_allocator<> alloc);
 
 // ── 消息 ──
 
 struct Message {
-    std::string id;
-    std::string senderId;
-    std::string chatId;         // 始终是 Group.id
-    std::string replyTo;        // 引用消息 id，空则无引用
+    Id id;
+    Id senderId;
+    Id chatId;                  // 始终是 Group.id
+    Id replyTo;                 // 引用消息 id，空则无引用
     MessageContent content;     // 内容块列表，支持图文混排
     int64_t timestamp;
     int64_t editedAt;           // 最后编辑时间，0 = 未编辑
@@ -71,5 +117,16 @@ struct Message {
     int64_t updatedAt;          // 最后修改时间（编辑/撤回时更新），0 = 未修改
 };
 
+// ── 不可变消息快照 ──
+
+/// 网络层、存储、EventBus 与 UI 之间共享的只读消息，传递时只增减引用计数。
+/// 快照发布后不再修改：编辑 / 撤回 / 已读计数生成新的快照替换旧的，
+/// 仍持有旧快照的一方看到的是修改前的内容。
+using MessagePtr = std::shared_ptr<const Message>;
+
+inline MessagePtr makeSnapshot(Message msg) {
+    return std::make_shared<const Message>(std::move(msg));
+}
+
 } // namespace core
 } // namespace wechat
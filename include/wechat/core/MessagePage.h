@@ -0,0 +1,89 @@
+#pragma once
+
+#include <wechat/core/Message.h>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+/// 一页消息及其独占的 monotonic 内存池
+///
+/// 页内所有消息的内容块、字符串、扩展元信息都分配在同一个内存池里，
+/// 解码时只向系统申请少数几块大内存，析构时整页一次释放。
+///
+/// 只读访问与 std::vector<Message> 相同（size / [] / front / back / 范围 for）。
+/// 页内消息只以 const 引用暴露：移动出的 Message 会带走页的分配器，
+/// 页析构后即悬空，因此不提供可移动的访问路径。从页中拷贝出的 Message
+/// 回到默认堆，可以比页活得更久；需要修改时先拷贝或用 toVector()。
+class MessagePage {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using value_type = Message;
+    using iterator = std::pmr::vector<Message>::const_iterator;
+    using const_iterator = iterator;
+
+    /// 内存池首块大小，约可容纳几十条带图文的消息
+    static constexpr std::size_t DefaultInitialBytes = 16 * 1024;
+
+    explicit MessagePage(std::size_t initialBytes = DefaultInitialBytes);
+
+    /// 深拷贝到新的内存池
+    MessagePage(MessagePage const &other);
+    MessagePage &operator=(MessagePage const &other);
+
+    MessagePage(MessagePage &&) noexcept = default;
+    MessagePage &operator=(MessagePage &&) noexcept = default;
+
+    /// 页内存池的分配器，用于直接在页内构造内容（如 deserializeContent）
+    [[nodiscard]] allocator_type allocator();
+
+    /// 深拷贝一条消息到页内
+    Message const &add(Message const &msg);
+    /// 内容已用 allocator() 分配时直接移入，否则深拷贝
+    Message const &add(Message &&msg);
+
+    void reserve(std::size_t n);
+    void popBack();
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    Message const &operator[](std::size_t i) const {
+        return state->messages[i];
+    }
+    Message const &front() const { return state->messages.front(); }
+    Message const &back() const { return state->messages.back(); }
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /// 拷贝为普通的 std::vector（内容回到默认堆）
+    [[nodiscard]] std::vector<Message> toVector() const;
+
+    /// 把整页转为共享快照，不拷贝消息：每个快照都持有整页的所有权，
+    /// 最后一个快照释放时内存池整体释放
+    [[nodiscard]] static std::vector<MessagePtr> share(MessagePage page);
+
+private:
+    // 内存池和消息放在同一个堆对象里：移动页只移动指针，
+    // 消息中的分配器始终指向有效的内存池
+    struct State {
+        explicit State(std::size_t initialBytes)
+            : arena(initialBytes), messages(&arena) {}
+
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::vector<Message> messages;
+    };
+
+    State &ensureState();
+
+    std::size_t initialBytes;
+    std::unique_ptr<State> state;
+};
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace wechat {
+namespace core {
+
+/// 基于纪元的延迟回收
+///
+/// 读：pin() 在当前纪元登记，持有 Guard 期间已退休的对象不会被释放。
+/// 登记不加锁，但纪元恰好推进时要重试，所以是 lock-free 而非 wait-free。
+/// 读者计数按线程分到多个缓存行对齐的分片上，并发读者不争用同一缓存行。
+/// 写：把摘下来的对象交给 retire，按退休时的纪元挂入待回收列表。
+/// 纪元 E 只有在纪元 E-1 的读者全部离开后才能推进到 E+1，因此退休于 E
+/// 的对象在纪元到达 E+2 时一定没有读者持有，可以释放。retire 从不等待读者。
+class EpochDomain {
+public:
+    EpochDomain() = default;
+    ~EpochDomain() {
+        for (auto &r : retired) r.destroy(r.pointer);
+    }
+
+    EpochDomain(EpochDomain const &) = delete;
+    EpochDomain &operator=(EpochDomain const &) = delete;
+
+    class Guard {
+    public:
+        explicit Guard(EpochDomain const &domain) : counter(&domain.enter()) {}
+        ~Guard() { counter->fetch_sub(1, std::memory_order_release); }
+
+        Guard(Guard const &) = delete;
+        Guard &operator=(Guard const &) = delete;
+
+    private:
+        std::atomic<std::size_t> *counter;
+    };
+
+    [[nodiscard]] Guard pin() const { return Guard(*this); }
+
+    /// 延迟 delete pointer；调用方保证新读者已经无法再拿到它
+    template <typename T> void retire(T const *pointer) {
+        std::lock_guard lock(mutex);
+        retired.push_back({const_cast<T *>(pointer),
+                           [](void *p) { delete static_cast<T *>(p); },
+                           epoch.load()});
+        reclaim();
+    }
+
+    /// 尚未释放的退休对象数
+    [[nodiscard]] std::size_t retiredCount() const {
+        std::lock_guard lock(mutex);
+        return retired.size();
+    }
+
+private:
+    static constexpr std::size_t StripeCount = 16;
+
+    struct alignas(64) Stripe {
+        // 按纪元奇偶分两组计数
+        std::array<std::atomic<std::size_t>, 2> readers{};
+    };
+
+    struct Retired {
+        void *pointer;
+        void (*destroy)(void *);
+        std::uint64_t epoch;
+    };
+
+    static std::size_t stripeIndex() {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local std::size_t index =
+            nextThread.fetch_add(1, std::memory_order_relaxed) % StripeCount;
+        return index;
+    }
+
+    /// 在当前纪元登记一个读者；登记后纪元若已变化则撤销重试，
+    /// 保证读者计入的正是它观察到的纪元
+    std::atomic<std::size_t> &enter() const {
+        auto &stripe = stripes[stripeIndex()];
+        for (;;) {
+            auto e = epoch.load();
+            auto &counter = stripe.readers[e & 1];
+            counter.fetch_add(1);
+            if (epoch.load() == e) return counter;
+            counter.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /// 奇偶为 parity 的纪元上没有读者
+    bool quiescent(std::uint64_t parity) const {
+        for (auto &stripe : stripes)
+            if (stripe.readers[parity].load() != 0) return false;
+        return true;
+    }
+
+    /// 持有 mutex 时调用：最多推进两次纪元，没有读者时刚退休的对象立即释放
+    void reclaim() {
+        auto now = epoch.load();
+        for (int i = 0; i < 2 && quiescent((now + 1) & 1); ++i)
+            epoch.store(++now);
+        // 按退休顺序排列，纪元单调不减：只需从队首释放
+        while (!retired.empty() && retired.front().epoch + 2 <= now) {
+            retired.front().destroy(retired.front().pointer);
+            retired.pop_front();
+        }
+    }
+
+    std::atomic<std::uint64_t> epoch{0};
+    mutable std::array<Stripe, StripeCount> stripes;
+    mutable std::mutex mutex;
+    std::deque<Retired> retired;
+};
+
+/// 读多写少的 RCU 容器
+///
+/// 读：在 EpochDomain 登记后加载快照指针，期间快照不会被释放。
+/// 写：在写锁内复制当前快照、修改、原子替换，旧快照交给 EpochDomain 延迟释放。
+/// 写操作从不等待读者，读回调里修改同一个容器也不会死锁。
+template <typename T>
+class RcuBox {
+public:
+    RcuBox() : current(new T()) {}
+    ~RcuBox() { delete current.load(); }
+
+    RcuBox(RcuBox const &) = delete;
+    RcuBox &operator=(RcuBox const &) = delete;
+
+    class ReadGuard {
+    public:
+        explicit ReadGuard(RcuBox const &box)
+            : guard(box.domain), value(box.current.load()) {}
+
+        T const &operator*() const { return *value; }
+        T const *operator->() const { return value; }
+
+    private:
+        EpochDomain::Guard guard;
+        T const *value;
+    };
+
+    [[nodiscard]] ReadGuard read() const { return ReadGuard(*this); }
+
+    /// 复制当前快照，交给 mutate 修改后发布
+    template <typename F>
+    void update(F &&mutate) {
+        std::lock_guard lock(writeMutex);
+        auto *next = new T(*current.load());
+        mutate(*next);
+        domain.retire(current.exchange(next));
+    }
+
+    /// 尚未释放的旧快照数
+    [[nodiscard]] std::size_t retiredCount() const {
+        return domain.retiredCount();
+    }
+
+private:
+    std::atomic<T const *> current;
+    EpochDomain domain;
+    std::mutex writeMutex;
+};
+
+} // namespace core
+} // namespace wechat
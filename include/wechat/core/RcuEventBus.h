@@ -0,0 +1,76 @@
+#pragma once
+
+#include <wechat/core/Connection.h>
+#include <wechat/core/Event.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace wechat {
+namespace core {
+
+/// 低开销事件总线（EventBus 的替代实现）
+///
+/// 订阅者列表为写时复制（RCU）的不可变数组：
+/// - publish 在纪元上登记读者后加载指针，然后顺序调用，无锁（lock-free）、
+///   无拷贝；登记遇到纪元推进时要重试，因此不是 wait-free
+/// - subscribe / disconnect 是慢路径：复制数组、原子替换，旧数组在
+///   没有读者时回收
+/// - 主题键的订阅者全部断开后，下一次发布到该键时删除；之后再没有事件的
+///   键在新增主题键时摊还清扫
+///
+/// 接口与 EventBus 一致，连接用 core::Connection / core::ScopedConnection。
+/// 分发中断开的订阅者不会再被本次 publish 调用。
+class RcuEventBus {
+public:
+    RcuEventBus();
+    ~RcuEventBus();
+
+    RcuEventBus(RcuEventBus const &) = delete;
+    RcuEventBus &operator=(RcuEventBus const &) = delete;
+
+    /// 订阅所有事件
+    Connection subscribe(std::function<void(Event const &)> handler);
+
+    /// 按类型订阅
+    template <typename T>
+    Connection subscribe(std::function<void(T const &)> handler) {
+        return subscribeType(EventIndex<T>,
+                             [h = std::move(handler)](Event const &e) {
+                                 h(*std::get_if<T>(&e));
+                             });
+    }
+
+    /// 按类型 + 主题键订阅
+    template <typename T>
+    Connection subscribe(std::string key,
+                         std::function<void(T const &)> handler) {
+        return subscribeTopic(EventIndex<T>, std::move(key),
+                              [h = std::move(handler)](Event const &e) {
+                                  h(*std::get_if<T>(&e));
+                              });
+    }
+
+    /// 发布事件
+    void publish(Event const &event);
+
+    /// 获取当前订阅者数量（全量 + 类型 + 主题）
+    [[nodiscard]] std::size_t subscriberCount() const;
+
+    /// 当前登记的主题键数量（诊断用）
+    [[nodiscard]] std::size_t topicCount() const;
+
+private:
+    Connection subscribeType(std::size_t typeIndex,
+                             std::function<void(Event const &)> handler);
+    Connection subscribeTopic(std::size_t typeIndex, std::string key,
+                              std::function<void(Event const &)> handler);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <wechat/core/Executor.h>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <semaphore>
+#include <utility>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+template <typename T = void> class Task;
+
+namespace detail {
+
+/// 协程结束时把控制权直接转交给 co_await 它的协程（对称转移，不增加栈深）
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<P> self) const noexcept {
+        if (auto next = self.promise().continuation) return next;
+        return std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr exception;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+};
+
+template <typename T> struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+    void return_value(T result) { value.emplace(std::move(result)); }
+    T take() {
+        if (exception) std::rethrow_exception(exception);
+        return std::move(*value);
+    }
+};
+
+template <> struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+    void take() const {
+        if (exception) std::rethrow_exception(exception);
+    }
+};
+
+} // namespace detail
+
+/// 惰性协程任务：创建时不执行，被 co_await（或 syncWait / whenAll）时才开始
+///
+/// 任务完成后在完成它的线程上恢复等待方；需要换线程时 co_await resumeOn()。
+/// 异常保存在任务中，由 co_await 处重新抛出。
+///
+/// 用法:
+///   Task<int> load(Executor &pool) {
+///       co_await resumeOn(pool); // 之后的代码在线程池中执行
+///       co_return decode();
+///   }
+///   Task<void> show(Executor &pool) {
+///       int n = co_await load(pool);
+///   }
+template <typename T> class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : handle(handle) {}
+
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, {})) {}
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~Task() { reset(); }
+
+    [[nodiscard]] bool valid() const { return static_cast<bool>(handle); }
+    [[nodiscard]] bool done() const { return handle && handle.done(); }
+
+    /// 启动任务并等待结果，异常在此重新抛出
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Handle task;
+            bool await_ready() const noexcept { return task.done(); }
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> caller) noexcept {
+                task.promise().continuation = caller;
+                return task;
+            }
+            T await_resume() { return task.promise().take(); }
+        };
+        return Awaiter{handle};
+    }
+
+    /// 启动任务并等待完成，但不取结果（供 syncWait / whenAll 使用）
+    auto whenReady() noexcept {
+        struct Awaiter {
+            Handle task;
+            bool await_ready() const noexcept { return task.done(); }
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> caller) noexcept {
+                task.promise().continuation = caller;
+                return task;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{handle};
+    }
+
+    /// 取出结果（任务必须已完成），异常在此重新抛出
+    T result() { return handle.promise().take(); }
+
+private:
+    void reset() {
+        if (handle) handle.destroy();
+        handle = {};
+    }
+
+    Handle handle;
+};
+
+namespace detail {
+
+template <typename T> Task<T> Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/// 立即开始、结束时自行销毁的协程
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+/// syncWait 的驱动协程：结束时释放信号量，帧由等待方销毁
+struct SyncWaiter {
+    struct promise_type {
+        std::binary_semaphore *done = nullptr;
+
+        SyncWaiter get_return_object() noexcept {
+            return SyncWaiter{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        auto final_suspend() const noexcept {
+            struct Release {
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(
+                    std::coroutine_handle<promise_type> self) const noexcept {
+                    self.promise().done->release();
+                }
+                void await_resume() const noexcept {}
+            };
+            return Release{};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    explicit SyncWaiter(std::coroutine_handle<promise_type> handle)
+        : handle(handle) {}
+    SyncWaiter(SyncWaiter const &) = delete;
+    ~SyncWaiter() { handle.destroy(); }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T> SyncWaiter syncWaitFor(Task<T> &task) {
+    co_await task.whenReady();
+}
+
+template <typename T, typename Counter>
+Detached notifyWhenReady(Task<T> &task, Counter &counter) {
+    co_await task.whenReady();
+    counter.arrive();
+}
+
+} // namespace detail
+
+/// 挂起当前协程，在 executor 的工作线程上恢复
+inline auto resumeOn(Executor &executor,
+                     TaskPriority priority = TaskPriority::Normal) {
+    struct Awaiter {
+        Executor &executor;
+        TaskPriority priority;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> self) const {
+            executor.post([self] { self.resume(); }, priority);
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{executor, priority};
+}
+
+/// 阻塞当前线程直到任务完成（用于测试和非 UI 线程），异常重新抛出
+template <typename T> T syncWait(Task<T> task) {
+    std::binary_semaphore done{0};
+    auto waiter = detail::syncWaitFor(task);
+    waiter.handle.promise().done = &done;
+    waiter.handle.resume();
+    done.acquire();
+    return task.result();
+}
+
+/// 同时启动所有任务，全部完成后按原顺序返回结果；
+/// 任一任务抛出异常时在取结果处重新抛出
+template <typename T>
+Task<std::vector<T>> whenAll(std::vector<Task<T>> tasks) {
+    struct Counter {
+        std::atomic<std::size_t> remaining;
+        std::coroutine_handle<> waiter;
+
+        void arrive() {
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                waiter.resume();
+        }
+    };
+    struct StartAll {
+        std::vector<Task<T>> &tasks;
+        Counter &counter;
+        bool await_ready() const noexcept { return tasks.empty(); }
+        bool await_suspend(std::coroutine_handle<> self) {
+            counter.waiter = self;
+            // 多计 1，保证所有任务都启动后才可能恢复等待方
+            counter.remaining.store(tasks.size() + 1,
+                                    std::memory_order_relaxed);
+            for (auto &task : tasks) detail::notifyWhenReady(task, counter);
+            return counter.remaining.fetch_sub(
+                       1, std::memory_order_acq_rel) != 1;
+        }
+        void await_resume() const noexcept {}
+    };
+
+    Counter counter{};
+    co_await StartAll{tasks, counter};
+
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (auto &task : tasks) results.push_back(task.result());
+    co_return results;
+}
+
+} // namespace core
+} // namespace wechat
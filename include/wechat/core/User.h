@@ -1,12 +1,12 @@
 #pragma once
 
-#include <string>
+#include <wechat/core/Id.h>
 
 namespace wechat {
 namespace core {
 
 struct User {
-    std::string id;
+    Id id;
 };
 
 } // namespace core
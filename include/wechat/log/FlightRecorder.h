@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string_view>
+
+namespace wechat::log {
+
+/// 飞行记录器：始终开启的内存环形缓冲，保存最近 FlightRecorderCapacity 条
+/// 日志与 span 记录，崩溃时由信号处理函数原样写到磁盘
+///
+/// - 每条记录定长，写入只有一次原子 fetch_add 加一次 memcpy，不加锁、不分配
+/// - 缓冲区为静态存储，信号处理函数只调用 open / write / close
+/// - 转储是二进制格式，用 decodeFlightDump（或 flight_decode 工具）还原为文本
+inline constexpr std::size_t FlightRecorderCapacity = 8192;
+
+/// 记录一条日志，level 为 spdlog::level::level_enum 的值；过长的文本被截断
+void recordFlightLog(int level, std::string_view text);
+
+/// 记录一个已结束的 span
+void recordFlightSpan(std::string_view category, std::string_view name,
+                      int64_t durationNs);
+
+/// 立即把当前缓冲写到 path；其他线程仍在写入时，逐条校验序号，
+/// 复制期间被覆盖的记录不写入转储
+bool dumpFlightRecorder(const std::filesystem::path& path);
+
+/// 在 SIGSEGV / SIGABRT / SIGBUS / SIGILL / SIGFPE 时写出缓冲到 path，
+/// 然后交还默认处理（生成 core / 退出）
+void installCrashHandler(const std::filesystem::path& path);
+
+/// 把转储解码为按时间排列的文本，每条一行；格式不符、头部容量不是
+/// 合理范围内的 2 的幂、或长度与头部不一致时返回 false（不做分配）
+bool decodeFlightDump(std::istream& in, std::ostream& out);
+
+} // namespace wechat::log
@@ -1,7 +1,69 @@
 #pragma once
 
+#include <spdlog/common.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace spdlog {
+class logger;
+}
+
 namespace wechat::log {
 
-void init();
+/// 日志队列满时的处理方式
+enum class OverflowPolicy {
+    Block,      // 调用方等待队列腾出空间，不丢日志
+    DropOldest, // 丢弃队列中最旧的一条并计数，调用方永不等待
+};
+
+struct LogOptions {
+    std::filesystem::path directory; // 空 = 当前目录下的 logs/
+    std::size_t queueSize = 8192;    // 队列容量（条）
+    OverflowPolicy overflow = OverflowPolicy::DropOldest;
+    std::chrono::seconds flushInterval{3}; // 后台 flush 线程的刷新间隔
+    /// 崩溃时把飞行记录器（最近的日志与 span）写到 <directory>/flight.bin
+    bool crashHandler = true;
+#ifdef NDEBUG
+    bool console = false;
+#else
+    bool console = true; // 同时输出到带颜色的 stdout
+#endif
+};
+
+/// 初始化默认 logger
+///
+/// 日志调用只在调用方线程格式化消息、写入飞行记录器并入队，
+/// 写文件 / 控制台由后台线程完成；error 及以上级别会立即触发 flush。
+void init(LogOptions options = {});
+
+/// 写完队列中剩余的日志并停止后台线程，进程退出前调用
+void shutdown();
+
+/// 模块 logger：消息带 "[module] " 前缀，写入默认 logger 的 sink，
+/// 级别可单独调整。同名返回同一个 logger，引用在进程内始终有效
+///
+/// 用法:
+///   static auto& net = wechat::log::moduleLogger("network");
+///   net.debug("reconnect in {} ms", delay);
+spdlog::logger& moduleLogger(std::string_view module);
+
+/// 运行时调整日志级别，无需重启
+///
+/// module 为 "*" 时调整默认 logger 以及所有未单独设置过级别的模块；
+/// 尚未创建的模块在创建时使用这里设置的级别。
+void setLevel(std::string_view module, spdlog::level::level_enum level);
+
+/// 按 "network=debug,storage=warn,*=info" 批量设置级别
+///
+/// 有无法识别的项时返回 false，其余项仍然生效。
+/// init 时会读取环境变量 WECHAT_LOG_LEVELS 并以同样格式应用。
+bool applyLevels(std::string_view spec);
+
+/// init 以来因队列满（DropOldest）被丢弃的日志条数
+std::uint64_t droppedCount();
 
-} // namespace wechat:: log
+} // namespace wechat::log
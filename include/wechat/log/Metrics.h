@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wechat::log {
+
+/// 单调递增计数
+class Counter {
+public:
+    void add(uint64_t n = 1) { count.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t value() const {
+        return count.load(std::memory_order_relaxed);
+    }
+    void reset() { count.store(0, std::memory_order_relaxed); }
+
+private:
+    alignas(64) std::atomic<uint64_t> count{0};
+};
+
+/// 可增可减的瞬时值，如在途请求数、队列长度
+class Gauge {
+public:
+    void set(int64_t v) { current.store(v, std::memory_order_relaxed); }
+    void add(int64_t delta) {
+        current.fetch_add(delta, std::memory_order_relaxed);
+    }
+    [[nodiscard]] int64_t value() const {
+        return current.load(std::memory_order_relaxed);
+    }
+    void reset() { set(0); }
+
+private:
+    alignas(64) std::atomic<int64_t> current{0};
+};
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets; // 下标见 Histogram::bucketIndex
+
+    /// q ∈ [0, 1]；返回所在桶的上界（不超过 max），无数据时为 0
+    [[nodiscard]] uint64_t percentile(double q) const;
+    [[nodiscard]] double mean() const {
+        return count ? static_cast<double>(sum) / static_cast<double>(count)
+                     : 0.0;
+    }
+};
+
+/// HDR 风格的对数-线性直方图
+///
+/// 小于 32 的值精确记录；更大的值按 2 的幂分段，每段再均分 32 个子桶，
+/// 相对误差不超过 1/32。超过 2^45 的值计入最后一个桶。
+/// record 只做几次 relaxed 原子操作：每个线程首次写入时登记一个独占的
+/// 分片，之后不加锁，也不与其他线程争用同一缓存行；snapshot 合并所有分片。
+/// 线程退出后分片（连同数据）留给之后的新线程复用。
+class Histogram {
+public:
+    static constexpr std::size_t SubBucketBits = 5;
+    static constexpr std::size_t MaxMagnitude = 44; // 最高有效位的上限
+    static constexpr std::size_t BucketCount =
+        (std::size_t{1} << SubBucketBits) * (MaxMagnitude - SubBucketBits + 2);
+
+    Histogram();
+    ~Histogram();
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t value);
+    [[nodiscard]] HistogramSnapshot snapshot() const;
+    void reset();
+
+    static std::size_t bucketIndex(uint64_t value);
+    /// 桶内最大的值
+    static uint64_t bucketUpperBound(std::size_t index);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+/// 计时指标：耗时直方图（纳秒）与失败次数
+struct Timer {
+    Histogram& latency;
+    Counter& errors;
+};
+
+/// 作用域计时：析构时把耗时记入 latency；
+/// 以异常离开作用域或调用过 fail() 时 errors + 1
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const Timer& timer)
+        : timer(timer), exceptions(std::uncaught_exceptions()),
+          start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        timer.latency.record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()));
+        if (failed || std::uncaught_exceptions() > exceptions)
+            timer.errors.add();
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    /// 标记本次调用失败（用于以返回值报告错误的接口）
+    void fail() { failed = true; }
+
+private:
+    const Timer& timer;
+    int exceptions;
+    bool failed = false;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// 某一时刻所有指标的值，各列表按名称排序
+struct MetricsSnapshot {
+    struct CounterValue {
+        std::string name;
+        uint64_t value;
+    };
+    struct GaugeValue {
+        std::string name;
+        int64_t value;
+    };
+    struct HistogramValue {
+        std::string name;
+        HistogramSnapshot data;
+    };
+
+    std::vector<CounterValue> counters;
+    std::vector<GaugeValue> gauges;
+    std::vector<HistogramValue> histograms;
+
+    /// 按名称查找，不存在时返回 nullptr
+    [[nodiscard]] const CounterValue* counter(std::string_view name) const;
+    [[nodiscard]] const GaugeValue* gauge(std::string_view name) const;
+    [[nodiscard]] const HistogramSnapshot*
+    histogram(std::string_view name) const;
+
+    /// 每行一个指标，直方图给出 count / mean / p50 / p99 / p999 / max
+    [[nodiscard]] std::string toText() const;
+    /// {"counters":{...},"gauges":{...},"histograms":{name:{count,...}}}
+    [[nodiscard]] std::string toJson() const;
+};
+
+/// 指标注册表：按名称创建并持有指标，返回的引用在注册表生命周期内有效
+///
+/// 名称查找需要加锁，调用方应在初始化时取得引用后缓存使用。
+///
+/// 用法:
+///   auto& sent = MetricsRegistry::global().counter("chat.sent");
+///   sent.add();
+///   spdlog::info("{}", MetricsRegistry::global().snapshot().toText());
+class MetricsRegistry {
+public:
+    MetricsRegistry();
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /// 进程级默认注册表
+    static MetricsRegistry& global();
+
+    Counter& counter(std::string_view name);
+    Gauge& gauge(std::string_view name);
+    Histogram& histogram(std::string_view name);
+    /// 直方图 name 与计数器 name.errors
+    Timer timer(std::string_view name);
+
+    [[nodiscard]] MetricsSnapshot snapshot() const;
+    /// 所有指标归零（保留已注册的指标和引用）
+    void reset();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace wechat::log
+
+#define WECHAT_METRICS_CONCAT_IMPL(a, b) a##b
+#define WECHAT_METRICS_CONCAT(a, b) WECHAT_METRICS_CONCAT_IMPL(a, b)
+
+/// 对当前作用域计时，记入全局注册表中名为 name 的 Timer
+#define WECHAT_TIMED_SCOPE(name)                                               \
+    static const ::wechat::log::Timer WECHAT_METRICS_CONCAT(wechatTimer,       \
+                                                            __LINE__) =        \
+        ::wechat::log::MetricsRegistry::global().timer(name);                  \
+    ::wechat::log::ScopedTimer WECHAT_METRICS_CONCAT(wechatScopedTimer,        \
+                                                     __LINE__)(                \
+        WECHAT_METRICS_CONCAT(wechatTimer, __LINE__))
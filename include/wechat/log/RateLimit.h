@@ -0,0 +1,117 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace wechat::log {
+
+/// 每秒最多放行 perSecond 次的调用点状态，供 WECHAT_LOG_RATE_LIMITED 使用
+///
+/// 放在调用点的 static 变量中，检查只需两三次 relaxed 原子操作。
+/// 窗口切换时并发调用可能多放行几条，日志限流不需要精确。
+class RateLimiter {
+public:
+    explicit RateLimiter(uint32_t perSecond) : limit(perSecond) {}
+
+    /// 放行时返回自上次放行以来被压制的条数，否则返回 nullopt
+    std::optional<uint64_t> tryAcquire() { return tryAcquireAt(currentSecond()); }
+
+    /// 同 tryAcquire，second 为当前所在的秒（测试用）
+    std::optional<uint64_t> tryAcquireAt(int64_t second) {
+        auto current = window.load(std::memory_order_relaxed);
+        if (current != second &&
+            window.compare_exchange_strong(current, second,
+                                           std::memory_order_relaxed))
+            used.store(0, std::memory_order_relaxed);
+
+        if (used.fetch_add(1, std::memory_order_relaxed) < limit)
+            return suppressed.exchange(0, std::memory_order_relaxed);
+        suppressed.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+private:
+    static int64_t currentSecond() {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    const uint64_t limit;
+    std::atomic<int64_t> window{-1};
+    std::atomic<uint64_t> used{0};
+    std::atomic<uint64_t> suppressed{0};
+};
+
+/// 每 oneIn 次放行一次的调用点状态，供 WECHAT_LOG_SAMPLED 使用（第一次总会放行）
+class LogSampler {
+public:
+    explicit LogSampler(uint32_t oneIn) : period(std::max<uint32_t>(oneIn, 1)) {}
+
+    /// 放行时返回自上次放行以来被跳过的条数，否则返回 nullopt
+    std::optional<uint64_t> tryAcquire() {
+        auto n = seen.fetch_add(1, std::memory_order_relaxed);
+        if (n % period != 0) return std::nullopt;
+        return n == 0 ? 0 : period - 1;
+    }
+
+private:
+    const uint64_t period;
+    std::atomic<uint64_t> seen{0};
+};
+
+namespace detail {
+
+/// 输出一条日志，有被压制的条数时在末尾附上汇总
+template <typename... Args>
+void logWithSummary(spdlog::logger& logger, spdlog::level::level_enum level,
+                    uint64_t suppressed, spdlog::format_string_t<Args...> fmt,
+                    Args&&... args) {
+    if (suppressed == 0) {
+        logger.log(level, fmt, std::forward<Args>(args)...);
+        return;
+    }
+    logger.log(level, "{} ({} similar suppressed)",
+               fmt::format(fmt, std::forward<Args>(args)...), suppressed);
+}
+
+} // namespace detail
+
+} // namespace wechat::log
+
+/// 限流日志：该调用点每秒最多输出 perSecond 条，之后输出的第一条附带被压制的条数
+///
+/// logger 为 spdlog::logger&（如 wechat::log::moduleLogger("network")），
+/// 级别未开启时不触碰调用点状态。
+///
+/// 用法:
+///   WECHAT_LOG_RATE_LIMITED(*spdlog::default_logger_raw(),
+///                           spdlog::level::warn, 5, "decode failed: {}", id);
+#define WECHAT_LOG_RATE_LIMITED(logger, level, perSecond, ...)                 \
+    do {                                                                       \
+        auto& wechatLogger_ = (logger);                                        \
+        if (wechatLogger_.should_log(level)) {                                 \
+            static ::wechat::log::RateLimiter wechatLimiter_(perSecond);       \
+            if (auto wechatPassed_ = wechatLimiter_.tryAcquire())              \
+                ::wechat::log::detail::logWithSummary(                         \
+                    wechatLogger_, level, *wechatPassed_, __VA_ARGS__);        \
+        }                                                                      \
+    } while (false)
+
+/// 采样日志：该调用点每 oneIn 次输出一次，并附带期间跳过的条数
+#define WECHAT_LOG_SAMPLED(logger, level, oneIn, ...)                          \
+    do {                                                                       \
+        auto& wechatLogger_ = (logger);                                        \
+        if (wechatLogger_.should_log(level)) {                                 \
+            static ::wechat::log::LogSampler wechatSampler_(oneIn);            \
+            if (auto wechatPassed_ = wechatSampler_.tryAcquire())              \
+                ::wechat::log::detail::logWithSummary(                         \
+                    wechatLogger_, level, *wechatPassed_, __VA_ARGS__);        \
+        }                                                                      \
+    } while (false)
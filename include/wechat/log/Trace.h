@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace wechat::log {
+
+namespace detail {
+extern std::atomic<bool> tracing;
+} // namespace detail
+
+/// 是否正在记录 span；关闭时 TraceSpan 只做这一次原子读
+inline bool tracingEnabled() {
+    return detail::tracing.load(std::memory_order_relaxed);
+}
+
+/// 开始记录。每个线程有独立的环形缓冲（perThreadCapacity 条），
+/// 写满后覆盖最旧的事件；重新开始会清空之前的记录。
+void startTracing(std::size_t perThreadCapacity = 1 << 16);
+void stopTracing();
+/// 丢弃已记录的事件
+void clearTrace();
+
+/// 为当前线程命名，显示为 trace 中的线程轨道名
+void setTraceThreadName(std::string name);
+
+/// 导出为 Chrome trace event 格式的 JSON，可直接在 Perfetto /
+/// chrome://tracing 中打开
+std::string exportChromeTrace();
+bool writeChromeTrace(const std::filesystem::path& path);
+
+/// 作用域 span：构造时取开始时间，析构时写入当前线程的缓冲
+///
+/// name 和 category 只保存指针，必须是字符串字面量等静态存储。
+/// 一般通过 WECHAT_TRACE_SCOPE 使用:
+///   void MessageDao::insert(const core::Message& msg) {
+///       WECHAT_TRACE_SCOPE("MessageDao::insert", "storage");
+///       ...
+///   }
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, const char* category = "app")
+        : name(name), category(category),
+          start(tracingEnabled() ? now() : -1) {}
+    ~TraceSpan() {
+        if (start >= 0) record(name, category, start, now());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    /// 相对进程启动的纳秒数
+    static int64_t now();
+    static void record(const char* name, const char* category, int64_t start,
+                       int64_t end);
+
+    const char* name;
+    const char* category;
+    int64_t start; // -1 = 开始时未开启追踪
+};
+
+} // namespace wechat::log
+
+#define WECHAT_TRACE_CONCAT_IMPL(a, b) a##b
+#define WECHAT_TRACE_CONCAT(a, b) WECHAT_TRACE_CONCAT_IMPL(a, b)
+
+// 定义 WECHAT_DISABLE_TRACING 时在编译期完全去掉埋点
+#ifdef WECHAT_DISABLE_TRACING
+#define WECHAT_TRACE_SCOPE(...) static_cast<void>(0)
+#else
+#define WECHAT_TRACE_SCOPE(...)                                                \
+    ::wechat::log::TraceSpan WECHAT_TRACE_CONCAT(wechatTraceSpan, __LINE__)(   \
+        __VA_ARGS__)
+#endif
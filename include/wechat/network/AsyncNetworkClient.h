@@ -0,0 +1,158 @@
+#pragma once
+
+#include <wechat/core/Executor.h>
+#include <wechat/core/Task.h>
+#include <wechat/network/NetworkClient.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wechat::network {
+
+/// 以下 Async*Service 与同步接口一一对应，返回 core::Task<Result<T>>。
+/// 请求在 co_await 时提交到线程池，阻塞调用在工作线程上执行，
+/// 完成后等待方在同一工作线程上继续（需要回到其他线程时 co_await
+/// core::resumeOn）。参数按值保存在协程帧中，调用方无需保持其存活。
+
+class AsyncAuthService {
+public:
+    AsyncAuthService(AuthService& service, core::Executor& executor)
+        : service(service), executor(executor) {}
+
+    core::Task<Result<LoginResponse>> registerUser(std::string username,
+                                                   std::string password);
+    core::Task<Result<LoginResponse>> login(std::string username,
+                                            std::string password);
+    core::Task<VoidResult> logout(std::string token);
+    core::Task<Result<core::User>> getCurrentUser(std::string token);
+
+private:
+    AuthService& service;
+    core::Executor& executor;
+};
+
+class AsyncChatService {
+public:
+    AsyncChatService(ChatService& service, core::Executor& executor)
+        : service(service), executor(executor) {}
+
+    core::Task<Result<core::MessagePtr>> sendMessage(
+        std::string token, std::string chatId, std::string replyTo,
+        core::MessageContent content);
+    core::Task<Result<SyncMessagesResponse>> syncMessages(std::string token,
+                                                          std::string chatId,
+                                                          int64_t sinceTs,
+                                                          int limit);
+    core::Task<VoidResult> revokeMessage(std::string token,
+                                         std::string messageId);
+    core::Task<VoidResult> editMessage(std::string token, std::string messageId,
+                                       core::MessageContent newContent);
+    core::Task<VoidResult> markRead(std::string token, std::string chatId,
+                                    std::string lastMessageId);
+
+private:
+    ChatService& service;
+    core::Executor& executor;
+};
+
+class AsyncContactService {
+public:
+    AsyncContactService(ContactService& service, core::Executor& executor)
+        : service(service), executor(executor) {}
+
+    core::Task<VoidResult> addFriend(std::string token,
+                                     std::string targetUserId);
+    core::Task<VoidResult> removeFriend(std::string token,
+                                        std::string targetUserId);
+    core::Task<Result<std::vector<core::User>>> listFriends(std::string token);
+    core::Task<Result<std::vector<core::User>>> searchUser(
+        std::string token, std::string keyword, int offset = 0,
+        int limit = ContactService::DefaultSearchLimit);
+
+private:
+    ContactService& service;
+    core::Executor& executor;
+};
+
+class AsyncGroupService {
+public:
+    AsyncGroupService(GroupService& service, core::Executor& executor)
+        : service(service), executor(executor) {}
+
+    core::Task<Result<core::Group>> createGroup(
+        std::string token, std::vector<std::string> memberIds);
+    core::Task<VoidResult> dissolveGroup(std::string token,
+                                         std::string groupId);
+    core::Task<VoidResult> addMember(std::string token, std::string groupId,
+                                     std::string userId);
+    core::Task<VoidResult> removeMember(std::string token, std::string groupId,
+                                        std::string userId);
+    core::Task<Result<std::vector<std::string>>> listMembers(
+        std::string token, std::string groupId);
+    core::Task<Result<std::vector<core::Group>>> listMyGroups(
+        std::string token);
+
+private:
+    GroupService& service;
+    core::Executor& executor;
+};
+
+class AsyncMomentService {
+public:
+    AsyncMomentService(MomentService& service, core::Executor& executor)
+        : service(service), executor(executor) {}
+
+    core::Task<Result<Moment>> postMoment(std::string token, std::string text,
+                                          std::vector<std::string> imageIds);
+    core::Task<Result<std::vector<Moment>>> listMoments(std::string token,
+                                                        int64_t beforeTs,
+                                                        int limit);
+    core::Task<VoidResult> likeMoment(std::string token, std::string momentId);
+    core::Task<Result<Moment::Comment>> commentMoment(std::string token,
+                                                      std::string momentId,
+                                                      std::string text);
+    core::Task<Result<ListCommentsResponse>> listComments(std::string token,
+                                                          std::string momentId,
+                                                          int64_t afterTs,
+                                                          int limit);
+
+private:
+    MomentService& service;
+    core::Executor& executor;
+};
+
+/// NetworkClient 的协程入口：所有请求在给定线程池上完成，
+/// 大量并发请求只占用池中的线程，不再每个请求一个线程
+///
+/// 用法:
+///   core::Executor pool;
+///   AsyncNetworkClient async(*client, pool);
+///   core::Task<void> send(...) {
+///       auto sent = co_await async.chat().sendMessage(token, chatId, "", content);
+///       if (!sent.ok()) ...
+///   }
+class AsyncNetworkClient {
+public:
+    AsyncNetworkClient(NetworkClient& client, core::Executor& executor)
+        : authService(client.auth(), executor),
+          chatService(client.chat(), executor),
+          contactService(client.contacts(), executor),
+          groupService(client.groups(), executor),
+          momentService(client.moments(), executor) {}
+
+    AsyncAuthService& auth() { return authService; }
+    AsyncChatService& chat() { return chatService; }
+    AsyncContactService& contacts() { return contactService; }
+    AsyncGroupService& groups() { return groupService; }
+    AsyncMomentService& moments() { return momentService; }
+
+private:
+    AsyncAuthService authService;
+    AsyncChatService chatService;
+    AsyncContactService contactService;
+    AsyncGroupService groupService;
+    AsyncMomentService momentService;
+};
+
+} // namespace wechat::network
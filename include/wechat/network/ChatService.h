@@ -9,9 +9,9 @@
 
 namespace wechat::network {
 
-/// 消息同步响应
+/// 消息同步响应，消息以共享快照返回
 struct SyncMessagesResponse {
-    std::vector<core::Message> messages;
+    std::vector<core::MessagePtr> messages;
     bool hasMore;
 };
 
@@ -20,14 +20,15 @@ class ChatService {
 public:
     virtual ~ChatService() = default;
 
-    /// 发送消息，返回服务端分配的完整 Message
-    virtual Result<core::Message> sendMessage(
+    /// 发送消息，返回服务端分配的完整 Message 快照
+    virtual Result<core::MessagePtr> sendMessage(
         const std::string& token,
         const std::string& chatId,
         const std::string& replyTo,
         const core::MessageContent& content) = 0;
 
     /// 增量同步：获取 chatId 中 timestamp > sinceTs 的消息
+    /// limit <= 0 返回 InvalidArgument；超过 MaxSyncPage 时按 MaxSyncPage 返回
     virtual Result<SyncMessagesResponse> syncMessages(
         const std::string& token,
         const std::string& chatId,
@@ -50,6 +51,8 @@ public:
         const std::string& token,
         const std::string& chatId,
         const std::string& lastMessageId) = 0;
+
+    static constexpr int MaxSyncPage = 500;
 };
 
 } // namespace wechat::network
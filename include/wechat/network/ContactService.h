@@ -27,10 +27,21 @@ public:
     virtual Result<std::vector<core::User>> listFriends(
         const std::string& token) = 0;
 
-    /// 按关键字搜索用户
+    /// 按关键字搜索用户，按相关度排序（精确 > 前缀 > 子串）分页返回
     virtual Result<std::vector<core::User>> searchUser(
         const std::string& token,
-        const std::string& keyword) = 0;
+        const std::string& keyword,
+        int offset,
+        int limit) = 0;
+
+    /// 按关键字搜索用户（第一页）
+    Result<std::vector<core::User>> searchUser(
+        const std::string& token,
+        const std::string& keyword) {
+        return searchUser(token, keyword, 0, DefaultSearchLimit);
+    }
+
+    static constexpr int DefaultSearchLimit = 20;
 };
 
 } // namespace wechat::network
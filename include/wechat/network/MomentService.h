@@ -15,7 +15,8 @@ struct Moment {
     std::string text;
     std::vector<std::string> imageIds;
     int64_t timestamp;
-    std::vector<std::string> likedBy;
+    uint32_t likeCount;
+    bool likedByMe;             // 请求者是否已点赞
 
     struct Comment {
         std::string id;
@@ -23,7 +24,16 @@ struct Moment {
         std::string text;
         int64_t timestamp;
     };
-    std::vector<Comment> comments;
+    uint32_t commentCount;
+    std::vector<Comment> comments; // 仅最早的 PreviewComments 条，完整列表用 listComments
+
+    static constexpr int PreviewComments = 3;
+};
+
+/// 评论分页响应
+struct ListCommentsResponse {
+    std::vector<Moment::Comment> comments;
+    bool hasMore;
 };
 
 /// 朋友圈服务接口
@@ -53,6 +63,16 @@ public:
         const std::string& token,
         const std::string& momentId,
         const std::string& text) = 0;
+
+    /// 评论分页：获取 timestamp > afterTs 的评论（按时间升序）
+    /// limit 超过 MaxCommentPage 时按 MaxCommentPage 返回
+    virtual Result<ListCommentsResponse> listComments(
+        const std::string& token,
+        const std::string& momentId,
+        int64_t afterTs,
+        int limit) = 0;
+
+    static constexpr int MaxCommentPage = 200;
 };
 
 } // namespace wechat::network
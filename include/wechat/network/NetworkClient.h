@@ -1,5 +1,6 @@
 #pragma once
 
+#include <wechat/log/Metrics.h>
 #include <wechat/network/AuthService.h>
 #include <wechat/network/ChatService.h>
 #include <wechat/network/ContactService.h>
@@ -26,4 +27,14 @@ public:
 /// 创建 Mock 实现（阶段 1 使用）
 std::unique_ptr<NetworkClient> createMockClient();
 
+/// 包装任意客户端：每个 Service 方法记录耗时直方图 rpc.<service>.<method>
+/// （纳秒）与错误计数 rpc.<service>.<method>.errors
+///
+/// 用法:
+///   auto client = withMetrics(createMockClient());
+///   spdlog::info("{}", log::MetricsRegistry::global().snapshot().toText());
+std::unique_ptr<NetworkClient> withMetrics(
+    std::unique_ptr<NetworkClient> client,
+    log::MetricsRegistry& registry = log::MetricsRegistry::global());
+
 } // namespace wechat::network
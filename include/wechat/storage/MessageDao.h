@@ -1,8 +1,12 @@
 #pragma once
 
+#include "wechat/core/Executor.h"
 #include "wechat/core/Message.h"
+#include "wechat/core/MessagePage.h"
 #include <SQLiteCpp/SQLiteCpp.h>
 #include <cstdint>
+#include <future>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -12,7 +16,14 @@ namespace storage {
 
 /// MessageContent <-> JSON 序列化
 std::string serializeContent(const core::MessageContent& content);
-core::MessageContent deserializeContent(const std::string& json);
+/// alloc 为空时分配在默认堆，传入 MessagePage::allocator() 则分配在页内
+core::MessageContent deserializeContent(
+    const std::string& json, std::pmr::polymorphic_allocator<> alloc = {});
+/// 在线程池中解码（纯计算，不访问数据库），结果分配在默认堆
+std::future<core::MessageContent> deserializeContentAsync(
+    core::Executor& executor, std::string json,
+    core::TaskPriority priority = core::TaskPriority::Normal,
+    core::CancellationToken token = {});
 
 class MessageDao {
 public:
@@ -23,21 +34,23 @@ public:
     void remove(const std::string& id);
     std::optional<core::Message> findById(const std::string& id);
 
+    // 以下分页查询返回 MessagePage：整页消息解码到同一个内存池，一次释放
+
     /// 按 chat_id 分页查询，按 timestamp 降序
-    std::vector<core::Message> findByChat(const std::string& chatId,
-                                          int64_t beforeTimestamp, int limit);
+    core::MessagePage findByChat(const std::string& chatId,
+                                 int64_t beforeTimestamp, int limit);
 
     /// 缓存区间：获取 timestamp > afterTs 的消息（升序），用于向下加载
-    std::vector<core::Message> findAfter(const std::string& chatId,
-                                         int64_t afterTs, int limit);
+    core::MessagePage findAfter(const std::string& chatId,
+                                int64_t afterTs, int limit);
 
     /// 缓存区间：获取 timestamp < beforeTs 的消息（降序），用于向上加载历史
-    std::vector<core::Message> findBefore(const std::string& chatId,
-                                          int64_t beforeTs, int limit);
+    core::MessagePage findBefore(const std::string& chatId,
+                                 int64_t beforeTs, int limit);
 
     /// 增量同步：获取某 chat 中 updated_at > since 的消息
-    std::vector<core::Message> findUpdatedAfter(const std::string& chatId,
-                                                int64_t since);
+    core::MessagePage findUpdatedAfter(const std::string& chatId,
+                                       int64_t since);
 
     /// 撤回消息
     void revoke(const std::string& id, int64_t now);
@@ -50,7 +63,8 @@ public:
     void updateReadCount(const std::string& id, uint32_t readCount, int64_t now);
 
 private:
-    core::Message rowToMessage(SQLite::Statement& stmt);
+    core::Message rowToMessage(SQLite::Statement& stmt,
+                               std::pmr::polymorphic_allocator<> alloc = {});
     SQLite::Database& db_;
 };
 
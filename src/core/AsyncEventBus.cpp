@@ -0,0 +1,392 @@
+#include <boost/signals2/signal.hpp>
+#include <wechat/core/AsyncEventBus.h>
+#include <wechat/core/EventBus.h>
+#include <wechat/log/Log.h>
+#include <wechat/log/RateLimit.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+namespace {
+
+spdlog::logger &eventBusLog() {
+    static auto &logger = wechat::log::moduleLogger("eventbus");
+    return logger;
+}
+
+/// 调用订阅者；异常只记日志，不让它离开分发线程（否则 std::terminate）
+template <typename F> void invokeGuarded(F &&call) {
+    try {
+        call();
+    } catch (std::exception const &e) {
+        WECHAT_LOG_RATE_LIMITED(eventBusLog(), spdlog::level::err, 10,
+                                "event subscriber failed: {}", e.what());
+    } catch (...) {
+        WECHAT_LOG_RATE_LIMITED(
+            eventBusLog(), spdlog::level::err, 10,
+            "event subscriber failed with unknown exception");
+    }
+}
+
+} // namespace
+
+struct AsyncEventBus::Impl {
+    using BatchSignal =
+        boost::signals2::signal<void(std::span<Event const>)>;
+    using BatchTopics =
+        std::map<std::string, std::shared_ptr<BatchSignal>, std::less<>>;
+
+    explicit Impl(AsyncEventBusOptions options) : options(options) {
+        if (this->options.capacity == 0) this->options.capacity = 1;
+        if (this->options.maxBatch == 0) this->options.maxBatch = 1;
+    }
+
+    AsyncEventBusOptions options;
+
+    // 逐条订阅者，在分发线程上复用同步 EventBus
+    EventBus bus;
+
+    // 批量订阅者，布局与 EventBus 一致
+    std::array<BatchSignal, EventTypeCount> batchByType;
+    std::array<BatchTopics, EventTypeCount> batchByTopic;
+    std::array<std::size_t, EventTypeCount> sweptSize{};
+    mutable std::shared_mutex topicMutex;
+
+    /// 同 EventBus：删除已没有订阅者的键；调用方持有 topicMutex 写锁
+    void sweep(std::size_t typeIndex) {
+        auto &topics = batchByTopic[typeIndex];
+        std::erase_if(topics,
+                      [](auto const &entry) { return entry.second->empty(); });
+        sweptSize[typeIndex] = topics.size();
+    }
+
+    void prune(std::size_t typeIndex, std::string_view key,
+               std::shared_ptr<BatchSignal> const &topic) {
+        std::unique_lock lock(topicMutex);
+        auto &topics = batchByTopic[typeIndex];
+        auto it = topics.find(key);
+        if (it != topics.end() && it->second == topic && topic->empty())
+            topics.erase(it);
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        Event event;
+        Clock::time_point enqueued;
+    };
+
+    // 每个优先级一条有界 MPSC 队列：多个发布方，唯一消费方是分发线程
+    struct Lane {
+        std::deque<Pending> queue;
+        std::size_t skipped = 0; // 非空时连续被其他道抢先的批数
+        LaneStats stats;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::condition_variable idle;
+    std::array<Lane, EventPriorityCount> lanes;
+    std::size_t queued = 0; // 所有道排队总数
+    bool dispatching = false;
+    bool stopping = false;
+    std::uint64_t batches = 0;
+
+    std::thread dispatcher;
+
+    bool onDispatcher() const {
+        return std::this_thread::get_id() == dispatcher.get_id();
+    }
+
+    /// 道已满时为新事件腾位置；返回 false 表示新事件已合并进队列
+    bool makeRoom(Lane &lane, Event &event,
+                  std::unique_lock<std::mutex> &lock) {
+        switch (options.overflow) {
+        case OverflowPolicy::Block:
+            notFull.wait(lock, [&] {
+                return lane.queue.size() < options.capacity || stopping;
+            });
+            return true;
+        case OverflowPolicy::Coalesce: {
+            auto key = topicKey(event);
+            auto it = std::find_if(lane.queue.rbegin(), lane.queue.rend(),
+                                   [&](Pending const &queued) {
+                                       return queued.event.index() ==
+                                                  event.index() &&
+                                              topicKey(queued.event) == key;
+                                   });
+            if (it != lane.queue.rend()) {
+                // 保留原入队时间，合并不重置等待时长
+                it->event = std::move(event);
+                ++lane.stats.coalesced;
+                return false;
+            }
+            [[fallthrough]];
+        }
+        case OverflowPolicy::DropOldest:
+            lane.queue.pop_front();
+            --queued;
+            ++lane.stats.dropped;
+            return true;
+        }
+        return true;
+    }
+
+    /// 选出本批要取的道：被跳过太久的道优先，否则取最高优先级的非空道
+    Lane &pickLane() {
+        Lane *picked = nullptr;
+        for (auto &lane : lanes) {
+            if (!lane.queue.empty() &&
+                lane.skipped >= options.starvationLimit) {
+                picked = &lane;
+                break;
+            }
+        }
+        if (!picked) {
+            for (auto &lane : lanes) {
+                if (!lane.queue.empty()) {
+                    picked = &lane;
+                    break;
+                }
+            }
+        }
+        for (auto &lane : lanes) {
+            if (&lane == picked)
+                lane.skipped = 0;
+            else if (!lane.queue.empty())
+                ++lane.skipped;
+        }
+        return *picked;
+    }
+
+    void run() {
+        std::vector<Event> batch;
+        batch.reserve(options.maxBatch);
+
+        std::unique_lock lock(mutex);
+        for (;;) {
+            notEmpty.wait(lock, [&] { return queued > 0 || stopping; });
+            if (queued == 0) break;
+
+            auto &lane = pickLane();
+            auto n = std::min(lane.queue.size(), options.maxBatch);
+            auto now = Clock::now();
+            for (std::size_t i = 0; i < n; ++i) {
+                auto &pending = lane.queue[i];
+                auto latency = std::chrono::duration_cast<
+                    std::chrono::microseconds>(now - pending.enqueued);
+                lane.stats.totalLatency += latency;
+                lane.stats.maxLatency = std::max(lane.stats.maxLatency, latency);
+                batch.push_back(std::move(pending.event));
+            }
+            lane.queue.erase(lane.queue.begin(), lane.queue.begin() + n);
+            queued -= n;
+            dispatching = true;
+            lock.unlock();
+            notFull.notify_all();
+
+            dispatch(batch);
+            batch.clear();
+
+            lock.lock();
+            dispatching = false;
+            lane.stats.dispatched += n;
+            ++batches;
+            if (queued == 0) idle.notify_all();
+        }
+    }
+
+    bool hasBatchSubscribers() const {
+        for (auto &signal : batchByType)
+            if (!signal.empty()) return true;
+        std::shared_lock lock(topicMutex);
+        for (auto &topics : batchByTopic)
+            if (!topics.empty()) return true;
+        return false;
+    }
+
+    /// 订阅者抛出的异常逐个吞掉并记录，一个订阅者失败不影响其余事件和分组
+    void dispatch(std::vector<Event> &batch) {
+        for (auto &event : batch)
+            invokeGuarded([&] { bus.publish(event); });
+        if (!hasBatchSubscribers()) return; // 没有批量订阅者时不必排序分组
+
+        // 按 (类型, 主题键) 稳定排序后，每段连续区间就是一组
+        std::stable_sort(batch.begin(), batch.end(),
+                         [](Event const &a, Event const &b) {
+                             if (a.index() != b.index())
+                                 return a.index() < b.index();
+                             return topicKey(a) < topicKey(b);
+                         });
+
+        auto first = batch.begin();
+        while (first != batch.end()) {
+            auto key = topicKey(*first);
+            auto type = first->index();
+            auto last = std::find_if(first, batch.end(), [&](Event const &e) {
+                return e.index() != type || topicKey(e) != key;
+            });
+            std::span<Event const> group(&*first, last - first);
+
+            invokeGuarded([&] { batchByType[type](group); });
+            if (!key.empty()) {
+                std::shared_ptr<BatchSignal> topic;
+                {
+                    std::shared_lock topicLock(topicMutex);
+                    auto &topics = batchByTopic[type];
+                    if (auto it = topics.find(key); it != topics.end())
+                        topic = it->second;
+                }
+                if (topic) {
+                    invokeGuarded([&] { (*topic)(group); });
+                    if (topic->empty()) prune(type, key, topic);
+                }
+            }
+            first = last;
+        }
+    }
+};
+
+AsyncEventBus::AsyncEventBus(AsyncEventBusOptions options)
+    : impl_(std::make_unique<Impl>(options)) {
+    impl_->dispatcher = std::thread([impl = impl_.get()] { impl->run(); });
+}
+
+AsyncEventBus::~AsyncEventBus() {
+    {
+        std::lock_guard lock(impl_->mutex);
+        impl_->stopping = true;
+    }
+    impl_->notEmpty.notify_all();
+    impl_->notFull.notify_all();
+    impl_->dispatcher.join();
+}
+
+boost::signals2::connection
+AsyncEventBus::subscribe(std::function<void(Event const &)> handler) {
+    return impl_->bus.subscribe(std::move(handler));
+}
+
+boost::signals2::connection
+AsyncEventBus::subscribeType(std::size_t typeIndex,
+                             std::function<void(Event const &)> handler) {
+    return impl_->bus.subscribeType(typeIndex, std::move(handler));
+}
+
+boost::signals2::connection
+AsyncEventBus::subscribeTopic(std::size_t typeIndex, std::string key,
+                              std::function<void(Event const &)> handler) {
+    return impl_->bus.subscribeTopic(typeIndex, std::move(key),
+                                     std::move(handler));
+}
+
+boost::signals2::connection AsyncEventBus::subscribeBatchType(
+    std::size_t typeIndex,
+    std::function<void(std::span<Event const>)> handler) {
+    return impl_->batchByType[typeIndex].connect(std::move(handler));
+}
+
+boost::signals2::connection AsyncEventBus::subscribeBatchTopic(
+    std::size_t typeIndex, std::string key,
+    std::function<void(std::span<Event const>)> handler) {
+    std::unique_lock lock(impl_->topicMutex);
+    auto &topics = impl_->batchByTopic[typeIndex];
+    if (!topics.contains(key) &&
+        topics.size() >= 2 * std::max<std::size_t>(impl_->sweptSize[typeIndex],
+                                                    16))
+        impl_->sweep(typeIndex);
+    auto &slot = topics[std::move(key)];
+    if (!slot) slot = std::make_shared<Impl::BatchSignal>();
+    return slot->connect(std::move(handler));
+}
+
+void AsyncEventBus::publish(Event event) {
+    auto priority = defaultPriority(event);
+    publish(std::move(event), priority);
+}
+
+void AsyncEventBus::publish(Event event, EventPriority priority) {
+    {
+        std::unique_lock lock(impl_->mutex);
+        auto &lane = impl_->lanes[static_cast<std::size_t>(priority)];
+        ++lane.stats.published;
+        // 分发线程自己发布时不能等自己腾位置，直接入队
+        if (lane.queue.size() >= impl_->options.capacity &&
+            !impl_->onDispatcher()) {
+            if (!impl_->makeRoom(lane, event, lock)) return;
+        }
+        lane.queue.push_back({std::move(event), Impl::Clock::now()});
+        ++impl_->queued;
+    }
+    impl_->notEmpty.notify_one();
+}
+
+void AsyncEventBus::flush() {
+    if (impl_->onDispatcher()) return;
+    std::unique_lock lock(impl_->mutex);
+    impl_->idle.wait(
+        lock, [&] { return impl_->queued == 0 && !impl_->dispatching; });
+}
+
+std::size_t AsyncEventBus::pending() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->queued;
+}
+
+std::size_t AsyncEventBus::pending(EventPriority priority) const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->lanes[static_cast<std::size_t>(priority)].queue.size();
+}
+
+AsyncEventBusStats AsyncEventBus::stats() const {
+    std::lock_guard lock(impl_->mutex);
+    AsyncEventBusStats stats;
+    stats.batches = impl_->batches;
+    for (std::size_t i = 0; i < EventPriorityCount; ++i) {
+        auto &lane = impl_->lanes[i];
+        auto &out = stats.lanes[i];
+        out = lane.stats;
+        out.depth = lane.queue.size();
+        stats.published += out.published;
+        stats.dispatched += out.dispatched;
+        stats.dropped += out.dropped;
+        stats.coalesced += out.coalesced;
+    }
+    return stats;
+}
+
+std::size_t AsyncEventBus::subscriberCount() const {
+    auto count = impl_->bus.subscriberCount();
+    for (auto &signal : impl_->batchByType) count += signal.num_slots();
+
+    std::shared_lock lock(impl_->topicMutex);
+    for (auto &topics : impl_->batchByTopic) {
+        for (auto &[_, signal] : topics) count += signal->num_slots();
+    }
+    return count;
+}
+
+std::size_t AsyncEventBus::topicCount() const {
+    auto count = impl_->bus.topicCount();
+    std::shared_lock lock(impl_->topicMutex);
+    for (auto &topics : impl_->batchByTopic) count += topics.size();
+    return count;
+}
+
+} // namespace core
+} // namespace wechat
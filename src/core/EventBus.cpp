@@ -1,11 +1,49 @@
 #include <boost/signals2/signal.hpp>
 #include <wechat/core/EventBus.h>
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
 namespace wechat {
 namespace core {
 
 struct EventBus::Impl {
-    boost::signals2::signal<void(Event const &)> signal;
+    using Signal = boost::signals2::signal<void(Event const &)>;
+    using Topics = std::map<std::string, std::shared_ptr<Signal>, std::less<>>;
+
+    // 全量订阅者
+    Signal signal;
+    // 按事件类型预先分好的订阅者列表，publish 时按 variant 下标直接取
+    std::array<Signal, EventTypeCount> byType;
+
+    // 按类型 + 主题键的订阅者；发布方持有 shared_ptr 在锁外调用，
+    // 键在订阅者全部断开后删除
+    std::array<Topics, EventTypeCount> byTopic;
+    // 上次清扫后各类型剩余的键数，新增键使其翻倍时再清扫一次
+    std::array<std::size_t, EventTypeCount> sweptSize{};
+    mutable std::shared_mutex topicMutex;
+
+    /// 删除已没有订阅者的键；调用方持有 topicMutex 写锁
+    void sweep(std::size_t typeIndex) {
+        auto &topics = byTopic[typeIndex];
+        std::erase_if(topics,
+                      [](auto const &entry) { return entry.second->empty(); });
+        sweptSize[typeIndex] = topics.size();
+    }
+
+    /// 发布时发现 topic 已无订阅者：若它仍是 key 对应的 Signal 则删除
+    void prune(std::size_t typeIndex, std::string_view key,
+               std::shared_ptr<Signal> const &topic) {
+        std::unique_lock lock(topicMutex);
+        auto &topics = byTopic[typeIndex];
+        auto it = topics.find(key);
+        // 重新检查：加锁前可能有新订阅者接入同一个 Signal
+        if (it != topics.end() && it->second == topic && topic->empty())
+            topics.erase(it);
+    }
 };
 
 EventBus::EventBus() : impl_(std::make_unique<Impl>()) {}
@@ -17,12 +55,61 @@ EventBus::subscribe(std::function<void(Event const &)> handler) {
     return impl_->signal.connect(std::move(handler));
 }
 
+boost::signals2::connection
+EventBus::subscribeType(std::size_t typeIndex,
+                        std::function<void(Event const &)> handler) {
+    return impl_->byType[typeIndex].connect(std::move(handler));
+}
+
+boost::signals2::connection
+EventBus::subscribeTopic(std::size_t typeIndex, std::string key,
+                         std::function<void(Event const &)> handler) {
+    std::unique_lock lock(impl_->topicMutex);
+    auto &topics = impl_->byTopic[typeIndex];
+    // 从未再收到事件的键不会在 publish 时删除，靠新增键时的摊还清扫回收
+    if (!topics.contains(key) &&
+        topics.size() >= 2 * std::max<std::size_t>(impl_->sweptSize[typeIndex],
+                                                    16))
+        impl_->sweep(typeIndex);
+    auto &slot = topics[std::move(key)];
+    if (!slot) slot = std::make_shared<Impl::Signal>();
+    return slot->connect(std::move(handler));
+}
+
 void EventBus::publish(Event const &event) {
     impl_->signal(event);
+    impl_->byType[event.index()](event);
+
+    auto key = topicKey(event);
+    if (key.empty()) return;
+
+    std::shared_ptr<Impl::Signal> topic;
+    {
+        std::shared_lock lock(impl_->topicMutex);
+        auto &topics = impl_->byTopic[event.index()];
+        if (auto it = topics.find(key); it != topics.end()) topic = it->second;
+    }
+    if (!topic) return;
+    (*topic)(event);
+    if (topic->empty()) impl_->prune(event.index(), key, topic);
 }
 
 std::size_t EventBus::subscriberCount() const {
-    return impl_->signal.num_slots();
+    auto count = impl_->signal.num_slots();
+    for (auto &signal : impl_->byType) count += signal.num_slots();
+
+    std::shared_lock lock(impl_->topicMutex);
+    for (auto &topics : impl_->byTopic) {
+        for (auto &[_, signal] : topics) count += signal->num_slots();
+    }
+    return count;
+}
+
+std::size_t EventBus::topicCount() const {
+    std::shared_lock lock(impl_->topicMutex);
+    std::size_t count = 0;
+    for (auto &topics : impl_->byTopic) count += topics.size();
+    return count;
 }
 
 } // namespace core
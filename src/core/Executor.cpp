@@ -0,0 +1,261 @@
+#include <wechat/core/Executor.h>
+
+#include <wechat/log/Log.h>
+#include <wechat/log/RateLimit.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+spdlog::logger &executorLog() {
+    static auto &logger = wechat::log::moduleLogger("executor");
+    return logger;
+}
+
+struct Job {
+    Executor::Task run;
+    Executor::Task onCancel; // 可为空（post 提交的任务）
+    CancellationToken token;
+    Clock::time_point enqueued;
+};
+
+/// 单个工作线程的任务队列，按 TaskPriority 分层
+struct WorkerQueue {
+    std::mutex mutex;
+    std::array<std::deque<Job>, TaskPriorityCount> lanes;
+};
+
+} // namespace
+
+struct Executor::Impl {
+    explicit Impl(ExecutorOptions options) : options(options) {}
+
+    /// 先在自己的队列里按优先级取，再依次从其他队列窃取；
+    /// 每个队列只加一次锁，在锁内取它最高优先级的任务
+    bool take(std::size_t self, Job &job) {
+        auto count = queues.size();
+        for (std::size_t k = 0; k < count; ++k) {
+            auto index = (self + k) % count;
+            if (!popFront(*queues[index], job)) continue;
+            // 先计入 active 再减 pending，waitIdle 不会看到两者同时为 0
+            active.fetch_add(1, std::memory_order_acq_rel);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+            if (index != self) steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    static bool popFront(WorkerQueue &queue, Job &job) {
+        std::lock_guard lock(queue.mutex);
+        for (auto &lane : queue.lanes) {
+            if (lane.empty()) continue;
+            job = std::move(lane.front());
+            lane.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    /// 有线程在睡眠时才碰 sleepMutex；与 park 中的检查构成 Dekker 式配对：
+    /// 要么这里看到 sleepers > 0，要么睡眠方看到 pending > 0
+    void wakeOne() {
+        if (sleepers.load() == 0) return;
+        { std::lock_guard lock(sleepMutex); }
+        wake.notify_one();
+    }
+
+    void execute(Job &job) {
+        auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+                          Clock::now() - job.enqueued)
+                          .count();
+        totalLatencyUs.fetch_add(waited, std::memory_order_relaxed);
+        auto max = maxLatencyUs.load(std::memory_order_relaxed);
+        while (waited > max &&
+               !maxLatencyUs.compare_exchange_weak(max, waited,
+                                                   std::memory_order_relaxed)) {
+        }
+
+        if (job.token.cancelled()) {
+            if (job.onCancel) job.onCancel();
+            cancelled.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            job.run();
+            completed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void finished() {
+        if (active.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+            pending.load(std::memory_order_acquire) == 0) {
+            std::lock_guard lock(sleepMutex);
+            idle.notify_all();
+        }
+    }
+
+    void workerLoop(std::size_t self);
+
+    ExecutorOptions options;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake; // 有新任务或停止
+    std::condition_variable idle; // 队列清空且无任务在执行
+    bool stopping = false;        // 由 sleepMutex 保护
+    std::atomic<std::size_t> sleepers{0}; // 在 wake 上等待的线程数
+
+    std::atomic<std::size_t> pending{0}; // 已入队未取出
+    std::atomic<std::size_t> active{0};  // 正在执行
+    std::atomic<std::size_t> nextQueue{0};
+
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> cancelled{0};
+    std::atomic<std::uint64_t> steals{0};
+    std::atomic<std::int64_t> totalLatencyUs{0};
+    std::atomic<std::int64_t> maxLatencyUs{0};
+};
+
+namespace {
+
+/// 当前线程所属的线程池及其队列下标
+struct WorkerContext {
+    void const *owner = nullptr;
+    std::size_t index = 0;
+};
+
+thread_local WorkerContext currentWorker;
+
+} // namespace
+
+void Executor::Impl::workerLoop(std::size_t self) {
+    currentWorker = {this, self};
+    Job job;
+    while (true) {
+        if (take(self, job)) {
+            execute(job);
+            job = {};
+            finished();
+            continue;
+        }
+        std::unique_lock lock(sleepMutex);
+        sleepers.fetch_add(1);
+        wake.wait(lock, [&] { return stopping || pending.load() > 0; });
+        sleepers.fetch_sub(1);
+        if (stopping && pending.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+Executor::Executor(ExecutorOptions options)
+    : impl(std::make_unique<Impl>(options)) {
+    if (options.runInline) return;
+    auto threads = options.threads
+                       ? options.threads
+                       : std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < threads; ++i)
+        impl->queues.push_back(std::make_unique<WorkerQueue>());
+    for (std::size_t i = 0; i < threads; ++i)
+        impl->workers.emplace_back([this, i] { impl->workerLoop(i); });
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard lock(impl->sleepMutex);
+        impl->stopping = true;
+    }
+    impl->wake.notify_all();
+    for (auto &worker : impl->workers) worker.join();
+}
+
+void Executor::enqueue(Task run, Task onCancel, TaskPriority priority,
+                       CancellationToken token) {
+    impl->submitted.fetch_add(1, std::memory_order_relaxed);
+    Job job{std::move(run), std::move(onCancel), std::move(token), Clock::now()};
+
+    if (impl->options.runInline) {
+        impl->active.fetch_add(1, std::memory_order_acq_rel);
+        impl->execute(job);
+        impl->finished();
+        return;
+    }
+
+    // 工作线程提交的子任务留在本线程队列，外部提交轮流分配
+    auto index = currentWorker.owner == impl.get()
+                     ? currentWorker.index
+                     : impl->nextQueue.fetch_add(1, std::memory_order_relaxed) %
+                           impl->queues.size();
+    // 先计数再入队：取出方的递减总在递增之后，pending 不会下溢
+    impl->pending.fetch_add(1);
+    auto &queue = *impl->queues[index];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.lanes[static_cast<std::size_t>(priority)].push_back(
+            std::move(job));
+    }
+    impl->wakeOne();
+}
+
+void Executor::post(Task task, TaskPriority priority, CancellationToken token) {
+    enqueue(
+        [task = std::move(task)]() mutable {
+            try {
+                task();
+            } catch (std::exception const &e) {
+                // 同一个任务反复失败时限流，避免刷屏
+                WECHAT_LOG_RATE_LIMITED(executorLog(), spdlog::level::err, 10,
+                                        "executor task failed: {}", e.what());
+            } catch (...) {
+                WECHAT_LOG_RATE_LIMITED(
+                    executorLog(), spdlog::level::err, 10,
+                    "executor task failed with unknown exception");
+            }
+        },
+        {}, priority, std::move(token));
+}
+
+void Executor::waitIdle() {
+    assert(!inWorkerThread() && "waitIdle from a worker thread deadlocks");
+    std::unique_lock lock(impl->sleepMutex);
+    impl->idle.wait(lock, [&] {
+        return impl->pending.load(std::memory_order_acquire) == 0 &&
+               impl->active.load(std::memory_order_acquire) == 0;
+    });
+}
+
+std::size_t Executor::threadCount() const { return impl->workers.size(); }
+
+bool Executor::inWorkerThread() const {
+    return currentWorker.owner == impl.get();
+}
+
+ExecutorStats Executor::stats() const {
+    ExecutorStats s;
+    s.queueDepth = impl->pending.load(std::memory_order_relaxed);
+    s.submitted = impl->submitted.load(std::memory_order_relaxed);
+    s.completed = impl->completed.load(std::memory_order_relaxed);
+    s.cancelled = impl->cancelled.load(std::memory_order_relaxed);
+    s.steals = impl->steals.load(std::memory_order_relaxed);
+    s.totalLatency = std::chrono::microseconds(
+        impl->totalLatencyUs.load(std::memory_order_relaxed));
+    s.maxLatency = std::chrono::microseconds(
+        impl->maxLatencyUs.load(std::memory_order_relaxed));
+    return s;
+}
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,140 @@
+#include <wechat/core/Id.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace wechat {
+namespace core {
+
+namespace {
+
+/// 进程级驻留表
+///
+/// 字符串 -> 句柄：按哈希分片的 unordered_map，每片一把读写锁
+/// 句柄 -> 字符串：分段数组，第 k 段容量 FirstSegment << k，段一旦分配
+/// 就不再移动，因此 str() 只需一次原子加载，不加锁
+class InternTable {
+public:
+    static InternTable &instance() {
+        // 有意不析构：静态对象析构期间仍可能访问 Id::str()
+        static auto *table = new InternTable;
+        return *table;
+    }
+
+    std::uint32_t intern(std::string_view text) {
+        if (text.empty()) return 0;
+
+        auto hash = std::hash<std::string_view>{}(text);
+        auto &shard = shards[hash % ShardCount];
+        {
+            std::shared_lock lock(shard.mutex);
+            if (auto it = shard.index.find(text); it != shard.index.end())
+                return it->second;
+        }
+
+        std::unique_lock lock(shard.mutex);
+        if (auto it = shard.index.find(text); it != shard.index.end())
+            return it->second;
+
+        // 在分片写锁内取号，各分片取号互不阻塞；先检查后递增，
+        // 耗尽后 next 停在上限，不会回绕到已分配的句柄
+        auto handle = next.load(std::memory_order_relaxed);
+        do {
+            if (handle >= Capacity) {
+                std::fputs("wechat::core::Id: intern table exhausted\n",
+                           stderr);
+                std::abort();
+            }
+        } while (!next.compare_exchange_weak(handle, handle + 1,
+                                             std::memory_order_relaxed));
+        auto &slotText = slot(handle, true);
+        slotText.assign(text);
+        shard.index.emplace(slotText, handle);
+        return handle;
+    }
+
+    /// 只查不驻留，未找到返回 0
+    std::uint32_t find(std::string_view text) {
+        if (text.empty()) return 0;
+        auto &shard = shards[std::hash<std::string_view>{}(text) % ShardCount];
+        std::shared_lock lock(shard.mutex);
+        auto it = shard.index.find(text);
+        return it == shard.index.end() ? 0 : it->second;
+    }
+
+    std::string const &lookup(std::uint32_t handle) {
+        return slot(handle, false);
+    }
+
+    std::size_t size() const { return next.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t ShardCount = 16;
+    static constexpr std::size_t FirstSegment = 1024;
+    // 1024 * (2^22 - 1) 个槽位，覆盖 32 位句柄空间
+    static constexpr std::size_t SegmentCount = 22;
+    static constexpr std::uint64_t Capacity =
+        (static_cast<std::uint64_t>(FirstSegment) << SegmentCount) -
+        FirstSegment;
+
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string_view, std::uint32_t> index;
+    };
+
+    InternTable() { slot(0, true); } // 句柄 0 = 空字符串
+
+    std::string &slot(std::uint32_t handle, bool create) {
+        auto pos = static_cast<std::size_t>(handle) + FirstSegment;
+        auto k = static_cast<std::size_t>(std::bit_width(pos)) -
+                 std::bit_width(FirstSegment);
+        auto offset = pos - (FirstSegment << k);
+        // 句柄只来自 intern（已检查 Capacity）或已有的 Id，越界说明内存损坏
+        if (k >= SegmentCount) {
+            std::fputs("wechat::core::Id: invalid handle\n", stderr);
+            std::abort();
+        }
+
+        auto *segment = segments[k].load(std::memory_order_acquire);
+        if (!segment && create) {
+            std::lock_guard lock(segmentMutex);
+            segment = segments[k].load(std::memory_order_acquire);
+            if (!segment) {
+                segment = new std::string[FirstSegment << k];
+                segments[k].store(segment, std::memory_order_release);
+            }
+        }
+        return segment[offset];
+    }
+
+    std::array<Shard, ShardCount> shards;
+    std::array<std::atomic<std::string *>, SegmentCount> segments{};
+    std::mutex segmentMutex;
+    std::atomic<std::uint32_t> next{1};
+};
+
+} // namespace
+
+Id::Id(std::string_view text) : handle(InternTable::instance().intern(text)) {}
+
+Id Id::find(std::string_view text) {
+    Id id;
+    id.handle = InternTable::instance().find(text);
+    return id;
+}
+
+std::string const &Id::str() const {
+    return InternTable::instance().lookup(handle);
+}
+
+std::size_t Id::internedCount() { return InternTable::instance().size(); }
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,99 @@
+#include <wechat/core/IdGenerator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace wechat {
+namespace core {
+
+namespace {
+
+constexpr char Alphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+constexpr uint64_t SequenceMask = (uint64_t{1} << IdGenerator::SequenceBits) - 1;
+
+int64_t systemNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+int decodeDigit(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    for (int i = 0; i < 32; ++i) {
+        if (Alphabet[i] == c) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+IdGenerator::IdGenerator(uint32_t nodeId, Clock clock)
+    : nodeId(nodeId), clock(clock ? std::move(clock) : systemNowMs) {
+    // 越界的节点号会写进时间戳位，生成的 ID 与其他节点冲突
+    if (nodeId > MaxNode)
+        throw std::invalid_argument("IdGenerator: nodeId " +
+                                    std::to_string(nodeId) + " exceeds " +
+                                    std::to_string(MaxNode));
+}
+
+uint64_t IdGenerator::next() {
+    auto now = static_cast<uint64_t>(std::max<int64_t>(clock() - Epoch, 0));
+    auto prev = last.load(std::memory_order_relaxed);
+    uint64_t state;
+    do {
+        // 时钟前进：序列号归零；否则（同一毫秒或回拨）在上次基础上 +1，
+        // 序列号溢出时自然进位到时间戳，相当于借用下一毫秒
+        state = (now > (prev >> SequenceBits)) ? (now << SequenceBits)
+                                               : prev + 1;
+    } while (!last.compare_exchange_weak(prev, state,
+                                         std::memory_order_relaxed));
+
+    auto ms = state >> SequenceBits;
+    return (ms << (NodeBits + SequenceBits)) |
+           (static_cast<uint64_t>(nodeId) << SequenceBits) |
+           (state & SequenceMask);
+}
+
+std::string IdGenerator::nextString(std::string_view prefix) {
+    return format(next(), prefix);
+}
+
+int64_t IdGenerator::timestampOf(uint64_t id) {
+    return static_cast<int64_t>(id >> (NodeBits + SequenceBits)) + Epoch;
+}
+
+uint32_t IdGenerator::nodeOf(uint64_t id) {
+    return static_cast<uint32_t>((id >> SequenceBits) & MaxNode);
+}
+
+uint32_t IdGenerator::sequenceOf(uint64_t id) {
+    return static_cast<uint32_t>(id & SequenceMask);
+}
+
+std::string IdGenerator::format(uint64_t id, std::string_view prefix) {
+    std::string text(prefix.size() + FormattedLength, '0');
+    prefix.copy(text.data(), prefix.size());
+    // 13 * 5 = 65 位，最高位恒为 0
+    for (auto i = text.size(); i > prefix.size(); --i) {
+        text[i - 1] = Alphabet[id & 31];
+        id >>= 5;
+    }
+    return text;
+}
+
+std::optional<uint64_t> IdGenerator::parse(std::string_view text) {
+    if (text.size() != FormattedLength) return std::nullopt;
+    // 首位只承载高 4 位（第 65 位不存在）
+    if (decodeDigit(text[0]) > 15) return std::nullopt;
+    uint64_t id = 0;
+    for (char c : text) {
+        auto digit = decodeDigit(c);
+        if (digit < 0) return std::nullopt;
+        id = (id << 5) | static_cast<uint64_t>(digit);
+    }
+    return id;
+}
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,86 @@
+#include <wechat/core/IdSet.h>
+
+namespace wechat {
+namespace core {
+
+IdSet::IdSet(std::vector<Id> ids) : ids(std::move(ids)) {
+    std::sort(this->ids.begin(), this->ids.end());
+    this->ids.erase(std::unique(this->ids.begin(), this->ids.end()),
+                    this->ids.end());
+}
+
+std::vector<Id> IdSet::normalized(std::span<Id const> batch) {
+    std::vector<Id> sorted(batch.begin(), batch.end());
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+bool IdSet::insert(Id id) {
+    auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos != ids.end() && *pos == id) return false;
+    ids.insert(pos, id);
+    return true;
+}
+
+bool IdSet::erase(Id id) {
+    auto pos = std::lower_bound(ids.begin(), ids.end(), id);
+    if (pos == ids.end() || *pos != id) return false;
+    ids.erase(pos);
+    return true;
+}
+
+std::size_t IdSet::insert(std::span<Id const> batch) {
+    if (batch.empty()) return 0;
+    auto sorted = normalized(batch);
+    std::vector<Id> merged;
+    merged.reserve(ids.size() + sorted.size());
+    std::set_union(ids.begin(), ids.end(), sorted.begin(), sorted.end(),
+                   std::back_inserter(merged));
+    auto added = merged.size() - ids.size();
+    ids = std::move(merged);
+    return added;
+}
+
+std::size_t IdSet::erase(std::span<Id const> batch) {
+    if (batch.empty() || ids.empty()) return 0;
+    auto sorted = normalized(batch);
+    auto before = ids.size();
+    // 原地差集：写指针永远不超过读指针
+    auto out = ids.begin();
+    auto other = sorted.begin();
+    for (auto in = ids.begin(); in != ids.end(); ++in) {
+        while (other != sorted.end() && *other < *in) ++other;
+        if (other != sorted.end() && *other == *in) continue;
+        *out++ = *in;
+    }
+    ids.erase(out, ids.end());
+    return before - ids.size();
+}
+
+IdSet IdSet::unionWith(IdSet const &other) const {
+    IdSet result;
+    result.ids.reserve(ids.size() + other.ids.size());
+    std::set_union(ids.begin(), ids.end(), other.ids.begin(), other.ids.end(),
+                   std::back_inserter(result.ids));
+    return result;
+}
+
+IdSet IdSet::intersectionWith(IdSet const &other) const {
+    IdSet result;
+    result.ids.reserve(std::min(ids.size(), other.ids.size()));
+    std::set_intersection(ids.begin(), ids.end(), other.ids.begin(),
+                          other.ids.end(), std::back_inserter(result.ids));
+    return result;
+}
+
+IdSet IdSet::differenceWith(IdSet const &other) const {
+    IdSet result;
+    result.ids.reserve(ids.size());
+    std::set_difference(ids.begin(), ids.end(), other.ids.begin(),
+                        other.ids.end(), std::back_inserter(result.ids));
+    return result;
+}
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,105 @@
+#include <wechat/core/MessagePage.h>
+
+namespace wechat {
+namespace core {
+
+MessageContent copyContent(MessageContent const &content,
+                           std::pmr::polymorphic_allocator<> alloc) {
+    MessageContent result(alloc);
+    result.reserve(content.size());
+    for (auto &block : content) {
+        if (auto *text = std::get_if<TextContent>(&block)) {
+            result.emplace_back(std::in_place_type<TextContent>, text->text,
+                                alloc);
+        } else if (auto *res = std::get_if<ResourceContent>(&block)) {
+            result.emplace_back(ResourceContent{
+                std::pmr::string(res->resourceId, alloc), res->type,
+                res->subtype,
+                ResourceMeta{res->meta.size,
+                             std::pmr::string(res->meta.filename, alloc),
+                             res->meta.media,
+                             {res->meta.extra, alloc}}});
+        } else {
+            result.emplace_back(std::monostate{});
+        }
+    }
+    return result;
+}
+
+MessagePage::MessagePage(std::size_t initialBytes)
+    : initialBytes(initialBytes) {}
+
+MessagePage::MessagePage(MessagePage const &other)
+    : initialBytes(other.initialBytes) {
+    if (other.empty()) return;
+    reserve(other.size());
+    for (auto &msg : other) add(msg);
+}
+
+MessagePage &MessagePage::operator=(MessagePage const &other) {
+    if (this != &other) *this = MessagePage(other);
+    return *this;
+}
+
+MessagePage::State &MessagePage::ensureState() {
+    if (!state) state = std::make_unique<State>(initialBytes);
+    return *state;
+}
+
+MessagePage::allocator_type MessagePage::allocator() {
+    return &ensureState().arena;
+}
+
+Message const &MessagePage::add(Message const &msg) {
+    auto &s = ensureState();
+    // 先在页内构造内容，再整体移入：pmr 容器移动构造保留分配器，
+    // 赋值则会按目标容器的分配器逐元素拷贝
+    s.messages.push_back(Message{msg.id, msg.senderId, msg.chatId,
+                                 msg.replyTo,
+                                 copyContent(msg.content, &s.arena),
+                                 msg.timestamp, msg.editedAt, msg.revoked,
+                                 msg.readCount, msg.updatedAt});
+    return s.messages.back();
+}
+
+Message const &MessagePage::add(Message &&msg) {
+    auto &s = ensureState();
+    if (msg.content.get_allocator() != allocator_type(&s.arena))
+        return add(static_cast<Message const &>(msg));
+    s.messages.push_back(std::move(msg));
+    return s.messages.back();
+}
+
+void MessagePage::reserve(std::size_t n) { ensureState().messages.reserve(n); }
+
+void MessagePage::popBack() { state->messages.pop_back(); }
+
+std::size_t MessagePage::size() const {
+    return state ? state->messages.size() : 0;
+}
+
+MessagePage::const_iterator MessagePage::begin() const {
+    return state ? state->messages.cbegin() : const_iterator{};
+}
+
+MessagePage::const_iterator MessagePage::end() const {
+    return state ? state->messages.cend() : const_iterator{};
+}
+
+std::vector<Message> MessagePage::toVector() const {
+    // Message 拷贝时 pmr 容器取默认资源，内容回到全局堆
+    return {begin(), end()};
+}
+
+std::vector<MessagePtr> MessagePage::share(MessagePage page) {
+    std::vector<MessagePtr> result;
+    if (page.empty()) return result;
+    result.reserve(page.size());
+    // aliasing 构造：引用计数记在整页上，指针指向页内的单条消息
+    auto owner = std::make_shared<MessagePage const>(std::move(page));
+    for (auto &msg : *owner) result.emplace_back(owner, &msg);
+    return result;
+}
+
+} // namespace core
+} // namespace wechat
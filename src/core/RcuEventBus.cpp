@@ -0,0 +1,185 @@
+#include <wechat/core/RcuEventBus.h>
+
+#include <wechat/core/Rcu.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace wechat {
+namespace core {
+
+namespace {
+
+class Channel;
+
+/// 一个订阅者：回调 + 连接状态，由订阅者数组以 shared_ptr 持有
+class Slot : public ConnectionBody {
+public:
+    Slot(std::function<void(Event const &)> handler,
+         std::weak_ptr<Channel> owner)
+        : handler(std::move(handler)), owner(std::move(owner)) {}
+
+    void disconnect() override;
+    bool connected() const override {
+        return active.load(std::memory_order_acquire);
+    }
+
+    std::function<void(Event const &)> const handler;
+
+private:
+    std::atomic<bool> active{true};
+    std::weak_ptr<Channel> owner;
+};
+
+using SlotList = std::vector<std::shared_ptr<Slot>>;
+
+/// 一组订阅者（全量 / 某类型 / 某主题）
+class Channel : public std::enable_shared_from_this<Channel> {
+public:
+    Connection connect(std::function<void(Event const &)> handler) {
+        auto slot = std::make_shared<Slot>(std::move(handler),
+                                           weak_from_this());
+        slots.update([&](SlotList &list) { list.push_back(slot); });
+        return Connection(std::weak_ptr<ConnectionBody>(slot));
+    }
+
+    void remove(Slot const *slot) {
+        slots.update([&](SlotList &list) {
+            std::erase_if(list, [&](auto &s) { return s.get() == slot; });
+        });
+    }
+
+    void dispatch(Event const &event) const {
+        auto list = slots.read();
+        for (auto &slot : *list) {
+            // 分发过程中被断开的订阅者跳过
+            if (slot->connected()) slot->handler(event);
+        }
+    }
+
+    std::size_t size() const { return slots.read()->size(); }
+
+private:
+    RcuBox<SlotList> slots;
+};
+
+void Slot::disconnect() {
+    if (!active.exchange(false, std::memory_order_acq_rel)) return;
+    if (auto channel = owner.lock()) channel->remove(this);
+}
+
+using TopicMap = std::map<std::string, std::shared_ptr<Channel>, std::less<>>;
+
+} // namespace
+
+struct RcuEventBus::Impl {
+    std::shared_ptr<Channel> all = std::make_shared<Channel>();
+    std::array<std::shared_ptr<Channel>, EventTypeCount> byType;
+    // 主题表本身也是 RCU：新主题很少出现，publish 查表无锁
+    std::array<RcuBox<TopicMap>, EventTypeCount> byTopic;
+    // 串行化主题订阅与删键：持锁时查到的频道不会在 connect 之前被删掉
+    std::mutex topicMutex;
+    // 上次清扫后各类型剩余的键数，新增键使其翻倍时再清扫一次
+    std::array<std::size_t, EventTypeCount> sweptSize{};
+
+    Impl() {
+        for (auto &channel : byType) channel = std::make_shared<Channel>();
+    }
+
+    /// 发布时发现频道已无订阅者：若它仍是 key 对应的频道则删除
+    void prune(std::size_t typeIndex, std::string_view key,
+               std::shared_ptr<Channel> const &channel) {
+        std::lock_guard lock(topicMutex);
+        auto &topics = byTopic[typeIndex];
+        {
+            auto current = topics.read();
+            auto it = current->find(key);
+            if (it == current->end() || it->second != channel ||
+                channel->size() != 0)
+                return;
+        }
+        topics.update([&](TopicMap &map) { map.erase(map.find(key)); });
+    }
+};
+
+RcuEventBus::RcuEventBus() : impl_(std::make_unique<Impl>()) {}
+
+RcuEventBus::~RcuEventBus() = default;
+
+Connection RcuEventBus::subscribe(std::function<void(Event const &)> handler) {
+    return impl_->all->connect(std::move(handler));
+}
+
+Connection
+RcuEventBus::subscribeType(std::size_t typeIndex,
+                           std::function<void(Event const &)> handler) {
+    return impl_->byType[typeIndex]->connect(std::move(handler));
+}
+
+Connection
+RcuEventBus::subscribeTopic(std::size_t typeIndex, std::string key,
+                            std::function<void(Event const &)> handler) {
+    std::lock_guard lock(impl_->topicMutex);
+    auto &topics = impl_->byTopic[typeIndex];
+    std::shared_ptr<Channel> channel;
+    {
+        auto current = topics.read();
+        if (auto it = current->find(key); it != current->end())
+            channel = it->second;
+    }
+    if (!channel) {
+        auto &swept = impl_->sweptSize[typeIndex];
+        topics.update([&](TopicMap &map) {
+            // 断开后再没有事件的键不会在 publish 时删除，新增键时摊还清扫
+            if (map.size() >= 2 * std::max<std::size_t>(swept, 16)) {
+                std::erase_if(map, [](auto const &entry) {
+                    return entry.second->size() == 0;
+                });
+                swept = map.size();
+            }
+            channel = map[key] = std::make_shared<Channel>();
+        });
+    }
+    return channel->connect(std::move(handler));
+}
+
+void RcuEventBus::publish(Event const &event) {
+    impl_->all->dispatch(event);
+    impl_->byType[event.index()]->dispatch(event);
+
+    auto key = topicKey(event);
+    if (key.empty()) return;
+    std::shared_ptr<Channel> empty;
+    {
+        auto topics = impl_->byTopic[event.index()].read();
+        auto it = topics->find(key);
+        if (it == topics->end()) return;
+        it->second->dispatch(event);
+        if (it->second->size() == 0) empty = it->second;
+    }
+    // 订阅者已全部断开：慢路径删键，之后该键的 publish 又回到纯读
+    if (empty) impl_->prune(event.index(), key, empty);
+}
+
+std::size_t RcuEventBus::subscriberCount() const {
+    auto count = impl_->all->size();
+    for (auto &channel : impl_->byType) count += channel->size();
+    for (auto &topics : impl_->byTopic) {
+        auto map = topics.read();
+        for (auto &[_, channel] : *map) count += channel->size();
+    }
+    return count;
+}
+
+std::size_t RcuEventBus::topicCount() const {
+    std::size_t count = 0;
+    for (auto &topics : impl_->byTopic) count += topics.read()->size();
+    return count;
+}
+
+} // namespace core
+} // namespace wechat
@@ -0,0 +1,67 @@
+// EventBus 发布延迟基准
+//
+// 1000 个订阅者各自关心一个 chat。对比：
+// - broadcast：全量订阅，每个回调自己 visit + 过滤 chatId
+// - topic：按 chatId 订阅，publish 只分发给该 chat 的订阅者
+
+#include <wechat/core/EventBus.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace wechat::core;
+
+namespace {
+
+constexpr int Subscribers = 1000;
+constexpr int Iterations = 20000;
+
+template <typename Setup>
+double measurePublish(Setup setup) {
+    EventBus bus;
+    long delivered = 0;
+    setup(bus, delivered);
+
+    Message msg{};
+    msg.id = Id("m1");
+    msg.chatId = Id("g" + std::to_string(Subscribers / 2));
+    Event event = MessageReceived{makeSnapshot(msg)};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) bus.publish(event);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (delivered != Iterations) std::printf("unexpected delivery count\n");
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           Iterations;
+}
+
+} // namespace
+
+int main() {
+    auto broadcast = measurePublish([](EventBus &bus, long &delivered) {
+        for (int i = 0; i < Subscribers; ++i) {
+            bus.subscribe([&delivered, chat = "g" + std::to_string(i)](
+                              Event const &e) {
+                if (auto *m = std::get_if<MessageReceived>(&e);
+                    m && m->message->chatId == chat)
+                    ++delivered;
+            });
+        }
+    });
+
+    auto topic = measurePublish([](EventBus &bus, long &delivered) {
+        for (int i = 0; i < Subscribers; ++i) {
+            bus.subscribe<MessageReceived>(
+                "g" + std::to_string(i),
+                [&delivered](MessageReceived const &) { ++delivered; });
+        }
+    });
+
+    std::printf("%-12s %16s\n", "path", "publish (us/op)");
+    std::printf("%-12s %16.3f\n", "broadcast", broadcast);
+    std::printf("%-12s %16.3f\n", "topic", topic);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// 每个后台任务单独起线程（std::async）与共用工作窃取线程池的对比
+
+#include <wechat/core/Executor.h>
+
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <vector>
+
+using namespace wechat::core;
+
+namespace {
+
+constexpr int Tasks = 10'000;
+
+/// 模拟一次小块解码
+long work(int seed) {
+    long acc = seed;
+    for (int i = 0; i < 2000; ++i) acc = acc * 31 + i;
+    return acc;
+}
+
+template <typename Fn> double elapsedUs(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+} // namespace
+
+int main() {
+    long sink = 0;
+
+    auto asyncUs = elapsedUs([&] {
+        std::vector<std::future<long>> futures;
+        futures.reserve(Tasks);
+        for (int i = 0; i < Tasks; ++i)
+            futures.push_back(std::async(std::launch::async, work, i));
+        for (auto &f : futures) sink += f.get();
+    });
+
+    Executor pool;
+    auto poolUs = elapsedUs([&] {
+        std::vector<std::future<long>> futures;
+        futures.reserve(Tasks);
+        for (int i = 0; i < Tasks; ++i)
+            futures.push_back(pool.submit([i] { return work(i); }));
+        for (auto &f : futures) sink += f.get();
+    });
+
+    auto stats = pool.stats();
+    std::printf("%d tasks (%zu pool threads)\n", Tasks, pool.threadCount());
+    std::printf("  std::async per task: %10.1f us\n", asyncUs);
+    std::printf("  Executor::submit:    %10.1f us\n", poolUs);
+    std::printf("  steals %llu, avg wait %lld us, max wait %lld us\n",
+                static_cast<unsigned long long>(stats.steals),
+                static_cast<long long>(stats.averageLatency().count()),
+                static_cast<long long>(stats.maxLatency.count()));
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+// std::string ID 与驻留 core::Id 的内存占用和查找开销对比
+
+#include <wechat/core/Id.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using wechat::core::Id;
+
+// ── 统计存活的堆字节数（每块前置 16 字节记录大小） ──
+
+namespace {
+std::size_t liveBytes = 0;
+constexpr std::size_t Header = 16;
+} // namespace
+
+void *operator new(std::size_t size) {
+    auto *p = static_cast<char *>(std::malloc(size + Header));
+    if (!p) throw std::bad_alloc();
+    *reinterpret_cast<std::size_t *>(p) = size;
+    liveBytes += size;
+    return p + Header;
+}
+
+void operator delete(void *p) noexcept {
+    if (!p) return;
+    auto *base = static_cast<char *>(p) - Header;
+    liveBytes -= *reinterpret_cast<std::size_t *>(base);
+    std::free(base);
+}
+
+void operator delete(void *p, std::size_t) noexcept { operator delete(p); }
+
+namespace {
+
+constexpr int MessageCount = 1'000'000;
+constexpr int ChatCount = 1'000;
+constexpr int UserCount = 10'000;
+
+// 超过 SSO 长度，接近真实服务端 ID
+std::string makeId(char const *prefix, int n) {
+    char buf[48];
+    std::snprintf(buf, sizeof buf, "%s_%020d", prefix, n);
+    return buf;
+}
+
+struct StringIds {
+    std::string id, senderId, chatId, replyTo;
+};
+
+struct InternedIds {
+    Id id, senderId, chatId, replyTo;
+};
+
+/// 1M 条消息：消息 ID 各不相同，发送者 / 会话 ID 大量重复
+template <typename T> std::size_t workingSet() {
+    auto before = liveBytes;
+    auto *messages = new std::vector<T>;
+    messages->reserve(MessageCount);
+    for (int i = 0; i < MessageCount; ++i) {
+        using V = decltype(T::id);
+        messages->push_back({V(makeId("msg", i)),
+                             V(makeId("user", i % UserCount)),
+                             V(makeId("chat", i % ChatCount)), {}});
+    }
+    return liveBytes - before; // 有意不释放，计入驻留表增量
+}
+
+template <typename Map, typename Key>
+double lookupNs(Map const &map, std::vector<Key> const &keys) {
+    auto start = std::chrono::steady_clock::now();
+    std::size_t hits = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (auto &key : keys) hits += map.count(key);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (hits != keys.size() * 10) std::printf("unexpected hits\n");
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           static_cast<double>(hits);
+}
+
+} // namespace
+
+int main() {
+    auto stringBytes = workingSet<StringIds>();
+    auto internedBytes = workingSet<InternedIds>();
+    std::printf("%d messages (4 ids each)\n", MessageCount);
+    std::printf("  std::string ids: %8.1f MB\n", stringBytes / 1e6);
+    std::printf("  core::Id:        %8.1f MB (incl. intern table growth)\n",
+                internedBytes / 1e6);
+
+    std::map<std::string, int> byString;
+    std::unordered_map<Id, int> byId;
+    std::vector<std::string> stringKeys;
+    std::vector<Id> idKeys;
+    for (int i = 0; i < 100'000; ++i) {
+        auto key = makeId("chat", i);
+        byString.emplace(key, i);
+        byId.emplace(Id(key), i);
+        stringKeys.push_back(key);
+        idKeys.emplace_back(key);
+    }
+    std::printf("lookup, 100k keys\n");
+    std::printf("  std::map<std::string>:      %6.1f ns\n",
+                lookupNs(byString, stringKeys));
+    std::printf("  std::unordered_map<Id>:     %6.1f ns\n",
+                lookupNs(byId, idKeys));
+    return 0;
+}
@@ -0,0 +1,91 @@
+// 大群成员判定：无序 vector + std::find 与有序扁平 IdSet 对比
+
+#include <wechat/core/IdSet.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using wechat::core::Id;
+using wechat::core::IdSet;
+
+namespace {
+
+constexpr int MemberCount = 5'000;
+constexpr int Lookups = 200'000;
+constexpr int BatchSize = 1'000;
+
+template <typename Fn> double elapsedNs(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count();
+}
+
+} // namespace
+
+int main() {
+    std::vector<Id> members;
+    for (int i = 0; i < MemberCount; ++i)
+        members.emplace_back("member_" + std::to_string(i));
+    // 模拟入群顺序与驻留顺序无关
+    std::mt19937 rng(42);
+    std::shuffle(members.begin(), members.end(), rng);
+    IdSet set(members);
+
+    // 一半命中、一半不命中（发送者被移出群）
+    std::vector<Id> probes;
+    std::uniform_int_distribution<int> pick(0, MemberCount * 2 - 1);
+    for (int i = 0; i < Lookups; ++i)
+        probes.emplace_back("member_" + std::to_string(pick(rng)));
+
+    std::size_t hitsFind = 0, hitsSet = 0;
+    auto findNs = elapsedNs([&] {
+        for (auto &id : probes)
+            hitsFind +=
+                std::find(members.begin(), members.end(), id) != members.end();
+    });
+    auto setNs = elapsedNs([&] {
+        for (auto &id : probes) hitsSet += set.contains(id);
+    });
+    if (hitsFind != hitsSet) std::printf("mismatch\n");
+
+    std::printf("contains, %d-member group, %d probes\n", MemberCount, Lookups);
+    std::printf("  std::find on vector: %8.1f ns/op\n", findNs / Lookups);
+    std::printf("  IdSet::contains:     %8.1f ns/op\n", setNs / Lookups);
+
+    // 批量入群：逐个 find + push_back 与一次归并
+    std::vector<Id> joiners;
+    for (int i = 0; i < BatchSize; ++i)
+        joiners.emplace_back("joiner_" + std::to_string(i));
+
+    auto vectorCopy = members;
+    auto oneByOneNs = elapsedNs([&] {
+        for (auto &id : joiners) {
+            if (std::find(vectorCopy.begin(), vectorCopy.end(), id) ==
+                vectorCopy.end())
+                vectorCopy.push_back(id);
+        }
+    });
+    auto setCopy = set;
+    auto batchNs = elapsedNs([&] { setCopy.insert(joiners); });
+    auto leavers = std::vector<Id>(joiners.begin(), joiners.end());
+    auto batchEraseNs = elapsedNs([&] { setCopy.erase(leavers); });
+
+    std::printf("add %d members to a %d-member group\n", BatchSize,
+                MemberCount);
+    std::printf("  find + push_back:    %8.1f us\n", oneByOneNs / 1e3);
+    std::printf("  IdSet batch insert:  %8.1f us\n", batchNs / 1e3);
+    std::printf("  IdSet batch erase:   %8.1f us\n", batchEraseNs / 1e3);
+
+    IdSet other(members.begin(), members.begin() + MemberCount / 2);
+    std::size_t common = 0;
+    auto intersectNs =
+        elapsedNs([&] { common = set.intersectionWith(other).size(); });
+    std::printf("intersection %d x %d -> %zu: %8.1f us\n", MemberCount,
+                MemberCount / 2, common, intersectNs / 1e3);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// RcuEventBus 与 EventBus (boost::signals2) 发布开销对比
+
+#include <wechat/core/EventBus.h>
+#include <wechat/core/RcuEventBus.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace wechat::core;
+
+namespace {
+
+constexpr int PublishesPerThread = 200'000;
+
+template <typename Bus>
+double measure(int subscribers, int threads) {
+    Bus bus;
+    std::atomic<long> delivered{0};
+    for (int i = 0; i < subscribers; ++i) {
+        bus.subscribe([&delivered](Event const &) {
+            delivered.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    Event event = PlaceholderEvent{};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int i = 0; i < PublishesPerThread; ++i) bus.publish(event);
+        });
+    }
+    for (auto &w : workers) w.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto publishes = static_cast<double>(threads) * PublishesPerThread;
+    if (delivered != static_cast<long>(publishes) * subscribers)
+        std::printf("unexpected delivery count\n");
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           publishes;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-12s %-8s %18s %18s\n", "subscribers", "threads",
+                "signals2 (ns/op)", "rcu (ns/op)");
+    for (int subscribers : {1, 10, 100}) {
+        for (int threads : {1, 4}) {
+            std::printf("%-12d %-8d %18.1f %18.1f\n", subscribers, threads,
+                        measure<EventBus>(subscribers, threads),
+                        measure<RcuEventBus>(subscribers, threads));
+        }
+    }
+    return 0;
+}
@@ -1,13 +1,319 @@
 #include <gtest/gtest.h>
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <wechat/core/AsyncEventBus.h>
 #include <wechat/core/Event.h>
 #include <wechat/core/EventBus.h>
+#include <wechat/core/Executor.h>
 #include <wechat/core/Group.h>
+#include <wechat/core/Id.h>
+#include <wechat/core/IdGenerator.h>
+#include <wechat/core/IdSet.h>
 #include <wechat/core/Message.h>
+#include <wechat/core/MessagePage.h>
+#include <wechat/core/Rcu.h>
+#include <wechat/core/RcuEventBus.h>
+#include <wechat/core/Task.h>
 #include <wechat/core/User.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
 using namespace wechat::core;
 
+// ── Id ──
+
+TEST(IdTest, InternsEqualStringsToSameHandle) {
+    Id a("user_alice");
+    Id b(std::string("user_") + "alice");
+    Id c("user_bob");
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.value(), b.value());
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.str(), "user_alice");
+    EXPECT_EQ(std::hash<Id>{}(a), std::hash<Id>{}(b));
+}
+
+TEST(IdTest, EmptyAndStringConversions) {
+    Id empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty, Id(""));
+    EXPECT_EQ(empty.str(), "");
+
+    Message msg{};
+    msg.chatId = Id("g42");
+    std::string const &chatId = msg.chatId;
+    EXPECT_EQ(chatId, "g42");
+    EXPECT_EQ(msg.chatId, std::string("g42"));
+    EXPECT_FALSE(msg.chatId.empty());
+}
+
+TEST(IdTest, FindDoesNotIntern) {
+    auto before = Id::internedCount();
+    EXPECT_TRUE(Id::find("never_interned_id").empty());
+    EXPECT_TRUE(Id::find("").empty());
+    EXPECT_EQ(Id::internedCount(), before);
+
+    Id known("find_known_id");
+    EXPECT_EQ(Id::find("find_known_id"), known);
+    EXPECT_EQ(Id::internedCount(), before + 1);
+}
+
+TEST(IdTest, ConcurrentInternAgrees) {
+    constexpr int Threads = 4;
+    constexpr int Count = 5000;
+    std::vector<std::vector<Id>> results(Threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < Threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < Count; ++i)
+                results[t].push_back(Id("concurrent_" + std::to_string(i)));
+        });
+    }
+    for (auto &w : workers) w.join();
+
+    std::unordered_set<Id> distinct(results[0].begin(), results[0].end());
+    EXPECT_EQ(distinct.size(), static_cast<std::size_t>(Count));
+    for (int t = 1; t < Threads; ++t) EXPECT_EQ(results[t], results[0]);
+    EXPECT_EQ(results[0][123].str(), "concurrent_123");
+}
+
+// ── IdGenerator ──
+
+TEST(IdGeneratorTest, LayoutAndMonotonicUnderClockSkew) {
+    int64_t now = IdGenerator::Epoch + 5000;
+    IdGenerator gen(7, [&] { return now; });
+
+    auto a = gen.next();
+    EXPECT_EQ(IdGenerator::timestampOf(a), now);
+    EXPECT_EQ(IdGenerator::nodeOf(a), 7u);
+    EXPECT_EQ(IdGenerator::sequenceOf(a), 0u);
+    EXPECT_EQ(IdGenerator::sequenceOf(gen.next()), 1u);
+
+    // 时钟回拨：沿用上次时间戳，仍然递增
+    now -= 1000;
+    auto b = gen.next();
+    EXPECT_GT(b, a);
+    EXPECT_EQ(IdGenerator::timestampOf(b), IdGenerator::Epoch + 5000);
+
+    // 同一毫秒序列号耗尽：借用下一毫秒
+    now += 1000;
+    uint64_t prev = b;
+    for (int i = 0; i < 5000; ++i) {
+        auto id = gen.next();
+        ASSERT_GT(id, prev);
+        prev = id;
+    }
+    EXPECT_EQ(IdGenerator::timestampOf(prev), IdGenerator::Epoch + 5001);
+
+    // 时钟前进：序列号归零
+    now += 10;
+    EXPECT_EQ(IdGenerator::sequenceOf(gen.next()), 0u);
+}
+
+TEST(IdGeneratorTest, RejectsNodeIdOutOfRange) {
+    EXPECT_EQ(IdGenerator(IdGenerator::MaxNode).node(), IdGenerator::MaxNode);
+    EXPECT_THROW(IdGenerator(IdGenerator::MaxNode + 1), std::invalid_argument);
+    EXPECT_THROW(IdGenerator(UINT32_MAX), std::invalid_argument);
+}
+
+TEST(IdGeneratorTest, FormatSortsLikeNumbersAndRoundTrips) {
+    std::vector<uint64_t> values{0, 1, 31, 32, 1u << 20, 0x7fffffffffffffff,
+                                 ~uint64_t{0}};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        auto text = IdGenerator::format(values[i]);
+        EXPECT_EQ(text.size(), IdGenerator::FormattedLength);
+        EXPECT_EQ(IdGenerator::parse(text), values[i]);
+        if (i > 0) EXPECT_LT(IdGenerator::format(values[i - 1]), text);
+    }
+    EXPECT_EQ(IdGenerator::format(42, "m").substr(0, 1), "m");
+    EXPECT_FALSE(IdGenerator::parse("short").has_value());
+    EXPECT_FALSE(IdGenerator::parse("0000000000U00").has_value());
+    EXPECT_FALSE(IdGenerator::parse("G000000000000").has_value());
+}
+
+TEST(IdGeneratorTest, ConcurrentIdsAreUniqueAndPerThreadIncreasing) {
+    constexpr int Threads = 4;
+    constexpr int Count = 20000;
+    IdGenerator gen(1);
+    std::vector<std::vector<uint64_t>> results(Threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < Threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < Count; ++i) results[t].push_back(gen.next());
+        });
+    }
+    for (auto &w : workers) w.join();
+
+    std::unordered_set<uint64_t> all;
+    for (auto &ids : results) {
+        EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+        all.insert(ids.begin(), ids.end());
+    }
+    EXPECT_EQ(all.size(), static_cast<std::size_t>(Threads * Count));
+}
+
+// ── IdSet ──
+
+TEST(IdSetTest, SortedUniqueWithLookup) {
+    IdSet set{Id("set_c"), Id("set_a"), Id("set_b"), Id("set_a")};
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+    EXPECT_TRUE(set.contains(Id("set_b")));
+    EXPECT_FALSE(set.contains(Id("set_missing")));
+
+    EXPECT_FALSE(set.insert(Id("set_a")));
+    EXPECT_TRUE(set.insert(Id("set_d")));
+    EXPECT_TRUE(set.erase(Id("set_c")));
+    EXPECT_FALSE(set.erase(Id("set_c")));
+    EXPECT_EQ(set.size(), 3u);
+    EXPECT_TRUE(std::is_sorted(set.values().begin(), set.values().end()));
+}
+
+TEST(IdSetTest, BatchInsertAndErase) {
+    IdSet set{Id("batch_1"), Id("batch_2")};
+    std::vector<Id> add{Id("batch_3"), Id("batch_1"), Id("batch_4"),
+                        Id("batch_3")};
+    EXPECT_EQ(set.insert(add), 2u);
+    EXPECT_EQ(set, (IdSet{Id("batch_1"), Id("batch_2"), Id("batch_3"),
+                          Id("batch_4")}));
+
+    std::vector<Id> remove{Id("batch_4"), Id("batch_missing"), Id("batch_1"),
+                           Id("batch_4")};
+    EXPECT_EQ(set.erase(remove), 2u);
+    EXPECT_EQ(set, (IdSet{Id("batch_2"), Id("batch_3")}));
+    EXPECT_EQ(set.erase(std::vector<Id>{}), 0u);
+}
+
+TEST(IdSetTest, SetOperations) {
+    IdSet a{Id("op_1"), Id("op_2"), Id("op_3")};
+    IdSet b{Id("op_2"), Id("op_3"), Id("op_4")};
+    EXPECT_EQ(a.unionWith(b),
+              (IdSet{Id("op_1"), Id("op_2"), Id("op_3"), Id("op_4")}));
+    EXPECT_EQ(a.intersectionWith(b), (IdSet{Id("op_2"), Id("op_3")}));
+    EXPECT_EQ(a.differenceWith(b), IdSet{Id("op_1")});
+    EXPECT_TRUE(a.intersectionWith(IdSet{}).empty());
+}
+
+// ── MessagePage ──
+
+namespace {
+
+Message richMessage(std::string id) {
+    Message msg{};
+    msg.id = Id(id);
+    msg.chatId = Id("g1");
+    msg.content = {
+        TextContent{"text long enough to need a heap buffer " + id},
+        ResourceContent{std::pmr::string("res-" + id), ResourceType::File,
+                        ResourceSubtype::Pdf,
+                        ResourceMeta{1, "doc.pdf", {}, {{"k", "v"}}}}};
+    return msg;
+}
+
+} // namespace
+
+TEST(MessagePageTest, AddCopiesIntoArena) {
+    MessagePage page;
+    EXPECT_TRUE(page.empty());
+
+    auto source = richMessage("m1");
+    auto &msg = page.add(source);
+    auto arena = page.allocator();
+
+    EXPECT_EQ(page.size(), 1u);
+    EXPECT_EQ(msg.id, "m1");
+    EXPECT_EQ(msg.content.get_allocator(), arena);
+    auto *text = std::get_if<TextContent>(&msg.content[0]);
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(text->text.get_allocator(), arena);
+    EXPECT_EQ(text->text, std::get<TextContent>(source.content[0]).text);
+    auto *res = std::get_if<ResourceContent>(&msg.content[1]);
+    ASSERT_NE(res, nullptr);
+    EXPECT_EQ(res->meta.extra.at("k"), "v");
+    EXPECT_EQ(res->meta.extra.begin()->first.get_allocator(), arena);
+}
+
+TEST(MessagePageTest, MoveKeepsArenaAndCopyIsIndependent) {
+    MessagePage page;
+    for (int i = 0; i < 50; ++i) page.add(richMessage("m" + std::to_string(i)));
+    auto arena = page.allocator();
+
+    MessagePage moved = std::move(page);
+    EXPECT_EQ(moved.size(), 50u);
+    EXPECT_EQ(moved.allocator(), arena);
+    EXPECT_EQ(moved.back().content.get_allocator(), arena);
+
+    MessagePage copy = moved;
+    moved = MessagePage();
+    ASSERT_EQ(copy.size(), 50u);
+    EXPECT_NE(copy.allocator(), arena);
+    EXPECT_EQ(std::get<TextContent>(copy[49].content[0]).text,
+              "text long enough to need a heap buffer m49");
+
+    copy.popBack();
+    EXPECT_EQ(copy.size(), 49u);
+}
+
+TEST(MessagePageTest, AddRvalueFromPageAllocatorMoves) {
+    MessagePage page;
+    // content 要在构造时带上分配器；对 pmr 容器赋值不会替换分配器
+    Message msg{.id = Id("m1"), .content = MessageContent(page.allocator())};
+    msg.content.emplace_back(std::in_place_type<TextContent>,
+                             "built directly in the page arena, no copy",
+                             page.allocator());
+    auto *data = std::get<TextContent>(msg.content[0]).text.data();
+
+    auto &added = page.add(std::move(msg));
+    EXPECT_EQ(std::get<TextContent>(added.content[0]).text.data(), data);
+}
+
+TEST(MessagePageTest, MovingOutCopiesToDefaultHeap) {
+    // 页只暴露 const 引用，std::move 落到拷贝构造，不会带走页的分配器
+    using Mutable = MessagePage &;
+    static_assert(std::is_same_v<decltype(std::declval<Mutable>()[0]),
+                                 Message const &>);
+    static_assert(std::is_same_v<decltype(*std::declval<Mutable>().begin()),
+                                 Message const &>);
+
+    std::optional<MessagePage> page(std::in_place);
+    page->add(richMessage("m1"));
+    Message taken = std::move((*page)[0]);
+    page.reset();
+
+    EXPECT_EQ(taken.content.get_allocator(),
+              std::pmr::polymorphic_allocator<>());
+    EXPECT_EQ(std::get<TextContent>(taken.content[0]).text,
+              "text long enough to need a heap buffer m1");
+}
+
+TEST(MessagePageTest, ShareKeepsPageAliveUntilLastSnapshot) {
+    MessagePage page;
+    for (int i = 0; i < 3; ++i) page.add(richMessage("m" + std::to_string(i)));
+    auto *first = &page[0];
+
+    auto snapshots = MessagePage::share(std::move(page));
+    ASSERT_EQ(snapshots.size(), 3u);
+    EXPECT_EQ(snapshots[0].get(), first); // 不拷贝，直接指向页内消息
+    EXPECT_EQ(snapshots[0].use_count(), 3);
+
+    MessagePtr last = snapshots[2];
+    snapshots.clear();
+    EXPECT_EQ(last->id, "m2");
+    EXPECT_EQ(std::get<TextContent>(last->content[0]).text,
+              "text long enough to need a heap buffer m2");
+    EXPECT_TRUE(MessagePage::share(MessagePage()).empty());
+}
+
 TEST(EventBusTest, SubscribeAndPublish) {
     EventBus bus;
     bool called = false;
@@ -78,6 +384,726 @@ TEST(EventBusTest, NoSubscribersPublishDoesNotCrash) {
     EXPECT_EQ(bus.subscriberCount(), 0);
 }
 
+TEST(EventBusTest, TypedSubscriptionReceivesOnlyItsType) {
+    EventBus bus;
+    int placeholders = 0;
+    int messages = 0;
+
+    bus.subscribe<PlaceholderEvent>([&](PlaceholderEvent const &) {
+        ++placeholders;
+    });
+    bus.subscribe<MessageReceived>([&](MessageReceived const &e) {
+        EXPECT_EQ(e.message->id, "m1");
+        ++messages;
+    });
+
+    bus.publish(PlaceholderEvent{});
+    Message msg{};
+    msg.id = Id("m1");
+    msg.chatId = Id("g1");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+
+    EXPECT_EQ(placeholders, 1);
+    EXPECT_EQ(messages, 1);
+    EXPECT_EQ(bus.subscriberCount(), 2);
+}
+
+TEST(EventBusTest, TopicSubscriptionFiltersByChat) {
+    EventBus bus;
+    int g1 = 0;
+    int g2 = 0;
+    int all = 0;
+
+    auto c1 = bus.subscribe<MessageReceived>(
+        "g1", [&](MessageReceived const &) { ++g1; });
+    bus.subscribe<MessageReceived>("g2",
+                                   [&](MessageReceived const &) { ++g2; });
+    bus.subscribe([&](Event const &) { ++all; });
+
+    Message msg{};
+    msg.chatId = Id("g1");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    msg.chatId = Id("g3");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+
+    EXPECT_EQ(g1, 2);
+    EXPECT_EQ(g2, 0);
+    EXPECT_EQ(all, 3);
+
+    c1.disconnect();
+    msg.chatId = Id("g1");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    EXPECT_EQ(g1, 2);
+    EXPECT_EQ(bus.subscriberCount(), 2);
+}
+
+TEST(EventBusTest, TopicKeysAreDroppedAfterLastSubscriber) {
+    EventBus bus;
+    Message msg{};
+    msg.chatId = Id("g1");
+    {
+        boost::signals2::scoped_connection c = bus.subscribe<MessageReceived>(
+            "g1", [](MessageReceived const &) {});
+        EXPECT_EQ(bus.topicCount(), 1u);
+    }
+    // 断开后下一次发布到该键时删除
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    EXPECT_EQ(bus.topicCount(), 0u);
+
+    // 断开后再没有事件的键，在新增键时摊还清扫
+    for (int round = 0; round < 100; ++round) {
+        auto c = bus.subscribe<MessageReceived>(
+            "chat" + std::to_string(round), [](MessageReceived const &) {});
+        c.disconnect();
+    }
+    EXPECT_LE(bus.topicCount(), 32u);
+    EXPECT_EQ(bus.subscriberCount(), 0u);
+}
+
+// ── RcuEventBus ──
+
+TEST(RcuEventBusTest, SubscribePublishAndDisconnect) {
+    RcuEventBus bus;
+    int count = 0;
+
+    auto conn = bus.subscribe([&](Event const &) { ++count; });
+    EXPECT_TRUE(conn.connected());
+    EXPECT_EQ(bus.subscriberCount(), 1);
+
+    bus.publish(PlaceholderEvent{});
+    EXPECT_EQ(count, 1);
+
+    conn.disconnect();
+    EXPECT_FALSE(conn.connected());
+    EXPECT_EQ(bus.subscriberCount(), 0);
+    bus.publish(PlaceholderEvent{});
+    EXPECT_EQ(count, 1);
+}
+
+TEST(RcuEventBusTest, ScopedConnection) {
+    RcuEventBus bus;
+    int count = 0;
+    {
+        ScopedConnection sc = bus.subscribe([&](Event const &) { ++count; });
+        bus.publish(PlaceholderEvent{});
+    }
+    bus.publish(PlaceholderEvent{});
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(bus.subscriberCount(), 0);
+}
+
+TEST(RcuEventBusTest, TypedAndTopicSubscriptions) {
+    RcuEventBus bus;
+    int typed = 0;
+    int topic = 0;
+    bus.subscribe<MessageReceived>([&](MessageReceived const &) { ++typed; });
+    bus.subscribe<MessageReceived>("g1",
+                                   [&](MessageReceived const &) { ++topic; });
+
+    Message msg{};
+    msg.chatId = Id("g1");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    msg.chatId = Id("g2");
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    bus.publish(PlaceholderEvent{});
+
+    EXPECT_EQ(typed, 2);
+    EXPECT_EQ(topic, 1);
+}
+
+TEST(RcuEventBusTest, DisconnectOtherDuringDispatch) {
+    RcuEventBus bus;
+    int second = 0;
+    Connection secondConn;
+
+    bus.subscribe([&](Event const &) { secondConn.disconnect(); });
+    secondConn = bus.subscribe([&](Event const &) { ++second; });
+
+    bus.publish(PlaceholderEvent{});
+    EXPECT_EQ(second, 0);
+    EXPECT_EQ(bus.subscriberCount(), 1);
+}
+
+TEST(RcuEventBusTest, DisconnectSelfAndSubscribeDuringDispatch) {
+    RcuEventBus bus;
+    int self = 0;
+    int late = 0;
+    Connection selfConn;
+
+    selfConn = bus.subscribe([&](Event const &) {
+        ++self;
+        selfConn.disconnect();
+        bus.subscribe([&](Event const &) { ++late; });
+    });
+
+    bus.publish(PlaceholderEvent{});
+    bus.publish(PlaceholderEvent{});
+    EXPECT_EQ(self, 1);
+    EXPECT_EQ(late, 1); // 分发中新增的订阅者从下一次 publish 开始生效
+}
+
+TEST(RcuEventBusTest, ConnectionOutlivesBus) {
+    Connection conn;
+    {
+        RcuEventBus bus;
+        conn = bus.subscribe([](Event const &) {});
+        EXPECT_TRUE(conn.connected());
+    }
+    EXPECT_FALSE(conn.connected());
+    EXPECT_NO_THROW(conn.disconnect());
+}
+
+TEST(RcuEventBusTest, ConcurrentPublishWithSubscriberChurn) {
+    RcuEventBus bus;
+    std::atomic<long> stable{0};
+    bus.subscribe([&](Event const &) { ++stable; });
+
+    std::atomic<bool> stop{false};
+    std::thread churn([&] {
+        while (!stop) {
+            ScopedConnection sc = bus.subscribe([](Event const &) {});
+        }
+    });
+
+    constexpr int Publishers = 4;
+    constexpr int PerThread = 20000;
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < Publishers; ++t) {
+        publishers.emplace_back([&] {
+            for (int i = 0; i < PerThread; ++i)
+                bus.publish(PlaceholderEvent{});
+        });
+    }
+    for (auto &p : publishers) p.join();
+    stop = true;
+    churn.join();
+
+    EXPECT_EQ(stable.load(), Publishers * PerThread);
+    EXPECT_EQ(bus.subscriberCount(), 1);
+}
+
+TEST(RcuEventBusTest, TopicKeysAreDroppedAfterLastSubscriber) {
+    RcuEventBus bus;
+    Message msg{};
+    msg.chatId = Id("g1");
+    {
+        ScopedConnection sc = bus.subscribe<MessageReceived>(
+            "g1", [](MessageReceived const &) {});
+        EXPECT_EQ(bus.topicCount(), 1u);
+    }
+    bus.publish(MessageReceived{makeSnapshot(msg)});
+    EXPECT_EQ(bus.topicCount(), 0u);
+
+    for (int round = 0; round < 100; ++round) {
+        bus.subscribe<MessageReceived>("chat" + std::to_string(round),
+                                       [](MessageReceived const &) {})
+            .disconnect();
+    }
+    EXPECT_LE(bus.topicCount(), 32u);
+    EXPECT_EQ(bus.subscriberCount(), 0);
+}
+
+TEST(RcuEventBusTest, SubscribeRacingTopicPruneNeverLosesSubscriber) {
+    // 另一个线程不断发布到同一个键，订阅者全部断开时触发删键；
+    // 新订阅者接入后自己发布的事件必须收到，不能挂在已删除的频道上
+    RcuEventBus bus;
+    Message msg{};
+    msg.chatId = Id("hot");
+    auto event = MessageReceived{makeSnapshot(msg)};
+
+    std::atomic<bool> stop{false};
+    std::thread publisher([&] {
+        while (!stop) bus.publish(event);
+    });
+    int missed = 0;
+    for (int i = 0; i < 5000; ++i) {
+        std::atomic<int> received{0};
+        ScopedConnection sc = bus.subscribe<MessageReceived>(
+            "hot", [&](MessageReceived const &) { ++received; });
+        auto before = received.load();
+        bus.publish(event);
+        if (received.load() == before) ++missed;
+    }
+    stop = true;
+    publisher.join();
+    EXPECT_EQ(missed, 0);
+}
+
+TEST(RcuBoxTest, ReclaimsWhileReadersOverlap) {
+    RcuBox<std::vector<int>> box;
+    // 每次更新时都至少有一个读者在场，但没有读者跨越两个纪元
+    std::array<std::optional<RcuBox<std::vector<int>>::ReadGuard>, 2> guards;
+    for (int i = 0; i < 1000; ++i) {
+        guards[i % 2].emplace(box);
+        guards[(i + 1) % 2].reset();
+        box.update([&](std::vector<int> &v) { v.push_back(i); });
+        EXPECT_LE(box.retiredCount(), 4u);
+    }
+    EXPECT_EQ((*guards[1])->size(), 999u); // 读者看到的是它进入时的快照
+
+    for (auto &guard : guards) guard.reset();
+    box.update([](std::vector<int> &) {});
+    EXPECT_EQ(box.retiredCount(), 0u);
+    EXPECT_EQ(box.read()->size(), 1000u);
+}
+
+TEST(RcuBoxTest, LongReaderPinsOnlyItsEpoch) {
+    RcuBox<int> box;
+    std::optional<RcuBox<int>::ReadGuard> reader(std::in_place, box);
+    for (int i = 1; i <= 100; ++i) box.update([&](int &v) { v = i; });
+    EXPECT_EQ(**reader, 0);
+    EXPECT_GT(box.retiredCount(), 0u);
+
+    reader.reset();
+    box.update([](int &v) { ++v; });
+    EXPECT_EQ(box.retiredCount(), 0u);
+    EXPECT_EQ(*box.read(), 101);
+}
+
+// ── AsyncEventBus ──
+
+namespace {
+
+MessageReceived messageIn(std::string chatId, std::string id) {
+    Message msg{};
+    msg.chatId = Id(chatId);
+    msg.id = Id(id);
+    return MessageReceived{makeSnapshot(msg)};
+}
+
+/// 用一个 PlaceholderEvent 把分发线程卡在回调里，便于确定性地填满队列
+class DispatcherGate {
+public:
+    explicit DispatcherGate(AsyncEventBus &bus) {
+        bus.subscribe<PlaceholderEvent>([this](PlaceholderEvent const &) {
+            entered.set_value();
+            released.wait();
+        });
+        bus.publish(PlaceholderEvent{});
+        entered.get_future().wait();
+    }
+
+    void release() { releaser.set_value(); }
+
+private:
+    std::promise<void> entered;
+    std::promise<void> releaser;
+    std::shared_future<void> released = releaser.get_future().share();
+};
+
+} // namespace
+
+TEST(AsyncEventBusTest, DispatchesInOrderOnDispatcherThread) {
+    AsyncEventBus bus;
+    std::vector<std::string> ids;
+    std::thread::id handlerThread;
+    bus.subscribe<MessageReceived>([&](MessageReceived const &ev) {
+        handlerThread = std::this_thread::get_id();
+        ids.push_back(ev.message->id);
+    });
+
+    for (int i = 0; i < 100; ++i)
+        bus.publish(messageIn("g1", std::to_string(i)));
+    bus.flush();
+
+    ASSERT_EQ(ids.size(), 100u);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(ids[i], std::to_string(i));
+    EXPECT_NE(handlerThread, std::this_thread::get_id());
+    EXPECT_EQ(bus.pending(), 0u);
+    EXPECT_EQ(bus.stats().dispatched, 100u);
+}
+
+TEST(AsyncEventBusTest, DropOldestWhenFull) {
+    AsyncEventBus bus({.capacity = 2, .overflow = OverflowPolicy::DropOldest});
+    std::vector<std::string> ids;
+    bus.subscribe<MessageReceived>(
+        [&](MessageReceived const &ev) { ids.push_back(ev.message->id); });
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("g1", "1"));
+    bus.publish(messageIn("g1", "2"));
+    bus.publish(messageIn("g1", "3"));
+    EXPECT_EQ(bus.pending(), 2u);
+    gate.release();
+    bus.flush();
+
+    EXPECT_EQ(ids, (std::vector<std::string>{"2", "3"}));
+    EXPECT_EQ(bus.stats().dropped, 1u);
+}
+
+TEST(AsyncEventBusTest, CoalesceReplacesSameTopic) {
+    AsyncEventBus bus({.capacity = 2, .overflow = OverflowPolicy::Coalesce});
+    std::vector<std::string> ids;
+    bus.subscribe<MessageReceived>(
+        [&](MessageReceived const &ev) { ids.push_back(ev.message->id); });
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("x", "x1"));
+    bus.publish(messageIn("y", "y1"));
+    bus.publish(messageIn("x", "x2")); // 替换 x1
+    bus.publish(messageIn("z", "z1")); // 无可合并事件，丢弃最旧的 x2
+    gate.release();
+    bus.flush();
+
+    EXPECT_EQ(ids, (std::vector<std::string>{"y1", "z1"}));
+    auto stats = bus.stats();
+    EXPECT_EQ(stats.coalesced, 1u);
+    EXPECT_EQ(stats.dropped, 1u);
+}
+
+TEST(AsyncEventBusTest, BlockWaitsForRoom) {
+    AsyncEventBus bus({.capacity = 1, .overflow = OverflowPolicy::Block});
+    std::atomic<int> received{0};
+    bus.subscribe<MessageReceived>(
+        [&](MessageReceived const &) { ++received; });
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("g1", "1"));
+
+    std::atomic<bool> returned{false};
+    std::thread publisher([&] {
+        bus.publish(messageIn("g1", "2"));
+        returned = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(returned);
+
+    gate.release();
+    publisher.join();
+    bus.flush();
+    EXPECT_EQ(received, 2);
+    EXPECT_EQ(bus.stats().dropped, 0u);
+}
+
+TEST(AsyncEventBusTest, BatchHandlersGroupByTopic) {
+    AsyncEventBus bus;
+    std::vector<std::pair<std::string, std::size_t>> batches;
+    std::vector<std::string> chatX;
+    bus.subscribeBatch<MessageReceived>(
+        [&](EventBatch<MessageReceived> batch) {
+            batches.emplace_back(std::string(batch.key()), batch.size());
+        });
+    bus.subscribeBatch<MessageReceived>(
+        "x", [&](EventBatch<MessageReceived> batch) {
+            for (auto &ev : batch) chatX.push_back(ev.message->id);
+        });
+
+    DispatcherGate gate(bus);
+    for (int i = 0; i < 5; ++i) {
+        bus.publish(messageIn("x", "x" + std::to_string(i)));
+        if (i < 3) bus.publish(messageIn("y", "y" + std::to_string(i)));
+    }
+    gate.release();
+    bus.flush();
+
+    using Batch = std::pair<std::string, std::size_t>;
+    EXPECT_EQ(batches, (std::vector<Batch>{{"x", 5}, {"y", 3}}));
+    EXPECT_EQ(chatX,
+              (std::vector<std::string>{"x0", "x1", "x2", "x3", "x4"}));
+}
+
+TEST(AsyncEventBusTest, BatchTopicKeysAreDroppedAfterLastSubscriber) {
+    AsyncEventBus bus;
+    auto batch = bus.subscribeBatch<MessageReceived>(
+        "x", [](EventBatch<MessageReceived>) {});
+    auto single = bus.subscribe<MessageReceived>(
+        "x", [](MessageReceived const &) {});
+    EXPECT_EQ(bus.topicCount(), 2u);
+
+    batch.disconnect();
+    single.disconnect();
+    bus.publish(messageIn("x", "x0"));
+    bus.flush();
+    EXPECT_EQ(bus.topicCount(), 0u);
+}
+
+TEST(AsyncEventBusTest, PublishFromHandlerDoesNotDeadlock) {
+    AsyncEventBus bus({.capacity = 1, .overflow = OverflowPolicy::Block});
+    std::atomic<int> received{0};
+    bus.subscribe<MessageReceived>([&](MessageReceived const &ev) {
+        ++received;
+        if (ev.message->id == "first") {
+            bus.publish(messageIn("g1", "second"));
+            bus.publish(messageIn("g1", "third"));
+        }
+    });
+
+    bus.publish(messageIn("g1", "first"));
+    bus.flush();
+    EXPECT_EQ(received, 3);
+}
+
+TEST(AsyncEventBusTest, ThrowingHandlersDoNotStopDispatch) {
+    AsyncEventBus bus;
+    std::atomic<int> received{0};
+    std::atomic<int> batched{0};
+    bus.subscribe<MessageReceived>([&](MessageReceived const &ev) {
+        if (ev.message->id == "bad") throw std::runtime_error("handler");
+        ++received;
+    });
+    bus.subscribeBatch<MessageReceived>(
+        [&](EventBatch<MessageReceived> batch) {
+            batched += static_cast<int>(batch.size());
+            throw 42; // 非 std::exception 也要拦住
+        });
+
+    DispatcherGate gate(bus);
+    for (int i = 0; i < 4; ++i) {
+        bus.publish(messageIn("g1", "ok"));
+        bus.publish(messageIn("g1", "bad"));
+    }
+    gate.release();
+    bus.flush(); // 分发线程还活着且已回到空闲，flush 才会返回
+
+    EXPECT_EQ(received, 4);
+    EXPECT_EQ(batched, 8);
+    bus.publish(messageIn("g1", "ok"));
+    bus.flush();
+    EXPECT_EQ(received, 5);
+}
+
+TEST(AsyncEventBusTest, DestructorDrainsQueue) {
+    std::atomic<int> received{0};
+    {
+        AsyncEventBus bus;
+        bus.subscribe<MessageReceived>(
+            [&](MessageReceived const &) { ++received; });
+        for (int i = 0; i < 50; ++i) bus.publish(messageIn("g1", "m"));
+    }
+    EXPECT_EQ(received, 50);
+}
+
+TEST(AsyncEventBusTest, HighPriorityOvertakesQueuedLow) {
+    AsyncEventBus bus;
+    std::vector<std::string> ids;
+    bus.subscribe<MessageReceived>(
+        [&](MessageReceived const &ev) { ids.push_back(ev.message->id); });
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("g1", "sync1"), EventPriority::Low);
+    bus.publish(messageIn("g1", "sync2"), EventPriority::Low);
+    bus.publish(messageIn("g1", "live")); // MessageReceived 默认 High
+    gate.release();
+    bus.flush();
+
+    EXPECT_EQ(ids, (std::vector<std::string>{"live", "sync1", "sync2"}));
+}
+
+TEST(AsyncEventBusTest, StarvationLimitServesLowLane) {
+    AsyncEventBus bus({.maxBatch = 1, .starvationLimit = 2});
+    std::vector<std::string> ids;
+    bus.subscribe<MessageReceived>(
+        [&](MessageReceived const &ev) { ids.push_back(ev.message->id); });
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("g1", "l1"), EventPriority::Low);
+    bus.publish(messageIn("g1", "l2"), EventPriority::Low);
+    for (int i = 1; i <= 6; ++i)
+        bus.publish(messageIn("g1", "h" + std::to_string(i)),
+                    EventPriority::High);
+    gate.release();
+    bus.flush();
+
+    EXPECT_EQ(ids, (std::vector<std::string>{"h1", "h2", "l1", "h3", "h4",
+                                             "l2", "h5", "h6"}));
+}
+
+TEST(AsyncEventBusTest, PerLaneDepthAndLatency) {
+    AsyncEventBus bus;
+    bus.subscribe<MessageReceived>([](MessageReceived const &) {});
+
+    DispatcherGate gate(bus);
+    bus.publish(messageIn("g1", "a"), EventPriority::Low);
+    bus.publish(messageIn("g1", "b"), EventPriority::Low);
+    bus.publish(messageIn("g1", "c"), EventPriority::High);
+    EXPECT_EQ(bus.pending(EventPriority::Low), 2u);
+    EXPECT_EQ(bus.pending(EventPriority::High), 1u);
+    EXPECT_EQ(bus.stats().lane(EventPriority::Low).depth, 2u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    gate.release();
+    bus.flush();
+
+    auto stats = bus.stats();
+    auto &low = stats.lane(EventPriority::Low);
+    EXPECT_EQ(low.depth, 0u);
+    EXPECT_EQ(low.published, 2u);
+    EXPECT_EQ(low.dispatched, 2u);
+    EXPECT_GE(low.maxLatency, std::chrono::milliseconds(5));
+    EXPECT_GE(low.averageLatency(), std::chrono::milliseconds(5));
+    EXPECT_EQ(stats.lane(EventPriority::High).dispatched, 1u);
+    EXPECT_EQ(stats.dispatched, 4u); // 含 DispatcherGate 的 Normal 事件
+}
+
+// ── Executor ──
+
+TEST(ExecutorTest, SubmitReturnsValueAndPropagatesException) {
+    Executor pool(ExecutorOptions{.threads = 2});
+    auto value = pool.submit([] { return 6 * 7; });
+    auto failed = pool.submit([]() -> int { throw std::logic_error("boom"); });
+    auto done = pool.submit([] {});
+
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_THROW(failed.get(), std::logic_error);
+    done.get();
+    EXPECT_EQ(pool.threadCount(), 2u);
+}
+
+TEST(ExecutorTest, RunInlineExecutesOnCallerThread) {
+    Executor pool(ExecutorOptions{.runInline = true});
+    auto caller = std::this_thread::get_id();
+    auto ran = pool.submit([] { return std::this_thread::get_id(); });
+    ASSERT_EQ(ran.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(ran.get(), caller);
+    EXPECT_EQ(pool.threadCount(), 0u);
+
+    int posted = 0;
+    pool.post([&] { ++posted; });
+    EXPECT_EQ(posted, 1);
+}
+
+TEST(ExecutorTest, CancelledBeforeStartNeverRuns) {
+    Executor pool(ExecutorOptions{.threads = 1});
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    pool.post([gate] { gate.wait(); });
+
+    CancellationSource cancel;
+    bool ran = false;
+    auto task = pool.submit([&] { ran = true; }, TaskPriority::Normal,
+                            cancel.token());
+    cancel.cancel();
+    release.set_value();
+
+    EXPECT_THROW(task.get(), TaskCancelled);
+    EXPECT_FALSE(ran);
+    pool.waitIdle();
+    EXPECT_EQ(pool.stats().cancelled, 1u);
+}
+
+TEST(ExecutorTest, HigherPriorityRunsFirst) {
+    Executor pool(ExecutorOptions{.threads = 1});
+    std::promise<void> started, release;
+    auto gate = release.get_future().share();
+    pool.post([&started, gate] {
+        started.set_value();
+        gate.wait();
+    });
+    started.get_future().wait();
+
+    std::vector<std::string> order; // 单线程执行，无需加锁
+    pool.post([&] { order.push_back("low"); }, TaskPriority::Low);
+    pool.post([&] { order.push_back("normal"); });
+    pool.post([&] { order.push_back("high"); }, TaskPriority::High);
+    EXPECT_EQ(pool.stats().queueDepth, 3u);
+
+    release.set_value();
+    pool.waitIdle();
+    EXPECT_EQ(order, (std::vector<std::string>{"high", "normal", "low"}));
+}
+
+TEST(ExecutorTest, IdleWorkerStealsAndStatsAreExported) {
+    Executor pool(ExecutorOptions{.threads = 2});
+    constexpr int Children = 16;
+    std::atomic<int> ran{0};
+
+    // 父任务把子任务压入自己的队列后阻塞，子任务只能被另一个线程窃取
+    auto parent = pool.submit([&] {
+        std::vector<std::future<void>> children;
+        for (int i = 0; i < Children; ++i)
+            children.push_back(pool.submit([&] { ++ran; }));
+        EXPECT_TRUE(pool.inWorkerThread());
+        for (auto &child : children) child.get();
+    });
+    parent.get();
+    pool.waitIdle();
+
+    auto stats = pool.stats();
+    EXPECT_EQ(ran.load(), Children);
+    // 父任务本身也可能是被窃取的
+    EXPECT_GE(stats.steals, static_cast<std::uint64_t>(Children));
+    EXPECT_EQ(stats.submitted, Children + 1u);
+    EXPECT_EQ(stats.completed, Children + 1u);
+    EXPECT_EQ(stats.queueDepth, 0u);
+    EXPECT_GE(stats.maxLatency, stats.averageLatency());
+    EXPECT_FALSE(pool.inWorkerThread());
+}
+
+TEST(ExecutorTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> ran{0};
+    {
+        Executor pool(ExecutorOptions{.threads = 1});
+        for (int i = 0; i < 100; ++i) pool.post([&] { ++ran; });
+    }
+    EXPECT_EQ(ran.load(), 100);
+}
+
+// ── Task ──
+
+namespace {
+
+Task<int> answer() { co_return 42; }
+
+Task<int> addOne(Task<int> inner) { co_return co_await std::move(inner) + 1; }
+
+Task<int> failing() {
+    throw std::logic_error("boom");
+    co_return 0;
+}
+
+Task<bool> onPool(Executor &pool) {
+    co_await resumeOn(pool);
+    co_return pool.inWorkerThread();
+}
+
+} // namespace
+
+TEST(TaskTest, LazyChainAndExceptionPropagation) {
+    auto task = addOne(answer());
+    EXPECT_FALSE(task.done()); // 未被等待前不执行
+    EXPECT_EQ(syncWait(std::move(task)), 43);
+    EXPECT_THROW(syncWait(failing()), std::logic_error);
+}
+
+TEST(TaskTest, ResumeOnMovesToExecutorThread) {
+    Executor pool(ExecutorOptions{.threads = 1});
+    EXPECT_TRUE(syncWait(onPool(pool)));
+
+    Executor inlinePool(ExecutorOptions{.runInline = true});
+    EXPECT_FALSE(syncWait(onPool(inlinePool)));
+}
+
+TEST(TaskTest, WhenAllKeepsOrderWithManyInFlight) {
+    Executor pool(ExecutorOptions{.threads = 2});
+    constexpr int Count = 500;
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+
+    // 所有任务先挂起在同一个闸门上：500 个请求同时在途，只占 2 个线程
+    auto request = [&](int i) -> Task<int> {
+        co_await resumeOn(pool);
+        co_return i * 2;
+    };
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < Count; ++i) tasks.push_back(request(i));
+    pool.post([gate] { gate.wait(); });
+    pool.post([gate] { gate.wait(); });
+
+    auto all = whenAll(std::move(tasks));
+    std::thread releaser([&] {
+        while (pool.stats().queueDepth < Count) std::this_thread::yield();
+        release.set_value();
+    });
+    auto results = syncWait(std::move(all));
+    releaser.join();
+
+    ASSERT_EQ(results.size(), static_cast<std::size_t>(Count));
+    for (int i = 0; i < Count; ++i) EXPECT_EQ(results[i], i * 2);
+    EXPECT_EQ(pool.threadCount(), 2u);
+    EXPECT_TRUE(syncWait(whenAll(std::vector<Task<int>>{})).empty());
+}
+
 // ── SQLite 基础测试 ──
 
 class SQLiteTest : public ::testing::Test {
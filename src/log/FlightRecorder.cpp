@@ -0,0 +1,265 @@
+#include <wechat/log/FlightRecorder.h>
+
+#include <spdlog/common.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace wechat::log {
+
+namespace {
+
+enum class RecordKind : uint8_t {
+    Log = 1,
+    Span = 2,
+};
+
+/// 定长记录，按原样写入转储
+struct Record {
+    uint64_t sequence; // 0 = 空或正在写；写完后为全局序号 + 1
+    int64_t timeNs;    // Unix 纳秒
+    int64_t durationNs;
+    uint32_t threadId;
+    uint8_t kind;
+    uint8_t level;
+    uint16_t length;
+    char text[224];
+};
+static_assert(sizeof(Record) == 256);
+
+struct DumpHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t capacity;
+    uint32_t reserved;
+    uint64_t next; // 下一个待分配的序号
+};
+
+constexpr char Magic[8] = {'W', 'T', 'F', 'L', 'I', 'G', 'H', 'T'};
+constexpr uint32_t Version = 1;
+// 解码时接受的最大容量（16 MiB 记录），防止损坏的头部导致巨量分配
+constexpr uint32_t MaxDumpCapacity = 1u << 16;
+static_assert(FlightRecorderCapacity <= MaxDumpCapacity);
+
+static_assert((FlightRecorderCapacity & (FlightRecorderCapacity - 1)) == 0,
+              "capacity must be a power of two");
+
+std::array<Record, FlightRecorderCapacity> ring{};
+std::atomic<uint64_t> next{0};
+
+std::atomic<uint32_t> nextThreadId{1};
+thread_local uint32_t threadId =
+    nextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+// 信号处理函数里不能构造 path，预先转为定长字符串
+char crashPath[1024];
+
+/// 领取一个槽位并写入；缓冲被追圈时覆盖最旧的记录
+void write(RecordKind kind, uint8_t level, int64_t durationNs,
+           std::string_view first, std::string_view second = {}) {
+    auto sequence = next.fetch_add(1, std::memory_order_relaxed);
+    auto& record = ring[sequence & (FlightRecorderCapacity - 1)];
+    std::atomic_ref<uint64_t> marker(record.sequence);
+    marker.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+    record.durationNs = durationNs;
+    record.threadId = threadId;
+    record.kind = static_cast<uint8_t>(kind);
+    record.level = level;
+    auto n = std::min(first.size(), sizeof(record.text));
+    std::memcpy(record.text, first.data(), n);
+    if (!second.empty() && n < sizeof(record.text)) {
+        record.text[n++] = '/';
+        auto m = std::min(second.size(), sizeof(record.text) - n);
+        std::memcpy(record.text + n, second.data(), m);
+        n += m;
+    }
+    record.length = static_cast<uint16_t>(n);
+
+    marker.store(sequence + 1, std::memory_order_release);
+}
+
+#ifdef _WIN32
+int openForWrite(const char* path) {
+    return ::_open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+}
+bool writeAll(int fd, const void* data, std::size_t size) {
+    return ::_write(fd, data, static_cast<unsigned>(size)) ==
+           static_cast<int>(size);
+}
+void closeFile(int fd) { ::_close(fd); }
+#else
+int openForWrite(const char* path) {
+    return ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+bool writeAll(int fd, const void* data, std::size_t size) {
+    auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        auto written = ::write(fd, bytes, size);
+        if (written <= 0) return false;
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+void closeFile(int fd) { ::close(fd); }
+#endif
+
+/// 只使用异步信号安全的调用；records 为 FlightRecorderCapacity 条记录
+bool dumpTo(const char* path, const Record* records) {
+    int fd = openForWrite(path);
+    if (fd < 0) return false;
+    DumpHeader header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.recordSize = sizeof(Record);
+    header.capacity = FlightRecorderCapacity;
+    header.next = next.load(std::memory_order_acquire);
+    bool ok = writeAll(fd, &header, sizeof(header)) &&
+              writeAll(fd, records, sizeof(Record) * FlightRecorderCapacity);
+    closeFile(fd);
+    return ok;
+}
+
+/// 按 seqlock 方式逐条复制：复制前后序号不变才算完整，
+/// 正在写或复制期间被覆盖的槽位清零序号，解码时丢弃
+std::vector<Record> snapshotRing() {
+    std::vector<Record> copy(FlightRecorderCapacity);
+    for (std::size_t i = 0; i < FlightRecorderCapacity; ++i) {
+        std::atomic_ref<uint64_t> marker(ring[i].sequence);
+        auto before = marker.load(std::memory_order_acquire);
+        std::memcpy(&copy[i], &ring[i], sizeof(Record));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (before == 0 || marker.load(std::memory_order_relaxed) != before)
+            copy[i].sequence = 0;
+        else
+            copy[i].sequence = before;
+    }
+    return copy;
+}
+
+constexpr int CrashSignals[] = {
+    SIGSEGV, SIGABRT, SIGILL, SIGFPE,
+#ifdef SIGBUS
+    SIGBUS,
+#endif
+};
+
+extern "C" void onCrash(int signal) {
+    // 信号处理函数里不能分配，直接写出环形缓冲；崩溃时仍在写的线程
+    // 可能留下一条不完整的记录
+    dumpTo(crashPath, ring.data());
+    std::signal(signal, SIG_DFL);
+    std::raise(signal);
+}
+
+} // namespace
+
+void recordFlightLog(int level, std::string_view text) {
+    write(RecordKind::Log, static_cast<uint8_t>(level), 0, text);
+}
+
+void recordFlightSpan(std::string_view category, std::string_view name,
+                      int64_t durationNs) {
+    write(RecordKind::Span, 0, durationNs, category, name);
+}
+
+bool dumpFlightRecorder(const std::filesystem::path& path) {
+    auto records = snapshotRing();
+    return dumpTo(path.string().c_str(), records.data());
+}
+
+void installCrashHandler(const std::filesystem::path& path) {
+    auto text = path.string();
+    auto n = std::min(text.size(), sizeof(crashPath) - 1);
+    std::memcpy(crashPath, text.data(), n);
+    crashPath[n] = '\0';
+    for (int signal : CrashSignals) std::signal(signal, onCrash);
+}
+
+bool decodeFlightDump(std::istream& in, std::ostream& out) {
+    DumpHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+        header.version != Version || header.recordSize != sizeof(Record))
+        return false;
+    // 容量必须是不超过上限的 2 的幂，且与剩余长度严格相等，校验通过才分配
+    auto capacity = header.capacity;
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        capacity > MaxDumpCapacity)
+        return false;
+    auto payload = static_cast<std::streamoff>(capacity) * sizeof(Record);
+    if (auto start = in.tellg(); start != std::streampos(-1)) {
+        in.seekg(0, std::ios::end);
+        auto end = in.tellg();
+        in.seekg(start);
+        if (!in || end - start != payload) return false;
+    }
+
+    std::vector<Record> records(capacity);
+    if (!in.read(reinterpret_cast<char*>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(Record))))
+        return false;
+
+    // 丢弃空槽、写到一半（或复制时被覆盖）的槽和序号越界的槽，
+    // 按写入顺序输出
+    std::erase_if(records, [&](const Record& r) {
+        return r.sequence == 0 || r.sequence > header.next ||
+               r.length > sizeof(r.text);
+    });
+    std::sort(records.begin(), records.end(),
+              [](const Record& a, const Record& b) {
+                  return a.sequence < b.sequence;
+              });
+
+    for (auto const& r : records) {
+        using namespace std::chrono;
+        sys_time<microseconds> time(duration_cast<microseconds>(
+            nanoseconds(r.timeNs)));
+        auto day = floor<days>(time);
+        year_month_day date(day);
+        hh_mm_ss clock(time - day);
+        auto when = fmt::format(
+            "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:06}Z",
+            static_cast<int>(date.year()), static_cast<unsigned>(date.month()),
+            static_cast<unsigned>(date.day()), clock.hours().count(),
+            clock.minutes().count(), clock.seconds().count(),
+            clock.subseconds().count());
+        std::string_view text(r.text, r.length);
+        if (r.kind == static_cast<uint8_t>(RecordKind::Span)) {
+            out << fmt::format("{} [span] [t{}] {} {:.3f}us\n", when,
+                               r.threadId, text, r.durationNs / 1000.0);
+        } else {
+            auto level = static_cast<spdlog::level::level_enum>(
+                std::min<int>(r.level, spdlog::level::off));
+            auto name = spdlog::level::to_string_view(level);
+            out << fmt::format("{} [{}] [t{}] {}\n", when,
+                               std::string_view(name.data(), name.size()),
+                               r.threadId, text);
+        }
+    }
+    return true;
+}
+
+} // namespace wechat::log
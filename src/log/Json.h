@@ -0,0 +1,27 @@
+#pragma once
+
+#include <spdlog/fmt/fmt.h>
+
+#include <string>
+#include <string_view>
+
+namespace wechat::log {
+
+/// 追加 JSON 字符串内容（不含两侧引号），转义引号、反斜杠和控制字符
+inline void appendJsonEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += fmt::format("\\u{:04x}", c);
+            } else {
+                out += c;
+            }
+        }
+    }
+}
+
+} // namespace wechat::log
@@ -1,15 +1,104 @@
 #include <wechat/log/Log.h>
 
-#include <spdlog/spdlog.h>
+#include <wechat/log/FlightRecorder.h>
+
+#include <spdlog/async.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
 
-#include <filesystem>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 
 namespace wechat::log {
 
-void init() {
-    auto logDir = std::filesystem::current_path() / "logs";
+namespace {
+
+/// 在调用方线程写入飞行记录器：进程崩溃时还在异步队列里的日志也不会丢
+class FlightRecorderSink final
+    : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        recordFlightLog(static_cast<int>(msg.level),
+                        std::string_view(msg.payload.data(), msg.payload.size()));
+    }
+    void flush_() override {}
+};
+
+/// 把消息转交给异步 logger，由其后台线程写文件 / 控制台
+class AsyncForwardSink final
+    : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+public:
+    explicit AsyncForwardSink(std::shared_ptr<spdlog::async_logger> target)
+        : target(std::move(target)) {}
+
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        target->log(msg.time, msg.source, msg.level, msg.payload);
+    }
+    void flush_() override { target->flush(); }
+
+private:
+    std::shared_ptr<spdlog::async_logger> target;
+};
+
+/// 模块 logger 的 sink：加上 "[module] " 前缀后交给当前默认 logger 的 sink，
+/// 不经过默认 logger 的级别过滤，重新 init 后自动写到新的 sink
+class ModuleSink final
+    : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        auto* target = spdlog::default_logger_raw();
+        if (!target) return; // shutdown 之后
+
+        spdlog::memory_buf_t text;
+        fmt::format_to(std::back_inserter(text), "[{}] {}", msg.logger_name,
+                       msg.payload);
+        spdlog::details::log_msg prefixed(
+            msg.time, msg.source, msg.logger_name, msg.level,
+            spdlog::string_view_t(text.data(), text.size()));
+        for (auto& sink : target->sinks())
+            if (sink->should_log(msg.level)) sink->log(prefixed);
+    }
+    void flush_() override {
+        if (auto* target = spdlog::default_logger_raw()) target->flush();
+    }
+};
+
+struct ModuleRegistry {
+    std::mutex mutex;
+    std::shared_ptr<ModuleSink> sink = std::make_shared<ModuleSink>();
+    std::map<std::string, std::shared_ptr<spdlog::logger>, std::less<>>
+        loggers;
+    /// 单独设置过的级别（包括尚未创建的模块）
+    std::map<std::string, spdlog::level::level_enum, std::less<>> levels;
+};
+
+ModuleRegistry& modules() {
+    static ModuleRegistry registry;
+    return registry;
+}
+
+spdlog::level::level_enum defaultLevel() {
+    if (auto* logger = spdlog::default_logger_raw()) return logger->level();
+    return spdlog::level::info;
+}
+
+// 自建线程池而不用 spdlog 全局池，以便读取丢弃计数
+std::mutex poolMutex;
+std::shared_ptr<spdlog::details::thread_pool> pool;
+
+} // namespace
+
+void init(LogOptions options) {
+    auto logDir = options.directory.empty()
+                      ? std::filesystem::current_path() / "logs"
+                      : options.directory;
     std::filesystem::create_directories(logDir);
 
     auto logPath = (logDir / "wetalk.log").string();
@@ -19,13 +108,28 @@ void init() {
 
     std::vector<spdlog::sink_ptr> sinks{dailySink};
 
-#ifndef NDEBUG
-    sinks.push_back(
-        std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
-#endif
+    if (options.console) {
+        sinks.push_back(
+            std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+    }
 
-    auto logger =
-        std::make_shared<spdlog::logger>("wetalk", sinks.begin(), sinks.end());
+    // 单个后台线程按顺序写出，保证日志不乱序
+    auto threadPool =
+        std::make_shared<spdlog::details::thread_pool>(options.queueSize, 1);
+    auto policy = options.overflow == OverflowPolicy::Block
+                      ? spdlog::async_overflow_policy::block
+                      : spdlog::async_overflow_policy::overrun_oldest;
+    auto writer = std::make_shared<spdlog::async_logger>(
+        "wetalk-writer", sinks.begin(), sinks.end(), threadPool, policy);
+    writer->set_level(spdlog::level::trace); // 级别由前端 logger 过滤
+    writer->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+
+    // 前端 logger 同步执行，两个 sink 都不加锁：飞行记录器无锁，
+    // 异步 logger 自身线程安全
+    spdlog::sinks_init_list frontSinks{
+        std::make_shared<FlightRecorderSink>(),
+        std::make_shared<AsyncForwardSink>(writer)};
+    auto logger = std::make_shared<spdlog::logger>("wetalk", frontSinks);
 
 #ifdef NDEBUG
     logger->set_level(spdlog::level::info);
@@ -33,9 +137,93 @@ void init() {
     logger->set_level(spdlog::level::trace);
 #endif
 
-    logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+    logger->flush_on(spdlog::level::err);
     spdlog::set_default_logger(logger);
-    spdlog::flush_every(std::chrono::seconds(3));
+    spdlog::flush_every(options.flushInterval);
+
+    if (options.crashHandler) installCrashHandler(logDir / "flight.bin");
+
+    if (const char* spec = std::getenv("WECHAT_LOG_LEVELS")) {
+        if (!applyLevels(spec))
+            spdlog::warn("WECHAT_LOG_LEVELS contains invalid entries: {}",
+                         spec);
+    }
+
+    std::lock_guard lock(poolMutex);
+    pool = std::move(threadPool);
+}
+
+void shutdown() {
+    spdlog::shutdown();
+    std::shared_ptr<spdlog::details::thread_pool> last;
+    {
+        std::lock_guard lock(poolMutex);
+        last = std::move(pool);
+    }
+    // 析构时处理完队列中剩余的消息再退出
+    last.reset();
+}
+
+spdlog::logger& moduleLogger(std::string_view module) {
+    auto& registry = modules();
+    std::lock_guard lock(registry.mutex);
+    if (auto it = registry.loggers.find(module); it != registry.loggers.end())
+        return *it->second;
+
+    auto logger =
+        std::make_shared<spdlog::logger>(std::string(module), registry.sink);
+    auto level = registry.levels.find(module);
+    logger->set_level(level != registry.levels.end() ? level->second
+                                                     : defaultLevel());
+    logger->flush_on(spdlog::level::err);
+    return *registry.loggers.emplace(std::string(module), std::move(logger))
+                .first->second;
+}
+
+void setLevel(std::string_view module, spdlog::level::level_enum level) {
+    auto& registry = modules();
+    std::lock_guard lock(registry.mutex);
+    if (module != "*") {
+        registry.levels.insert_or_assign(std::string(module), level);
+        if (auto it = registry.loggers.find(module);
+            it != registry.loggers.end())
+            it->second->set_level(level);
+        return;
+    }
+
+    if (auto* logger = spdlog::default_logger_raw()) logger->set_level(level);
+    for (auto& [name, logger] : registry.loggers)
+        if (!registry.levels.contains(name)) logger->set_level(level);
+}
+
+bool applyLevels(std::string_view spec) {
+    bool valid = true;
+    while (!spec.empty()) {
+        auto comma = spec.find(',');
+        auto item = spec.substr(0, comma);
+        spec = comma == std::string_view::npos ? std::string_view{}
+                                               : spec.substr(comma + 1);
+        if (item.empty()) continue;
+
+        auto equals = item.find('=');
+        auto module = item.substr(0, equals);
+        auto name = equals == std::string_view::npos ? std::string_view{}
+                                                     : item.substr(equals + 1);
+        // from_str 对无法识别的名称返回 off
+        auto level = spdlog::level::from_str(std::string(name));
+        if (module.empty() || name.empty() ||
+            (level == spdlog::level::off && name != "off")) {
+            valid = false;
+            continue;
+        }
+        setLevel(module, level);
+    }
+    return valid;
+}
+
+std::uint64_t droppedCount() {
+    std::lock_guard lock(poolMutex);
+    return pool ? pool->overrun_counter() : 0;
 }
 
 } // namespace wechat::log
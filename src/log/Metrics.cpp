@@ -0,0 +1,321 @@
+#include <wechat/log/Metrics.h>
+
+#include "Json.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace wechat::log {
+
+// ── HistogramSnapshot ──
+
+uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) return 0;
+    auto rank = static_cast<uint64_t>(
+        std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count)));
+    rank = std::clamp<uint64_t>(rank, 1, count);
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(Histogram::bucketUpperBound(i), max);
+    }
+    return max;
+}
+
+// ── Histogram ──
+
+namespace {
+
+constexpr std::size_t SubBucketCount = std::size_t{1}
+                                       << Histogram::SubBucketBits;
+
+/// 一个线程的分片；count 由 buckets 求和得到
+struct alignas(64) Stripe {
+    std::array<std::atomic<uint64_t>, Histogram::BucketCount> buckets{};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max{0};
+};
+
+/// 一个直方图的全部分片；线程缓存也持有它，直方图先于线程销毁时不悬空
+struct Stripes {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Stripe>> all;
+    std::vector<Stripe*> idle; // 已退出线程留下的分片，新线程复用
+};
+
+/// 当前线程在各直方图上的分片，线程退出时交还给对应直方图
+class ThreadStripes {
+public:
+    ~ThreadStripes() {
+        for (auto& [id, entry] : entries) {
+            std::lock_guard lock(entry.owner->mutex);
+            entry.owner->idle.push_back(entry.stripe);
+        }
+    }
+
+    Stripe& get(uint64_t id, const std::shared_ptr<Stripes>& owner) {
+        if (id == lastId) return *lastStripe;
+        auto it = entries.find(id);
+        if (it == entries.end()) it = entries.emplace(id, adopt(owner)).first;
+        lastId = id;
+        lastStripe = it->second.stripe;
+        return *lastStripe;
+    }
+
+private:
+    struct Entry {
+        std::shared_ptr<Stripes> owner;
+        Stripe* stripe;
+    };
+
+    Entry adopt(const std::shared_ptr<Stripes>& owner) {
+        // 顺便丢掉已销毁直方图的分片：只剩本线程持有时不会再有人读
+        std::erase_if(entries, [](auto const& item) {
+            return item.second.owner.use_count() == 1;
+        });
+        std::lock_guard lock(owner->mutex);
+        if (!owner->idle.empty()) {
+            auto* stripe = owner->idle.back();
+            owner->idle.pop_back();
+            return {owner, stripe};
+        }
+        return {owner, owner->all.emplace_back(new Stripe).get()};
+    }
+
+    std::unordered_map<uint64_t, Entry> entries;
+    uint64_t lastId = 0;
+    Stripe* lastStripe = nullptr;
+};
+
+thread_local ThreadStripes threadStripes;
+
+// 直方图编号从 1 开始且不复用，地址被新直方图复用时线程缓存不会串
+std::atomic<uint64_t> nextHistogramId{1};
+
+} // namespace
+
+struct Histogram::Impl {
+    Stripe& stripe() { return threadStripes.get(id, stripes); }
+
+    uint64_t id = nextHistogramId.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<Stripes> stripes = std::make_shared<Stripes>();
+};
+
+Histogram::Histogram() : impl(std::make_unique<Impl>()) {}
+Histogram::~Histogram() = default;
+
+std::size_t Histogram::bucketIndex(uint64_t value) {
+    if (value < SubBucketCount) return static_cast<std::size_t>(value);
+    auto magnitude = static_cast<std::size_t>(std::bit_width(value)) - 1;
+    if (magnitude > MaxMagnitude) return BucketCount - 1;
+    auto shift = magnitude - SubBucketBits;
+    auto sub = static_cast<std::size_t>(value >> shift) & (SubBucketCount - 1);
+    return SubBucketCount * (shift + 1) + sub;
+}
+
+uint64_t Histogram::bucketUpperBound(std::size_t index) {
+    if (index < SubBucketCount) return index;
+    auto shift = index / SubBucketCount - 1;
+    auto sub = index % SubBucketCount;
+    auto lower = static_cast<uint64_t>(SubBucketCount + sub) << shift;
+    return lower + (uint64_t{1} << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+    auto& stripe = impl->stripe();
+    stripe.buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    stripe.sum.fetch_add(value, std::memory_order_relaxed);
+    auto low = stripe.min.load(std::memory_order_relaxed);
+    while (value < low && !stripe.min.compare_exchange_weak(
+                              low, value, std::memory_order_relaxed)) {
+    }
+    auto high = stripe.max.load(std::memory_order_relaxed);
+    while (value > high && !stripe.max.compare_exchange_weak(
+                               high, value, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot s;
+    s.buckets.assign(BucketCount, 0);
+    uint64_t low = std::numeric_limits<uint64_t>::max();
+    std::lock_guard lock(impl->stripes->mutex);
+    for (auto& stripe : impl->stripes->all) {
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            auto n = stripe->buckets[i].load(std::memory_order_relaxed);
+            s.buckets[i] += n;
+            s.count += n;
+        }
+        s.sum += stripe->sum.load(std::memory_order_relaxed);
+        low = std::min(low, stripe->min.load(std::memory_order_relaxed));
+        s.max = std::max(s.max, stripe->max.load(std::memory_order_relaxed));
+    }
+    s.min = s.count ? low : 0;
+    return s;
+}
+
+void Histogram::reset() {
+    std::lock_guard lock(impl->stripes->mutex);
+    for (auto& stripe : impl->stripes->all) {
+        for (auto& bucket : stripe->buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        stripe->sum.store(0, std::memory_order_relaxed);
+        stripe->min.store(std::numeric_limits<uint64_t>::max(),
+                          std::memory_order_relaxed);
+        stripe->max.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ── MetricsSnapshot ──
+
+namespace {
+
+template <typename List>
+auto findByName(const List& list, std::string_view name)
+    -> decltype(&list.front()) {
+    auto it = std::find_if(list.begin(), list.end(),
+                           [&](auto const& item) { return item.name == name; });
+    return it != list.end() ? &*it : nullptr;
+}
+
+} // namespace
+
+const MetricsSnapshot::CounterValue*
+MetricsSnapshot::counter(std::string_view name) const {
+    return findByName(counters, name);
+}
+
+const MetricsSnapshot::GaugeValue*
+MetricsSnapshot::gauge(std::string_view name) const {
+    return findByName(gauges, name);
+}
+
+const HistogramSnapshot*
+MetricsSnapshot::histogram(std::string_view name) const {
+    auto* found = findByName(histograms, name);
+    return found ? &found->data : nullptr;
+}
+
+std::string MetricsSnapshot::toText() const {
+    std::string out;
+    for (auto const& c : counters)
+        out += fmt::format("counter   {} {}\n", c.name, c.value);
+    for (auto const& g : gauges)
+        out += fmt::format("gauge     {} {}\n", g.name, g.value);
+    for (auto const& h : histograms) {
+        auto const& d = h.data;
+        out += fmt::format(
+            "histogram {} count={} mean={:.1f} p50={} p99={} p999={} max={}\n",
+            h.name, d.count, d.mean(), d.percentile(0.5), d.percentile(0.99),
+            d.percentile(0.999), d.max);
+    }
+    return out;
+}
+
+std::string MetricsSnapshot::toJson() const {
+    std::string out = R"({"counters":{)";
+    auto key = [&](bool first, std::string_view name) {
+        if (!first) out += ',';
+        out += '"';
+        appendJsonEscaped(out, name);
+        out += "\":";
+    };
+    for (std::size_t i = 0; i < counters.size(); ++i) {
+        key(i == 0, counters[i].name);
+        out += fmt::format("{}", counters[i].value);
+    }
+    out += R"(},"gauges":{)";
+    for (std::size_t i = 0; i < gauges.size(); ++i) {
+        key(i == 0, gauges[i].name);
+        out += fmt::format("{}", gauges[i].value);
+    }
+    out += R"(},"histograms":{)";
+    for (std::size_t i = 0; i < histograms.size(); ++i) {
+        auto const& d = histograms[i].data;
+        key(i == 0, histograms[i].name);
+        out += fmt::format(
+            R"({{"count":{},"sum":{},"min":{},"max":{},"mean":{:.3f},)"
+            R"("p50":{},"p90":{},"p99":{},"p999":{}}})",
+            d.count, d.sum, d.min, d.max, d.mean(), d.percentile(0.5),
+            d.percentile(0.9), d.percentile(0.99), d.percentile(0.999));
+    }
+    out += "}}";
+    return out;
+}
+
+// ── MetricsRegistry ──
+
+struct MetricsRegistry::Impl {
+    template <typename Metric>
+    using Table = std::map<std::string, std::unique_ptr<Metric>, std::less<>>;
+
+    template <typename Metric>
+    Metric& getOrCreate(Table<Metric>& table, std::string_view name) {
+        std::lock_guard lock(mutex);
+        auto it = table.find(name);
+        if (it == table.end())
+            it = table.emplace(std::string(name), std::make_unique<Metric>())
+                     .first;
+        return *it->second;
+    }
+
+    mutable std::mutex mutex;
+    Table<Counter> counters;
+    Table<Gauge> gauges;
+    Table<Histogram> histograms;
+};
+
+MetricsRegistry::MetricsRegistry() : impl(std::make_unique<Impl>()) {}
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+Counter& MetricsRegistry::counter(std::string_view name) {
+    return impl->getOrCreate(impl->counters, name);
+}
+
+Gauge& MetricsRegistry::gauge(std::string_view name) {
+    return impl->getOrCreate(impl->gauges, name);
+}
+
+Histogram& MetricsRegistry::histogram(std::string_view name) {
+    return impl->getOrCreate(impl->histograms, name);
+}
+
+Timer MetricsRegistry::timer(std::string_view name) {
+    return Timer{histogram(name), counter(std::string(name) + ".errors")};
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot s;
+    std::lock_guard lock(impl->mutex);
+    for (auto const& [name, c] : impl->counters)
+        s.counters.push_back({name, c->value()});
+    for (auto const& [name, g] : impl->gauges)
+        s.gauges.push_back({name, g->value()});
+    for (auto const& [name, h] : impl->histograms)
+        s.histograms.push_back({name, h->snapshot()});
+    return s;
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard lock(impl->mutex);
+    for (auto& [name, c] : impl->counters) c->reset();
+    for (auto& [name, g] : impl->gauges) g->reset();
+    for (auto& [name, h] : impl->histograms) h->reset();
+}
+
+} // namespace wechat::log
@@ -0,0 +1,174 @@
+#include <wechat/log/Trace.h>
+
+#include <wechat/log/FlightRecorder.h>
+
+#include "Json.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace wechat::log {
+
+namespace detail {
+std::atomic<bool> tracing{false};
+} // namespace detail
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Clock::time_point const processStart = Clock::now();
+
+struct Event {
+    const char* name;
+    const char* category;
+    int64_t start; // ns
+    int64_t duration;
+};
+
+/// 单个线程的环形缓冲。只有所属线程写入，mutex 仅在导出 / 清空时竞争
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<Event> ring;
+    std::size_t head = 0; // 写满后指向最旧的事件
+    std::size_t capacity = 0;
+    uint32_t tid = 0;
+    std::string threadName;
+
+    void reset(std::size_t newCapacity) {
+        ring.clear();
+        head = 0;
+        capacity = newCapacity;
+    }
+};
+
+/// 所有线程的缓冲，线程退出后保留，事件仍可导出
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::size_t capacity = 1 << 16;
+    uint32_t nextTid = 1;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> localBuffer;
+
+ThreadBuffer& currentBuffer() {
+    if (!localBuffer) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        buffer->tid = reg.nextTid++;
+        buffer->capacity = reg.capacity;
+        reg.buffers.push_back(buffer);
+        localBuffer = std::move(buffer);
+    }
+    return *localBuffer;
+}
+
+} // namespace
+
+int64_t TraceSpan::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now() - processStart)
+        .count();
+}
+
+void TraceSpan::record(const char* name, const char* category, int64_t start,
+                       int64_t end) {
+    recordFlightSpan(category, name, end - start);
+    auto& buffer = currentBuffer();
+    std::lock_guard lock(buffer.mutex);
+    if (buffer.capacity == 0) return;
+    Event event{name, category, start, end - start};
+    if (buffer.ring.size() < buffer.capacity) {
+        buffer.ring.push_back(event);
+    } else {
+        buffer.ring[buffer.head] = event;
+        buffer.head = (buffer.head + 1) % buffer.capacity;
+    }
+}
+
+void startTracing(std::size_t perThreadCapacity) {
+    auto& reg = registry();
+    {
+        std::lock_guard lock(reg.mutex);
+        reg.capacity = perThreadCapacity;
+        for (auto& buffer : reg.buffers) {
+            std::lock_guard bufferLock(buffer->mutex);
+            buffer->reset(perThreadCapacity);
+        }
+    }
+    detail::tracing.store(true, std::memory_order_relaxed);
+}
+
+void stopTracing() { detail::tracing.store(false, std::memory_order_relaxed); }
+
+void clearTrace() {
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        std::lock_guard bufferLock(buffer->mutex);
+        buffer->reset(buffer->capacity);
+    }
+}
+
+void setTraceThreadName(std::string name) {
+    auto& buffer = currentBuffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.threadName = std::move(name);
+}
+
+std::string exportChromeTrace() {
+    std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) out += ',';
+        first = false;
+    };
+
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        std::lock_guard bufferLock(buffer->mutex);
+        if (!buffer->threadName.empty()) {
+            separator();
+            out += fmt::format(
+                R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                buffer->tid);
+            appendJsonEscaped(out, buffer->threadName);
+            out += "\"}}";
+        }
+        for (auto const& event : buffer->ring) {
+            separator();
+            out += R"({"name":")";
+            appendJsonEscaped(out, event.name);
+            out += R"(","cat":")";
+            appendJsonEscaped(out, event.category);
+            // ts / dur 单位为微秒，保留纳秒精度
+            out += fmt::format(
+                R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                buffer->tid, event.start / 1000.0, event.duration / 1000.0);
+        }
+    }
+    out += "]}";
+    return out;
+}
+
+bool writeChromeTrace(const std::filesystem::path& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file << exportChromeTrace();
+    return static_cast<bool>(file);
+}
+
+} // namespace wechat::log
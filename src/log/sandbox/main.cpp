@@ -1,4 +1,6 @@
+#include <wechat/log/FlightRecorder.h>
 #include <wechat/log/Log.h>
+#include <wechat/log/Trace.h>
 
 #include <spdlog/spdlog.h>
 
@@ -12,5 +14,28 @@ int main() {
     spdlog::error("This is an error message");
     spdlog::critical("This is a critical message");
 
+    // 小队列 + DropOldest：突发日志不阻塞调用方，超出部分计数丢弃
+    wechat::log::init({.queueSize = 64, .console = false});
+    for (int i = 0; i < 100000; ++i) spdlog::info("burst {}", i);
+    spdlog::warn("dropped {} messages",
+                 static_cast<unsigned long long>(wechat::log::droppedCount()));
+
+    // 记录嵌套 span 并导出，可在 Perfetto 中打开 logs/trace.json
+    wechat::log::startTracing();
+    wechat::log::setTraceThreadName("main");
+    {
+        WECHAT_TRACE_SCOPE("sandbox", "demo");
+        for (int i = 0; i < 3; ++i) {
+            WECHAT_TRACE_SCOPE("step", "demo");
+            spdlog::info("traced step {}", i);
+        }
+    }
+    wechat::log::stopTracing();
+    wechat::log::writeChromeTrace("logs/trace.json");
+
+    // 最近的日志与 span 也在飞行记录器里：flight_decode logs/flight.bin
+    wechat::log::dumpFlightRecorder("logs/flight.bin");
+
+    wechat::log::shutdown();
     return 0;
 }
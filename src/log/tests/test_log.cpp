@@ -0,0 +1,342 @@
+#include <gtest/gtest.h>
+
+#include <wechat/log/FlightRecorder.h>
+#include <wechat/log/Log.h>
+#include <wechat/log/RateLimit.h>
+
+#include <spdlog/common.h>
+#include <spdlog/sinks/ostream_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wechat::log;
+
+namespace {
+
+std::filesystem::path tempDump(const std::string& name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+std::string decodeFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    EXPECT_TRUE(decodeFlightDump(in, out));
+    return out.str();
+}
+
+std::size_t countLines(const std::string& text) {
+    std::size_t lines = 0;
+    for (char c : text) lines += c == '\n';
+    return lines;
+}
+
+/// 把默认 logger 临时换成写入内存的 logger
+class CapturedLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        previous = spdlog::default_logger();
+        auto sink = std::make_shared<spdlog::sinks::ostream_sink_st>(out);
+        sink->set_pattern("%l %v");
+        auto logger = std::make_shared<spdlog::logger>("test", sink);
+        logger->set_level(spdlog::level::info);
+        spdlog::set_default_logger(logger);
+    }
+    void TearDown() override { spdlog::set_default_logger(previous); }
+
+    std::ostringstream out;
+    std::shared_ptr<spdlog::logger> previous;
+};
+
+/// 在临时目录上 init 异步 logger，结束时恢复原来的默认 logger
+class AsyncLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        previous = spdlog::default_logger();
+        directory = std::filesystem::temp_directory_path() /
+                    ::testing::UnitTest::GetInstance()
+                        ->current_test_info()
+                        ->name();
+        std::filesystem::remove_all(directory);
+    }
+    void TearDown() override {
+        spdlog::set_default_logger(previous);
+        std::filesystem::remove_all(directory);
+    }
+
+    void start(OverflowPolicy overflow, std::size_t queueSize) {
+        LogOptions options;
+        options.directory = directory;
+        options.queueSize = queueSize;
+        options.overflow = overflow;
+        options.flushInterval = std::chrono::seconds(60);
+        options.crashHandler = false;
+        options.console = false;
+        init(options);
+    }
+
+    /// shutdown 之后写到日志文件里的行数
+    std::size_t writtenLines() const {
+        std::size_t lines = 0;
+        for (auto& entry : std::filesystem::directory_iterator(directory)) {
+            std::ifstream in(entry.path(), std::ios::binary);
+            std::ostringstream text;
+            text << in.rdbuf();
+            lines += countLines(text.str());
+        }
+        return lines;
+    }
+
+    std::filesystem::path directory;
+    std::shared_ptr<spdlog::logger> previous;
+};
+
+} // namespace
+
+TEST_F(AsyncLogTest, DropOldestCountsDropsWithoutBlocking) {
+    // 队列只有 2 条，一次写入远超后台线程的处理速度
+    start(OverflowPolicy::DropOldest, 2);
+    constexpr std::size_t Total = 20000;
+    for (std::size_t i = 0; i < Total; ++i) spdlog::info("message {}", i);
+    auto dropped = droppedCount();
+    shutdown();
+
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(writtenLines() + dropped, Total);
+}
+
+TEST_F(AsyncLogTest, BlockLosesNothing) {
+    start(OverflowPolicy::Block, 2);
+    constexpr std::size_t Total = 20000;
+    for (std::size_t i = 0; i < Total; ++i) spdlog::info("message {}", i);
+    EXPECT_EQ(droppedCount(), 0u);
+    shutdown();
+
+    EXPECT_EQ(writtenLines(), Total);
+}
+
+TEST_F(AsyncLogTest, ShutdownDrainsQueue) {
+    // 队列足够大，全部入队后立即 shutdown，期间没有任何 flush
+    constexpr std::size_t Total = 5000;
+    start(OverflowPolicy::DropOldest, Total);
+    for (std::size_t i = 0; i < Total; ++i) spdlog::info("message {}", i);
+    shutdown();
+
+    EXPECT_EQ(droppedCount(), 0u);
+    EXPECT_EQ(writtenLines(), Total);
+}
+
+TEST(RateLimiterTest, AllowsLimitPerSecondAndReportsSuppressed) {
+    RateLimiter limiter(3);
+    int passed = 0;
+    for (int i = 0; i < 10; ++i) passed += limiter.tryAcquireAt(100).has_value();
+    EXPECT_EQ(passed, 3);
+
+    auto next = limiter.tryAcquireAt(101);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next, 7u);
+    EXPECT_EQ(limiter.tryAcquireAt(101), std::optional<uint64_t>(0));
+}
+
+TEST(LogSamplerTest, PassesOneInKWithSkippedCount) {
+    LogSampler sampler(4);
+    std::vector<uint64_t> passed;
+    for (int i = 0; i < 10; ++i)
+        if (auto skipped = sampler.tryAcquire()) passed.push_back(*skipped);
+    EXPECT_EQ(passed, (std::vector<uint64_t>{0, 3, 3}));
+}
+
+TEST_F(CapturedLogTest, SampledMacroAppendsSummary) {
+    auto& logger = *spdlog::default_logger_raw();
+    for (int i = 0; i < 25; ++i)
+        WECHAT_LOG_SAMPLED(logger, spdlog::level::info, 10, "tick {}", i);
+    // 未开启的级别不输出
+    for (int i = 0; i < 25; ++i)
+        WECHAT_LOG_SAMPLED(logger, spdlog::level::debug, 10, "hidden {}", i);
+
+    auto text = out.str();
+    EXPECT_EQ(countLines(text), 3u);
+    EXPECT_NE(text.find("info tick 0\n"), std::string::npos);
+    EXPECT_NE(text.find("info tick 10 (9 similar suppressed)\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("info tick 20 (9 similar suppressed)\n"),
+              std::string::npos);
+    EXPECT_EQ(text.find("hidden"), std::string::npos);
+}
+
+TEST_F(CapturedLogTest, RateLimitedMacroCapsBurst) {
+    auto& logger = *spdlog::default_logger_raw();
+    for (int i = 0; i < 1000; ++i)
+        WECHAT_LOG_RATE_LIMITED(logger, spdlog::level::warn, 5, "burst {}", i);
+    // 跨秒时最多再放行一个窗口
+    EXPECT_GE(countLines(out.str()), 5u);
+    EXPECT_LE(countLines(out.str()), 10u);
+}
+
+TEST_F(CapturedLogTest, ModuleLoggersPrefixAndFollowRuntimeLevels) {
+    auto& net = moduleLogger("test.net");
+    EXPECT_EQ(&net, &moduleLogger("test.net"));
+    EXPECT_EQ(net.level(), spdlog::level::info); // 继承默认级别
+
+    net.info("connected");
+    net.debug("hidden");
+    EXPECT_TRUE(applyLevels("test.net=debug,test.db=error"));
+    net.debug("handshake {}", 2);
+
+    auto& db = moduleLogger("test.db"); // 创建前设置的级别生效
+    db.warn("hidden");
+    db.error("disk full");
+
+    auto text = out.str();
+    EXPECT_NE(text.find("info [test.net] connected\n"), std::string::npos);
+    EXPECT_NE(text.find("debug [test.net] handshake 2\n"), std::string::npos);
+    EXPECT_NE(text.find("error [test.db] disk full\n"), std::string::npos);
+    EXPECT_EQ(text.find("hidden"), std::string::npos);
+
+    // "*" 只影响未单独设置过的模块
+    auto& ui = moduleLogger("test.ui");
+    setLevel("*", spdlog::level::warn);
+    EXPECT_EQ(ui.level(), spdlog::level::warn);
+    EXPECT_EQ(net.level(), spdlog::level::debug);
+    EXPECT_EQ(spdlog::default_logger_raw()->level(), spdlog::level::warn);
+
+    EXPECT_FALSE(applyLevels("test.ui=loud,=info,test.ui2=trace"));
+    EXPECT_EQ(ui.level(), spdlog::level::warn);
+    EXPECT_EQ(moduleLogger("test.ui2").level(), spdlog::level::trace);
+}
+
+TEST(FlightRecorderTest, DumpDecodesLogsAndSpansInOrder) {
+    recordFlightLog(spdlog::level::info, "flight first");
+    recordFlightSpan("storage", "MessageDao::insert", 12'345);
+    recordFlightLog(spdlog::level::err, "flight last");
+
+    auto path = tempDump("wechat_flight_order.bin");
+    ASSERT_TRUE(dumpFlightRecorder(path));
+    auto text = decodeFile(path);
+    std::filesystem::remove(path);
+
+    auto first = text.find("[info] [t");
+    auto span = text.find("[span] [t");
+    auto last = text.find("[error] [t");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(span, std::string::npos);
+    ASSERT_NE(last, std::string::npos);
+    EXPECT_LT(text.find("flight first"),
+              text.find("storage/MessageDao::insert 12.345us"));
+    EXPECT_LT(text.find("MessageDao::insert"), text.find("flight last"));
+}
+
+TEST(FlightRecorderTest, KeepsOnlyTheNewestRecordsAndTruncatesText) {
+    for (std::size_t i = 0; i < FlightRecorderCapacity + 100; ++i)
+        recordFlightLog(spdlog::level::debug, "wrap " + std::to_string(i));
+    recordFlightLog(spdlog::level::warn, std::string(1000, 'x'));
+
+    auto path = tempDump("wechat_flight_wrap.bin");
+    ASSERT_TRUE(dumpFlightRecorder(path));
+    auto text = decodeFile(path);
+    std::filesystem::remove(path);
+
+    std::size_t lines = 0;
+    for (char c : text) lines += c == '\n';
+    EXPECT_EQ(lines, FlightRecorderCapacity);
+    EXPECT_EQ(text.find("wrap 100\n"), std::string::npos); // 已被覆盖
+    EXPECT_NE(text.find("wrap 101\n"), std::string::npos);
+    EXPECT_NE(text.find("wrap " + std::to_string(FlightRecorderCapacity + 99)),
+              std::string::npos);
+    EXPECT_EQ(text.find(std::string(225, 'x')), std::string::npos);
+    EXPECT_NE(text.find(std::string(224, 'x') + "\n"), std::string::npos);
+}
+
+TEST(FlightRecorderTest, DumpWhileWritingSkipsTornRecords) {
+    // 每条记录是同一个字母重复 200 次，被撕裂的记录会混入别的字母
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; !stop; ++i)
+                recordFlightLog(spdlog::level::info,
+                                std::string(200, static_cast<char>(
+                                                     'a' + (t * 7 + i) % 26)));
+        });
+    }
+
+    auto path = tempDump("wechat_flight_concurrent.bin");
+    std::size_t checked = 0;
+    for (int round = 0; round < 20; ++round) {
+        ASSERT_TRUE(dumpFlightRecorder(path));
+        std::istringstream lines(decodeFile(path));
+        for (std::string line; std::getline(lines, line);) {
+            auto text = line.substr(line.rfind(' ') + 1);
+            if (text.size() != 200) continue; // 其他用例留下的记录
+            EXPECT_EQ(text, std::string(200, text[0])) << line;
+            ++checked;
+        }
+    }
+    stop = true;
+    for (auto& w : writers) w.join();
+    std::filesystem::remove(path);
+    EXPECT_GT(checked, 0u);
+}
+
+TEST(FlightRecorderTest, RejectsForeignFiles) {
+    std::istringstream garbage("definitely not a dump");
+    std::ostringstream out;
+    EXPECT_FALSE(decodeFlightDump(garbage, out));
+}
+
+TEST(FlightRecorderTest, RejectsCorruptCapacityAndLength) {
+    recordFlightLog(spdlog::level::info, "flight corrupt");
+    auto path = tempDump("wechat_flight_corrupt.bin");
+    ASSERT_TRUE(dumpFlightRecorder(path));
+    std::string dump;
+    {
+        std::ifstream in(path, std::ios::binary);
+        dump.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    std::filesystem::remove(path);
+
+    auto decodes = [](std::string const& bytes) {
+        std::istringstream in(bytes);
+        std::ostringstream out;
+        return decodeFlightDump(in, out);
+    };
+    ASSERT_TRUE(decodes(dump));
+
+    // 头部偏移 16 处是 uint32 capacity
+    for (uint32_t capacity : {0u, 3u, 0x40000000u, 0xFFFFFFFFu,
+                              uint32_t(FlightRecorderCapacity * 2)}) {
+        auto patched = dump;
+        std::memcpy(patched.data() + 16, &capacity, sizeof(capacity));
+        EXPECT_FALSE(decodes(patched)) << capacity;
+    }
+    EXPECT_FALSE(decodes(dump.substr(0, dump.size() - 1)));
+    EXPECT_FALSE(decodes(dump + "x"));
+}
+
+TEST(FlightRecorderDeathTest, CrashHandlerWritesDump) {
+    auto path = tempDump("wechat_flight_crash.bin");
+    std::filesystem::remove(path);
+    EXPECT_DEATH(
+        {
+            installCrashHandler(path);
+            recordFlightLog(spdlog::level::critical, "about to crash");
+            std::abort();
+        },
+        "");
+    ASSERT_TRUE(std::filesystem::exists(path));
+    auto text = decodeFile(path);
+    std::filesystem::remove(path);
+    EXPECT_NE(text.find("[critical]"), std::string::npos);
+    EXPECT_NE(text.find("about to crash"), std::string::npos);
+}
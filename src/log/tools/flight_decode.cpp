@@ -0,0 +1,26 @@
+// 把飞行记录器的二进制转储还原为文本
+//
+// 用法: flight_decode logs/flight.bin [> flight.txt]
+
+#include <wechat/log/FlightRecorder.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <flight.bin>\n", argv[0]);
+        return 2;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    if (!wechat::log::decodeFlightDump(in, std::cout)) {
+        std::fprintf(stderr, "%s is not a flight recorder dump\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
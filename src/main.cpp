@@ -18,5 +18,7 @@ int main(int argc, char *argv[]) {
     auto w = new QWidget;
 
     w->show();
-    return app.exec();
+    auto code = app.exec();
+    wechat::log::shutdown();
+    return code;
 }
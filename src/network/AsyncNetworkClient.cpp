@@ -0,0 +1,237 @@
+#include <wechat/network/AsyncNetworkClient.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace wechat::network {
+
+namespace {
+
+/// 切换到线程池后执行阻塞调用；call 连同捕获的参数保存在协程帧中
+template <typename F>
+core::Task<std::invoke_result_t<F&>> onExecutor(core::Executor& executor,
+                                                F call) {
+    // 用户在等待这些请求，排在后台维护任务之前
+    co_await core::resumeOn(executor, core::TaskPriority::High);
+    co_return call();
+}
+
+} // namespace
+
+// ── Auth ──
+
+core::Task<Result<LoginResponse>> AsyncAuthService::registerUser(
+    std::string username, std::string password) {
+    return onExecutor(executor, [&service = service,
+                                 username = std::move(username),
+                                 password = std::move(password)] {
+        return service.registerUser(username, password);
+    });
+}
+
+core::Task<Result<LoginResponse>> AsyncAuthService::login(
+    std::string username, std::string password) {
+    return onExecutor(executor, [&service = service,
+                                 username = std::move(username),
+                                 password = std::move(password)] {
+        return service.login(username, password);
+    });
+}
+
+core::Task<VoidResult> AsyncAuthService::logout(std::string token) {
+    return onExecutor(executor,
+                      [&service = service, token = std::move(token)] {
+                          return service.logout(token);
+                      });
+}
+
+core::Task<Result<core::User>> AsyncAuthService::getCurrentUser(
+    std::string token) {
+    return onExecutor(executor,
+                      [&service = service, token = std::move(token)] {
+                          return service.getCurrentUser(token);
+                      });
+}
+
+// ── Chat ──
+
+core::Task<Result<core::MessagePtr>> AsyncChatService::sendMessage(
+    std::string token, std::string chatId, std::string replyTo,
+    core::MessageContent content) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 chatId = std::move(chatId),
+                                 replyTo = std::move(replyTo),
+                                 content = std::move(content)] {
+        return service.sendMessage(token, chatId, replyTo, content);
+    });
+}
+
+core::Task<Result<SyncMessagesResponse>> AsyncChatService::syncMessages(
+    std::string token, std::string chatId, int64_t sinceTs, int limit) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 chatId = std::move(chatId), sinceTs, limit] {
+        return service.syncMessages(token, chatId, sinceTs, limit);
+    });
+}
+
+core::Task<VoidResult> AsyncChatService::revokeMessage(std::string token,
+                                                       std::string messageId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 messageId = std::move(messageId)] {
+        return service.revokeMessage(token, messageId);
+    });
+}
+
+core::Task<VoidResult> AsyncChatService::editMessage(
+    std::string token, std::string messageId, core::MessageContent newContent) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 messageId = std::move(messageId),
+                                 newContent = std::move(newContent)] {
+        return service.editMessage(token, messageId, newContent);
+    });
+}
+
+core::Task<VoidResult> AsyncChatService::markRead(std::string token,
+                                                  std::string chatId,
+                                                  std::string lastMessageId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 chatId = std::move(chatId),
+                                 lastMessageId = std::move(lastMessageId)] {
+        return service.markRead(token, chatId, lastMessageId);
+    });
+}
+
+// ── Contacts ──
+
+core::Task<VoidResult> AsyncContactService::addFriend(
+    std::string token, std::string targetUserId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 targetUserId = std::move(targetUserId)] {
+        return service.addFriend(token, targetUserId);
+    });
+}
+
+core::Task<VoidResult> AsyncContactService::removeFriend(
+    std::string token, std::string targetUserId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 targetUserId = std::move(targetUserId)] {
+        return service.removeFriend(token, targetUserId);
+    });
+}
+
+core::Task<Result<std::vector<core::User>>> AsyncContactService::listFriends(
+    std::string token) {
+    return onExecutor(executor,
+                      [&service = service, token = std::move(token)] {
+                          return service.listFriends(token);
+                      });
+}
+
+core::Task<Result<std::vector<core::User>>> AsyncContactService::searchUser(
+    std::string token, std::string keyword, int offset, int limit) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 keyword = std::move(keyword), offset, limit] {
+        return service.searchUser(token, keyword, offset, limit);
+    });
+}
+
+// ── Groups ──
+
+core::Task<Result<core::Group>> AsyncGroupService::createGroup(
+    std::string token, std::vector<std::string> memberIds) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 memberIds = std::move(memberIds)] {
+        return service.createGroup(token, memberIds);
+    });
+}
+
+core::Task<VoidResult> AsyncGroupService::dissolveGroup(std::string token,
+                                                        std::string groupId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 groupId = std::move(groupId)] {
+        return service.dissolveGroup(token, groupId);
+    });
+}
+
+core::Task<VoidResult> AsyncGroupService::addMember(std::string token,
+                                                    std::string groupId,
+                                                    std::string userId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 groupId = std::move(groupId),
+                                 userId = std::move(userId)] {
+        return service.addMember(token, groupId, userId);
+    });
+}
+
+core::Task<VoidResult> AsyncGroupService::removeMember(std::string token,
+                                                       std::string groupId,
+                                                       std::string userId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 groupId = std::move(groupId),
+                                 userId = std::move(userId)] {
+        return service.removeMember(token, groupId, userId);
+    });
+}
+
+core::Task<Result<std::vector<std::string>>> AsyncGroupService::listMembers(
+    std::string token, std::string groupId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 groupId = std::move(groupId)] {
+        return service.listMembers(token, groupId);
+    });
+}
+
+core::Task<Result<std::vector<core::Group>>> AsyncGroupService::listMyGroups(
+    std::string token) {
+    return onExecutor(executor,
+                      [&service = service, token = std::move(token)] {
+                          return service.listMyGroups(token);
+                      });
+}
+
+// ── Moments ──
+
+core::Task<Result<Moment>> AsyncMomentService::postMoment(
+    std::string token, std::string text, std::vector<std::string> imageIds) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 text = std::move(text),
+                                 imageIds = std::move(imageIds)] {
+        return service.postMoment(token, text, imageIds);
+    });
+}
+
+core::Task<Result<std::vector<Moment>>> AsyncMomentService::listMoments(
+    std::string token, int64_t beforeTs, int limit) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 beforeTs, limit] {
+        return service.listMoments(token, beforeTs, limit);
+    });
+}
+
+core::Task<VoidResult> AsyncMomentService::likeMoment(std::string token,
+                                                      std::string momentId) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 momentId = std::move(momentId)] {
+        return service.likeMoment(token, momentId);
+    });
+}
+
+core::Task<Result<Moment::Comment>> AsyncMomentService::commentMoment(
+    std::string token, std::string momentId, std::string text) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 momentId = std::move(momentId),
+                                 text = std::move(text)] {
+        return service.commentMoment(token, momentId, text);
+    });
+}
+
+core::Task<Result<ListCommentsResponse>> AsyncMomentService::listComments(
+    std::string token, std::string momentId, int64_t afterTs, int limit) {
+    return onExecutor(executor, [&service = service, token = std::move(token),
+                                 momentId = std::move(momentId), afterTs,
+                                 limit] {
+        return service.listComments(token, momentId, afterTs, limit);
+    });
+}
+
+} // namespace wechat::network
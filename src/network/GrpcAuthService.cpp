@@ -1,44 +1,69 @@
 #include "GrpcAuthService.h"
-#include <wechat/network/NetworkTypes.h>
-
-// #include "auth.grpc.pb.h"
-// #include "auth.pb.h"
-
-// #include <grpcpp/support/status.h>
 
 namespace wechat {
 namespace network {
 
-// namespace proto = wechat::auth;
+namespace proto = wechat::auth;
 
-GrpcAuthService::GrpcAuthService(const std::string& serverAddress)
-    : channel(nullptr) {
-    // TODO: 当后端就绪时启用 gRPC
-    // channel = grpc::CreateChannel(serverAddress,
-    //                               grpc::InsecureChannelCredentials());
-}
+GrpcAuthService::GrpcAuthService(std::shared_ptr<grpc::Channel> channel,
+                                 GrpcChannelOptions options)
+    : stub(proto::AuthService::NewStub(channel)), options(options) {}
 
 Result<LoginResponse> GrpcAuthService::registerUser(
     const std::string& username, const std::string& password) {
-    // TODO: 实现真实的 gRPC 调用
-    return {ErrorCode::Unavailable,
-            "gRPC backend not available yet - use MockNetworkClient"};
+    proto::RegisterRequest request;
+    request.set_username(username);
+    request.set_password(password);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::RegisterResponse response;
+    auto status = stub->Register(&context, request, &response);
+    if (!status.ok()) return toError(status);
+
+    return LoginResponse{std::move(*response.mutable_user_id()),
+                         std::move(*response.mutable_token())};
 }
 
 Result<LoginResponse> GrpcAuthService::login(
     const std::string& username, const std::string& password) {
-    return {ErrorCode::Unavailable,
-            "gRPC backend not available yet - use MockNetworkClient"};
+    proto::LoginRequest request;
+    request.set_username(username);
+    request.set_password(password);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::LoginResponse response;
+    auto status = stub->Login(&context, request, &response);
+    if (!status.ok()) return toError(status);
+
+    return LoginResponse{std::move(*response.mutable_user_id()),
+                         std::move(*response.mutable_token())};
 }
 
 VoidResult GrpcAuthService::logout(const std::string& token) {
-    return {ErrorCode::Unavailable,
-            "gRPC backend not available yet - use MockNetworkClient"};
+    proto::LogoutRequest request;
+    request.set_token(token);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::LogoutResponse response;
+    auto status = stub->Logout(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
 }
 
 Result<core::User> GrpcAuthService::getCurrentUser(const std::string& token) {
-    return {ErrorCode::Unavailable,
-            "gRPC backend not available yet - use MockNetworkClient"};
+    proto::GetCurrentUserRequest request;
+    request.set_token(token);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::GetCurrentUserResponse response;
+    auto status = stub->GetCurrentUser(&context, request, &response);
+    if (!status.ok()) return toError(status);
+
+    return core::User{core::Id(response.user_id())};
 }
 
 } // namespace network
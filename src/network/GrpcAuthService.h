@@ -1,18 +1,24 @@
 #pragma once
 
-#include <grpcpp/grpcpp.h>
 #include <wechat/network/AuthService.h>
+
+#include "GrpcChannel.h"
+#include "auth.grpc.pb.h"
+
 #include <memory>
 #include <string>
-#include "auth.pb.h"
-#include "auth.grpc.pb.h"
-using namespace wechat::auth;
+
 namespace wechat {
 namespace network {
 
+/// 基于 proto/auth.proto 的 AuthService 客户端
+///
+/// 通过共享的 channel 调用，每次调用按 options.deadline 设置截止时间；
+/// 失败时 gRPC 状态码按 toError 转成 ErrorCode。
 class GrpcAuthService : public AuthService {
 public:
-    explicit GrpcAuthService(const std::string& serverAddress);
+    GrpcAuthService(std::shared_ptr<grpc::Channel> channel,
+                    GrpcChannelOptions options = {});
 
     Result<LoginResponse> registerUser(
         const std::string& username,
@@ -27,7 +33,8 @@ public:
     Result<core::User> getCurrentUser(const std::string& token) override;
 
 private:
-    std::unique_ptr<grpc::Channel> channel;
+    std::unique_ptr<wechat::auth::AuthService::Stub> stub;
+    GrpcChannelOptions options;
 };
 
 } // namespace network
@@ -0,0 +1,70 @@
+#include "GrpcChannel.h"
+
+namespace wechat::network {
+
+grpc::ChannelArguments channelArguments(const GrpcChannelOptions& options) {
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS,
+                static_cast<int>(options.keepaliveTime.count()));
+    args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS,
+                static_cast<int>(options.keepaliveTimeout.count()));
+    if (options.keepaliveWithoutCalls) {
+        args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+        args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    }
+    return args;
+}
+
+std::shared_ptr<grpc::Channel> createGrpcChannel(
+    const std::string& address, const GrpcChannelOptions& options) {
+    return grpc::CreateCustomChannel(address,
+                                     grpc::InsecureChannelCredentials(),
+                                     channelArguments(options));
+}
+
+void prepareContext(grpc::ClientContext& context,
+                    const GrpcChannelOptions& options) {
+    context.set_deadline(std::chrono::system_clock::now() + options.deadline);
+}
+
+Error toError(const grpc::Status& status) {
+    auto code = [&] {
+        switch (status.error_code()) {
+        case grpc::StatusCode::OK: return ErrorCode::Ok;
+        case grpc::StatusCode::INVALID_ARGUMENT:
+        case grpc::StatusCode::OUT_OF_RANGE:
+            return ErrorCode::InvalidArgument;
+        case grpc::StatusCode::NOT_FOUND: return ErrorCode::NotFound;
+        case grpc::StatusCode::ALREADY_EXISTS: return ErrorCode::AlreadyExists;
+        case grpc::StatusCode::UNAUTHENTICATED: return ErrorCode::Unauthorized;
+        case grpc::StatusCode::PERMISSION_DENIED:
+            return ErrorCode::PermissionDenied;
+        case grpc::StatusCode::UNAVAILABLE: return ErrorCode::Unavailable;
+        case grpc::StatusCode::DEADLINE_EXCEEDED: return ErrorCode::Timeout;
+        default: return ErrorCode::Internal;
+        }
+    }();
+    return {code, status.error_message()};
+}
+
+grpc::Status toStatus(const Error& error) {
+    auto code = [&] {
+        switch (error.code) {
+        case ErrorCode::Ok: return grpc::StatusCode::OK;
+        case ErrorCode::InvalidArgument:
+            return grpc::StatusCode::INVALID_ARGUMENT;
+        case ErrorCode::NotFound: return grpc::StatusCode::NOT_FOUND;
+        case ErrorCode::AlreadyExists: return grpc::StatusCode::ALREADY_EXISTS;
+        case ErrorCode::Unauthorized: return grpc::StatusCode::UNAUTHENTICATED;
+        case ErrorCode::PermissionDenied:
+            return grpc::StatusCode::PERMISSION_DENIED;
+        case ErrorCode::Internal: return grpc::StatusCode::INTERNAL;
+        case ErrorCode::Unavailable: return grpc::StatusCode::UNAVAILABLE;
+        case ErrorCode::Timeout: return grpc::StatusCode::DEADLINE_EXCEEDED;
+        }
+        return grpc::StatusCode::UNKNOWN;
+    }();
+    return {code, error.message};
+}
+
+} // namespace wechat::network
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <wechat/network/NetworkTypes.h>
+
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace wechat::network {
+
+struct GrpcChannelOptions {
+    /// 单次调用的截止时间，超时返回 ErrorCode::Timeout
+    std::chrono::milliseconds deadline{5000};
+    /// 发送 keepalive ping 的间隔，及等待 ping 回应的时间。默认配置的
+    /// gRPC 服务端要求 ping 间隔至少 5 分钟，更频繁会被以 too_many_pings 断开
+    std::chrono::milliseconds keepaliveTime{300'000};
+    std::chrono::milliseconds keepaliveTimeout{20'000};
+    /// 没有进行中的调用时也发送 keepalive。默认服务端拒绝这类 ping，
+    /// 只有服务端显式放开（见 GrpcServerOptions）时才能打开
+    bool keepaliveWithoutCalls = false;
+};
+
+/// 客户端 channel 参数（keepalive 等）
+grpc::ChannelArguments channelArguments(const GrpcChannelOptions& options);
+
+/// 创建到 address 的明文 channel
+///
+/// channel 内部维护连接与重连，一个客户端的所有 Service 共用同一个，
+/// 不要每次调用重新创建。
+std::shared_ptr<grpc::Channel> createGrpcChannel(
+    const std::string& address, const GrpcChannelOptions& options = {});
+
+/// 为一次调用设置截止时间
+void prepareContext(grpc::ClientContext& context,
+                    const GrpcChannelOptions& options);
+
+/// gRPC 状态码与 ErrorCode 一一对应，服务端和客户端按同一张表转换
+Error toError(const grpc::Status& status);
+grpc::Status toStatus(const Error& error);
+
+} // namespace wechat::network
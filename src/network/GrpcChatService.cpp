@@ -0,0 +1,108 @@
+#include "GrpcChatService.h"
+
+#include <wechat/core/MessagePage.h>
+
+#include "GrpcConvert.h"
+
+namespace wechat::network {
+
+namespace proto = wechat::chat;
+using google::protobuf::Arena;
+
+GrpcChatService::GrpcChatService(std::shared_ptr<grpc::Channel> channel,
+                                 GrpcChannelOptions options)
+    : stub(proto::ChatService::NewStub(channel)), options(options) {}
+
+Result<core::MessagePtr> GrpcChatService::sendMessage(
+    const std::string& token, const std::string& chatId,
+    const std::string& replyTo, const core::MessageContent& content) {
+    // 内容块较多时请求 / 响应的子消息都分配在 arena 上，调用结束一次释放
+    Arena arena;
+    auto* request = Arena::CreateMessage<proto::SendMessageRequest>(&arena);
+    request->set_token(token);
+    request->set_chat_id(chatId);
+    request->set_reply_to(replyTo);
+    toProto(content, request->mutable_content());
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    auto* response = Arena::CreateMessage<proto::SendMessageResponse>(&arena);
+    auto status = stub->SendMessage(&context, *request, response);
+    if (!status.ok()) return toError(status);
+
+    return core::makeSnapshot(fromProto(response->message()));
+}
+
+Result<SyncMessagesResponse> GrpcChatService::syncMessages(
+    const std::string& token, const std::string& chatId, int64_t sinceTs,
+    int limit) {
+    Arena arena;
+    auto* request = Arena::CreateMessage<proto::SyncMessagesRequest>(&arena);
+    request->set_token(token);
+    request->set_chat_id(chatId);
+    request->set_since_ts(sinceTs);
+    request->set_limit(limit);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    auto* response = Arena::CreateMessage<proto::SyncMessagesResponse>(&arena);
+    auto status = stub->SyncMessages(&context, *request, response);
+    if (!status.ok()) return toError(status);
+
+    // 整页消息直接解码进同一个内存池，快照共享页的所有权
+    core::MessagePage page;
+    page.reserve(response->messages_size());
+    for (auto& message : response->messages())
+        page.add(fromProto(message, page.allocator()));
+    return SyncMessagesResponse{core::MessagePage::share(std::move(page)),
+                                response->has_more()};
+}
+
+VoidResult GrpcChatService::revokeMessage(const std::string& token,
+                                          const std::string& messageId) {
+    proto::RevokeMessageRequest request;
+    request.set_token(token);
+    request.set_message_id(messageId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::RevokeMessageResponse response;
+    auto status = stub->RevokeMessage(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+VoidResult GrpcChatService::editMessage(const std::string& token,
+                                        const std::string& messageId,
+                                        const core::MessageContent& newContent) {
+    Arena arena;
+    auto* request = Arena::CreateMessage<proto::EditMessageRequest>(&arena);
+    request->set_token(token);
+    request->set_message_id(messageId);
+    toProto(newContent, request->mutable_content());
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::EditMessageResponse response;
+    auto status = stub->EditMessage(&context, *request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+VoidResult GrpcChatService::markRead(const std::string& token,
+                                     const std::string& chatId,
+                                     const std::string& lastMessageId) {
+    proto::MarkReadRequest request;
+    request.set_token(token);
+    request.set_chat_id(chatId);
+    request.set_last_message_id(lastMessageId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::MarkReadResponse response;
+    auto status = stub->MarkRead(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+} // namespace wechat::network
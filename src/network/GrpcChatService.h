@@ -0,0 +1,39 @@
+#pragma once
+
+#include <wechat/network/ChatService.h>
+
+#include "GrpcChannel.h"
+#include "chat.grpc.pb.h"
+
+#include <memory>
+
+namespace wechat::network {
+
+/// 基于 proto/chat.proto 的 ChatService 客户端，调用约定同 GrpcAuthService
+class GrpcChatService : public ChatService {
+public:
+    GrpcChatService(std::shared_ptr<grpc::Channel> channel,
+                    GrpcChannelOptions options = {});
+
+    Result<core::MessagePtr> sendMessage(
+        const std::string& token, const std::string& chatId,
+        const std::string& replyTo,
+        const core::MessageContent& content) override;
+    Result<SyncMessagesResponse> syncMessages(
+        const std::string& token, const std::string& chatId,
+        int64_t sinceTs, int limit) override;
+    VoidResult revokeMessage(
+        const std::string& token, const std::string& messageId) override;
+    VoidResult editMessage(
+        const std::string& token, const std::string& messageId,
+        const core::MessageContent& newContent) override;
+    VoidResult markRead(
+        const std::string& token, const std::string& chatId,
+        const std::string& lastMessageId) override;
+
+private:
+    std::unique_ptr<wechat::chat::ChatService::Stub> stub;
+    GrpcChannelOptions options;
+};
+
+} // namespace wechat::network
@@ -0,0 +1,81 @@
+#include "GrpcContactService.h"
+
+namespace wechat::network {
+
+namespace proto = wechat::contacts;
+
+namespace {
+
+std::vector<core::User> usersFromProto(
+    const google::protobuf::RepeatedPtrField<proto::User>& users) {
+    std::vector<core::User> result;
+    result.reserve(users.size());
+    for (auto& user : users) result.push_back(core::User{core::Id(user.id())});
+    return result;
+}
+
+} // namespace
+
+GrpcContactService::GrpcContactService(std::shared_ptr<grpc::Channel> channel,
+                                       GrpcChannelOptions options)
+    : stub(proto::ContactService::NewStub(channel)), options(options) {}
+
+VoidResult GrpcContactService::addFriend(const std::string& token,
+                                         const std::string& targetUserId) {
+    proto::AddFriendRequest request;
+    request.set_token(token);
+    request.set_target_user_id(targetUserId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::AddFriendResponse response;
+    auto status = stub->AddFriend(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+VoidResult GrpcContactService::removeFriend(const std::string& token,
+                                            const std::string& targetUserId) {
+    proto::RemoveFriendRequest request;
+    request.set_token(token);
+    request.set_target_user_id(targetUserId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::RemoveFriendResponse response;
+    auto status = stub->RemoveFriend(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+Result<std::vector<core::User>> GrpcContactService::listFriends(
+    const std::string& token) {
+    proto::ListFriendsRequest request;
+    request.set_token(token);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::ListFriendsResponse response;
+    auto status = stub->ListFriends(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return usersFromProto(response.users());
+}
+
+Result<std::vector<core::User>> GrpcContactService::searchUser(
+    const std::string& token, const std::string& keyword, int offset,
+    int limit) {
+    proto::SearchUserRequest request;
+    request.set_token(token);
+    request.set_keyword(keyword);
+    request.set_offset(offset);
+    request.set_limit(limit);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::SearchUserResponse response;
+    auto status = stub->SearchUser(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return usersFromProto(response.users());
+}
+
+} // namespace wechat::network
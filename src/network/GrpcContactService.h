@@ -0,0 +1,35 @@
+#pragma once
+
+#include <wechat/network/ContactService.h>
+
+#include "GrpcChannel.h"
+#include "contacts.grpc.pb.h"
+
+#include <memory>
+
+namespace wechat::network {
+
+/// 基于 proto/contacts.proto 的 ContactService 客户端，调用约定同 GrpcAuthService
+class GrpcContactService : public ContactService {
+public:
+    GrpcContactService(std::shared_ptr<grpc::Channel> channel,
+                       GrpcChannelOptions options = {});
+
+    using ContactService::searchUser;
+
+    VoidResult addFriend(const std::string& token,
+                         const std::string& targetUserId) override;
+    VoidResult removeFriend(const std::string& token,
+                            const std::string& targetUserId) override;
+    Result<std::vector<core::User>> listFriends(
+        const std::string& token) override;
+    Result<std::vector<core::User>> searchUser(
+        const std::string& token, const std::string& keyword, int offset,
+        int limit) override;
+
+private:
+    std::unique_ptr<wechat::contacts::ContactService::Stub> stub;
+    GrpcChannelOptions options;
+};
+
+} // namespace wechat::network
@@ -0,0 +1,215 @@
+#include "GrpcConvert.h"
+
+#include <string_view>
+#include <vector>
+
+namespace wechat::network {
+
+namespace {
+
+// proto3 枚举是开放的，新版本服务端可能发来未知值
+core::ResourceType typeFromProto(chat::ResourceType type) {
+    auto value = static_cast<int>(type);
+    if (value < 0 || value > static_cast<int>(core::ResourceType::File))
+        return core::ResourceType::File;
+    return static_cast<core::ResourceType>(value);
+}
+
+core::ResourceSubtype subtypeFromProto(chat::ResourceSubtype subtype) {
+    auto value = static_cast<int>(subtype);
+    if (value < 0 || value > static_cast<int>(core::ResourceSubtype::Unknown))
+        return core::ResourceSubtype::Unknown;
+    return static_cast<core::ResourceSubtype>(value);
+}
+
+void mediaToProto(const core::MediaAttributes& media, chat::ResourceMeta* out) {
+    if (auto* image = std::get_if<core::ImageAttributes>(&media)) {
+        auto* proto = out->mutable_image();
+        proto->set_width(image->width);
+        proto->set_height(image->height);
+    } else if (auto* video = std::get_if<core::VideoAttributes>(&media)) {
+        auto* proto = out->mutable_video();
+        proto->set_width(video->width);
+        proto->set_height(video->height);
+        proto->set_duration(video->duration);
+    } else if (auto* audio = std::get_if<core::AudioAttributes>(&media)) {
+        out->mutable_audio()->set_duration(audio->duration);
+    }
+}
+
+core::MediaAttributes mediaFromProto(const chat::ResourceMeta& meta) {
+    switch (meta.media_case()) {
+    case chat::ResourceMeta::kImage:
+        return core::ImageAttributes{meta.image().width(),
+                                     meta.image().height()};
+    case chat::ResourceMeta::kVideo:
+        return core::VideoAttributes{meta.video().width(),
+                                     meta.video().height(),
+                                     meta.video().duration()};
+    case chat::ResourceMeta::kAudio:
+        return core::AudioAttributes{meta.audio().duration()};
+    default: return std::monostate{};
+    }
+}
+
+} // namespace
+
+// ── 消息 ──
+
+void toProto(const core::MessageContent& content, ProtoBlocks* out) {
+    out->Reserve(static_cast<int>(content.size()));
+    for (auto& block : content) {
+        auto* proto = out->Add();
+        if (auto* text = std::get_if<core::TextContent>(&block)) {
+            proto->set_text(text->text.data(), text->text.size());
+        } else if (auto* res = std::get_if<core::ResourceContent>(&block)) {
+            auto* resource = proto->mutable_resource();
+            resource->set_resource_id(res->resourceId.data(),
+                                      res->resourceId.size());
+            resource->set_type(static_cast<chat::ResourceType>(res->type));
+            resource->set_subtype(
+                static_cast<chat::ResourceSubtype>(res->subtype));
+
+            auto* meta = resource->mutable_meta();
+            meta->set_size(res->meta.size);
+            meta->set_filename(res->meta.filename.data(),
+                               res->meta.filename.size());
+            mediaToProto(res->meta.media, meta);
+            auto& extra = *meta->mutable_extra();
+            for (auto& [key, value] : res->meta.extra)
+                extra[std::string(key)].assign(value.data(), value.size());
+        }
+        // monostate：三个字段都不设置
+    }
+}
+
+core::MessageContent fromProto(const ProtoBlocks& blocks,
+                               std::pmr::polymorphic_allocator<> alloc) {
+    core::MessageContent content(alloc);
+    content.reserve(blocks.size());
+    for (auto& block : blocks) {
+        switch (block.block_case()) {
+        case chat::ContentBlock::kText:
+            content.emplace_back(std::in_place_type<core::TextContent>,
+                                 block.text(), alloc);
+            break;
+        case chat::ContentBlock::kResource: {
+            auto& resource = block.resource();
+            auto& meta = resource.meta();
+            core::ResourceExtra extra(alloc);
+            for (auto& [key, value] : meta.extra())
+                extra.emplace(std::string_view(key), std::string_view(value));
+            content.emplace_back(core::ResourceContent{
+                std::pmr::string(resource.resource_id(), alloc),
+                typeFromProto(resource.type()),
+                subtypeFromProto(resource.subtype()),
+                core::ResourceMeta{meta.size(),
+                                   std::pmr::string(meta.filename(), alloc),
+                                   mediaFromProto(meta), std::move(extra)}});
+            break;
+        }
+        default: content.emplace_back(std::monostate{});
+        }
+    }
+    return content;
+}
+
+void toProto(const core::Message& message, chat::ChatMessage* out) {
+    out->set_id(message.id.str());
+    out->set_sender_id(message.senderId.str());
+    out->set_chat_id(message.chatId.str());
+    out->set_reply_to(message.replyTo.str());
+    toProto(message.content, out->mutable_content());
+    out->set_timestamp(message.timestamp);
+    out->set_edited_at(message.editedAt);
+    out->set_revoked(message.revoked);
+    out->set_read_count(message.readCount);
+    out->set_updated_at(message.updatedAt);
+}
+
+core::Message fromProto(const chat::ChatMessage& message,
+                        std::pmr::polymorphic_allocator<> alloc) {
+    return core::Message{
+        .id = core::Id(message.id()),
+        .senderId = core::Id(message.sender_id()),
+        .chatId = core::Id(message.chat_id()),
+        .replyTo = core::Id(message.reply_to()),
+        .content = fromProto(message.content(), alloc),
+        .timestamp = message.timestamp(),
+        .editedAt = message.edited_at(),
+        .revoked = message.revoked(),
+        .readCount = message.read_count(),
+        .updatedAt = message.updated_at(),
+    };
+}
+
+// ── 群组 ──
+
+void toProto(const core::Group& group, groups::Group* out) {
+    out->set_id(group.id.str());
+    out->set_owner_id(group.ownerId.str());
+    out->mutable_member_ids()->Reserve(static_cast<int>(group.memberIds.size()));
+    for (auto& member : group.memberIds) out->add_member_ids(member.str());
+}
+
+core::Group fromProto(const groups::Group& group) {
+    std::vector<core::Id> members;
+    members.reserve(group.member_ids_size());
+    for (auto& member : group.member_ids()) members.emplace_back(member);
+    return core::Group{core::Id(group.id()), core::Id(group.owner_id()),
+                       core::IdSet(std::move(members))};
+}
+
+// ── 朋友圈 ──
+
+void toProto(Moment::Comment&& comment, moments::Comment* out) {
+    out->set_id(std::move(comment.id));
+    out->set_author_id(std::move(comment.authorId));
+    out->set_text(std::move(comment.text));
+    out->set_timestamp(comment.timestamp);
+}
+
+Moment::Comment fromProto(moments::Comment&& comment) {
+    return Moment::Comment{std::move(*comment.mutable_id()),
+                           std::move(*comment.mutable_author_id()),
+                           std::move(*comment.mutable_text()),
+                           comment.timestamp()};
+}
+
+void toProto(Moment&& moment, moments::Moment* out) {
+    out->set_id(std::move(moment.id));
+    out->set_author_id(std::move(moment.authorId));
+    out->set_text(std::move(moment.text));
+    out->mutable_image_ids()->Reserve(static_cast<int>(moment.imageIds.size()));
+    for (auto& image : moment.imageIds) out->add_image_ids(std::move(image));
+    out->set_timestamp(moment.timestamp);
+    out->set_like_count(moment.likeCount);
+    out->set_liked_by_me(moment.likedByMe);
+    out->set_comment_count(moment.commentCount);
+    out->mutable_comments()->Reserve(static_cast<int>(moment.comments.size()));
+    for (auto& comment : moment.comments)
+        toProto(std::move(comment), out->add_comments());
+}
+
+Moment fromProto(moments::Moment&& moment) {
+    Moment result{
+        .id = std::move(*moment.mutable_id()),
+        .authorId = std::move(*moment.mutable_author_id()),
+        .text = std::move(*moment.mutable_text()),
+        .imageIds = {},
+        .timestamp = moment.timestamp(),
+        .likeCount = moment.like_count(),
+        .likedByMe = moment.liked_by_me(),
+        .commentCount = moment.comment_count(),
+        .comments = {},
+    };
+    result.imageIds.reserve(moment.image_ids_size());
+    for (auto& image : *moment.mutable_image_ids())
+        result.imageIds.push_back(std::move(image));
+    result.comments.reserve(moment.comments_size());
+    for (auto& comment : *moment.mutable_comments())
+        result.comments.push_back(fromProto(std::move(comment)));
+    return result;
+}
+
+} // namespace wechat::network
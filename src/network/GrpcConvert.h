@@ -0,0 +1,46 @@
+#pragma once
+
+#include <wechat/core/Group.h>
+#include <wechat/core/Message.h>
+#include <wechat/network/MomentService.h>
+
+#include "chat.pb.h"
+#include "groups.pb.h"
+#include "moments.pb.h"
+
+#include <memory_resource>
+
+namespace wechat::network {
+
+// core / network 类型与 proto 之间的转换，客户端与 GrpcLocalServer 共用
+//
+// - 解码消息时内容直接构造在调用方给出的内存资源上（通常是 MessagePage
+//   的内存池），不经过默认堆中转
+// - 目标是 std::string 的字段（朋友圈等）从右值 proto 中移出字符串，不拷贝
+
+using ProtoBlocks = google::protobuf::RepeatedPtrField<chat::ContentBlock>;
+
+// ── 消息 ──
+
+void toProto(const core::MessageContent& content, ProtoBlocks* out);
+core::MessageContent fromProto(const ProtoBlocks& blocks,
+                               std::pmr::polymorphic_allocator<> alloc = {});
+
+void toProto(const core::Message& message, chat::ChatMessage* out);
+core::Message fromProto(const chat::ChatMessage& message,
+                        std::pmr::polymorphic_allocator<> alloc = {});
+
+// ── 群组 ──
+
+void toProto(const core::Group& group, groups::Group* out);
+core::Group fromProto(const groups::Group& group);
+
+// ── 朋友圈 ──
+
+void toProto(Moment&& moment, moments::Moment* out);
+Moment fromProto(moments::Moment&& moment);
+
+void toProto(Moment::Comment&& comment, moments::Comment* out);
+Moment::Comment fromProto(moments::Comment&& comment);
+
+} // namespace wechat::network
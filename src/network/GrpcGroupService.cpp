@@ -0,0 +1,110 @@
+#include "GrpcGroupService.h"
+
+#include "GrpcConvert.h"
+
+namespace wechat::network {
+
+namespace proto = wechat::groups;
+
+GrpcGroupService::GrpcGroupService(std::shared_ptr<grpc::Channel> channel,
+                                   GrpcChannelOptions options)
+    : stub(proto::GroupService::NewStub(channel)), options(options) {}
+
+Result<core::Group> GrpcGroupService::createGroup(
+    const std::string& token, const std::vector<std::string>& memberIds) {
+    proto::CreateGroupRequest request;
+    request.set_token(token);
+    request.mutable_member_ids()->Reserve(static_cast<int>(memberIds.size()));
+    for (auto& member : memberIds) request.add_member_ids(member);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::CreateGroupResponse response;
+    auto status = stub->CreateGroup(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return fromProto(response.group());
+}
+
+VoidResult GrpcGroupService::dissolveGroup(const std::string& token,
+                                           const std::string& groupId) {
+    proto::DissolveGroupRequest request;
+    request.set_token(token);
+    request.set_group_id(groupId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::DissolveGroupResponse response;
+    auto status = stub->DissolveGroup(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+VoidResult GrpcGroupService::addMember(const std::string& token,
+                                       const std::string& groupId,
+                                       const std::string& userId) {
+    proto::AddMemberRequest request;
+    request.set_token(token);
+    request.set_group_id(groupId);
+    request.set_user_id(userId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::AddMemberResponse response;
+    auto status = stub->AddMember(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+VoidResult GrpcGroupService::removeMember(const std::string& token,
+                                          const std::string& groupId,
+                                          const std::string& userId) {
+    proto::RemoveMemberRequest request;
+    request.set_token(token);
+    request.set_group_id(groupId);
+    request.set_user_id(userId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::RemoveMemberResponse response;
+    auto status = stub->RemoveMember(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+Result<std::vector<std::string>> GrpcGroupService::listMembers(
+    const std::string& token, const std::string& groupId) {
+    proto::ListMembersRequest request;
+    request.set_token(token);
+    request.set_group_id(groupId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::ListMembersResponse response;
+    auto status = stub->ListMembers(&context, request, &response);
+    if (!status.ok()) return toError(status);
+
+    std::vector<std::string> members;
+    members.reserve(response.member_ids_size());
+    for (auto& member : *response.mutable_member_ids())
+        members.push_back(std::move(member));
+    return members;
+}
+
+Result<std::vector<core::Group>> GrpcGroupService::listMyGroups(
+    const std::string& token) {
+    proto::ListMyGroupsRequest request;
+    request.set_token(token);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::ListMyGroupsResponse response;
+    auto status = stub->ListMyGroups(&context, request, &response);
+    if (!status.ok()) return toError(status);
+
+    std::vector<core::Group> groups;
+    groups.reserve(response.groups_size());
+    for (auto& group : response.groups()) groups.push_back(fromProto(group));
+    return groups;
+}
+
+} // namespace wechat::network
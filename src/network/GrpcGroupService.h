@@ -0,0 +1,38 @@
+#pragma once
+
+#include <wechat/network/GroupService.h>
+
+#include "GrpcChannel.h"
+#include "groups.grpc.pb.h"
+
+#include <memory>
+
+namespace wechat::network {
+
+/// 基于 proto/groups.proto 的 GroupService 客户端，调用约定同 GrpcAuthService
+class GrpcGroupService : public GroupService {
+public:
+    GrpcGroupService(std::shared_ptr<grpc::Channel> channel,
+                     GrpcChannelOptions options = {});
+
+    Result<core::Group> createGroup(
+        const std::string& token,
+        const std::vector<std::string>& memberIds) override;
+    VoidResult dissolveGroup(const std::string& token,
+                             const std::string& groupId) override;
+    VoidResult addMember(const std::string& token, const std::string& groupId,
+                         const std::string& userId) override;
+    VoidResult removeMember(const std::string& token,
+                            const std::string& groupId,
+                            const std::string& userId) override;
+    Result<std::vector<std::string>> listMembers(
+        const std::string& token, const std::string& groupId) override;
+    Result<std::vector<core::Group>> listMyGroups(
+        const std::string& token) override;
+
+private:
+    std::unique_ptr<wechat::groups::GroupService::Stub> stub;
+    GrpcChannelOptions options;
+};
+
+} // namespace wechat::network
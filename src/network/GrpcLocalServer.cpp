@@ -0,0 +1,369 @@
+#include "GrpcLocalServer.h"
+
+#include "GrpcConvert.h"
+#include "MockAuthService.h"
+#include "MockChatService.h"
+#include "MockContactService.h"
+#include "MockGroupService.h"
+#include "MockMomentService.h"
+#include "auth.grpc.pb.h"
+#include "chat.grpc.pb.h"
+#include "contacts.grpc.pb.h"
+#include "groups.grpc.pb.h"
+#include "moments.grpc.pb.h"
+
+#include <spdlog/spdlog.h>
+
+namespace wechat::network {
+
+namespace {
+
+// 以下 *Handler 是各 proto 服务的服务端实现，转调同一 MockDataStore 上的
+// Mock 服务；结果中的字符串尽量移入响应，不再拷贝
+
+/// auth.proto 的服务端实现
+class AuthHandler final : public auth::AuthService::Service {
+public:
+    explicit AuthHandler(std::shared_ptr<MockDataStore> store)
+        : service(std::move(store)) {}
+
+    grpc::Status Register(grpc::ServerContext*,
+                          const auth::RegisterRequest* request,
+                          auth::RegisterResponse* response) override {
+        auto result =
+            service.registerUser(request->username(), request->password());
+        if (!result.ok()) return toStatus(result.error());
+        response->set_user_id(std::move(result.value().userId));
+        response->set_token(std::move(result.value().token));
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Login(grpc::ServerContext*,
+                       const auth::LoginRequest* request,
+                       auth::LoginResponse* response) override {
+        auto result = service.login(request->username(), request->password());
+        if (!result.ok()) return toStatus(result.error());
+        response->set_user_id(std::move(result.value().userId));
+        response->set_token(std::move(result.value().token));
+        return grpc::Status::OK;
+    }
+
+    grpc::Status Logout(grpc::ServerContext*,
+                        const auth::LogoutRequest* request,
+                        auth::LogoutResponse*) override {
+        auto result = service.logout(request->token());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status GetCurrentUser(grpc::ServerContext*,
+                                const auth::GetCurrentUserRequest* request,
+                                auth::GetCurrentUserResponse* response)
+        override {
+        auto result = service.getCurrentUser(request->token());
+        if (!result.ok()) return toStatus(result.error());
+        response->set_user_id(result.value().id.str());
+        return grpc::Status::OK;
+    }
+
+private:
+    MockAuthService service;
+};
+
+/// chat.proto 的服务端实现
+class ChatHandler final : public chat::ChatService::Service {
+public:
+    explicit ChatHandler(std::shared_ptr<MockDataStore> store)
+        : service(std::move(store)) {}
+
+    grpc::Status SendMessage(grpc::ServerContext*,
+                             const chat::SendMessageRequest* request,
+                             chat::SendMessageResponse* response) override {
+        auto result =
+            service.sendMessage(request->token(), request->chat_id(),
+                                request->reply_to(),
+                                fromProto(request->content()));
+        if (!result.ok()) return toStatus(result.error());
+        toProto(*result.value(), response->mutable_message());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SyncMessages(grpc::ServerContext*,
+                              const chat::SyncMessagesRequest* request,
+                              chat::SyncMessagesResponse* response) override {
+        auto result = service.syncMessages(request->token(), request->chat_id(),
+                                           request->since_ts(),
+                                           request->limit());
+        if (!result.ok()) return toStatus(result.error());
+        auto& messages = result.value().messages;
+        response->mutable_messages()->Reserve(static_cast<int>(messages.size()));
+        for (auto& message : messages)
+            toProto(*message, response->add_messages());
+        response->set_has_more(result.value().hasMore);
+        return grpc::Status::OK;
+    }
+
+    grpc::Status RevokeMessage(grpc::ServerContext*,
+                               const chat::RevokeMessageRequest* request,
+                               chat::RevokeMessageResponse*) override {
+        auto result =
+            service.revokeMessage(request->token(), request->message_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status EditMessage(grpc::ServerContext*,
+                             const chat::EditMessageRequest* request,
+                             chat::EditMessageResponse*) override {
+        auto result = service.editMessage(request->token(),
+                                          request->message_id(),
+                                          fromProto(request->content()));
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status MarkRead(grpc::ServerContext*,
+                          const chat::MarkReadRequest* request,
+                          chat::MarkReadResponse*) override {
+        auto result = service.markRead(request->token(), request->chat_id(),
+                                       request->last_message_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+private:
+    MockChatService service;
+};
+
+/// contacts.proto 的服务端实现
+class ContactHandler final : public contacts::ContactService::Service {
+public:
+    explicit ContactHandler(std::shared_ptr<MockDataStore> store)
+        : service(std::move(store)) {}
+
+    grpc::Status AddFriend(grpc::ServerContext*,
+                           const contacts::AddFriendRequest* request,
+                           contacts::AddFriendResponse*) override {
+        auto result =
+            service.addFriend(request->token(), request->target_user_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status RemoveFriend(grpc::ServerContext*,
+                              const contacts::RemoveFriendRequest* request,
+                              contacts::RemoveFriendResponse*) override {
+        auto result =
+            service.removeFriend(request->token(), request->target_user_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ListFriends(grpc::ServerContext*,
+                             const contacts::ListFriendsRequest* request,
+                             contacts::ListFriendsResponse* response) override {
+        auto result = service.listFriends(request->token());
+        if (!result.ok()) return toStatus(result.error());
+        for (auto& user : result.value())
+            response->add_users()->set_id(user.id.str());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status SearchUser(grpc::ServerContext*,
+                            const contacts::SearchUserRequest* request,
+                            contacts::SearchUserResponse* response) override {
+        auto result = service.searchUser(request->token(), request->keyword(),
+                                         request->offset(), request->limit());
+        if (!result.ok()) return toStatus(result.error());
+        for (auto& user : result.value())
+            response->add_users()->set_id(user.id.str());
+        return grpc::Status::OK;
+    }
+
+private:
+    MockContactService service;
+};
+
+/// groups.proto 的服务端实现
+class GroupHandler final : public groups::GroupService::Service {
+public:
+    explicit GroupHandler(std::shared_ptr<MockDataStore> store)
+        : service(std::move(store)) {}
+
+    grpc::Status CreateGroup(grpc::ServerContext*,
+                             const groups::CreateGroupRequest* request,
+                             groups::CreateGroupResponse* response) override {
+        std::vector<std::string> members(request->member_ids().begin(),
+                                         request->member_ids().end());
+        auto result = service.createGroup(request->token(), members);
+        if (!result.ok()) return toStatus(result.error());
+        toProto(result.value(), response->mutable_group());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status DissolveGroup(grpc::ServerContext*,
+                               const groups::DissolveGroupRequest* request,
+                               groups::DissolveGroupResponse*) override {
+        auto result =
+            service.dissolveGroup(request->token(), request->group_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status AddMember(grpc::ServerContext*,
+                           const groups::AddMemberRequest* request,
+                           groups::AddMemberResponse*) override {
+        auto result = service.addMember(request->token(), request->group_id(),
+                                        request->user_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status RemoveMember(grpc::ServerContext*,
+                              const groups::RemoveMemberRequest* request,
+                              groups::RemoveMemberResponse*) override {
+        auto result = service.removeMember(
+            request->token(), request->group_id(), request->user_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ListMembers(grpc::ServerContext*,
+                             const groups::ListMembersRequest* request,
+                             groups::ListMembersResponse* response) override {
+        auto result = service.listMembers(request->token(), request->group_id());
+        if (!result.ok()) return toStatus(result.error());
+        for (auto& member : result.value())
+            response->add_member_ids(std::move(member));
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ListMyGroups(grpc::ServerContext*,
+                              const groups::ListMyGroupsRequest* request,
+                              groups::ListMyGroupsResponse* response) override {
+        auto result = service.listMyGroups(request->token());
+        if (!result.ok()) return toStatus(result.error());
+        for (auto& group : result.value())
+            toProto(group, response->add_groups());
+        return grpc::Status::OK;
+    }
+
+private:
+    MockGroupService service;
+};
+
+/// moments.proto 的服务端实现
+class MomentHandler final : public moments::MomentService::Service {
+public:
+    explicit MomentHandler(std::shared_ptr<MockDataStore> store)
+        : service(std::move(store)) {}
+
+    grpc::Status PostMoment(grpc::ServerContext*,
+                            const moments::PostMomentRequest* request,
+                            moments::PostMomentResponse* response) override {
+        std::vector<std::string> images(request->image_ids().begin(),
+                                        request->image_ids().end());
+        auto result = service.postMoment(request->token(), request->text(),
+                                         images);
+        if (!result.ok()) return toStatus(result.error());
+        toProto(std::move(result.value()), response->mutable_moment());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ListMoments(grpc::ServerContext*,
+                             const moments::ListMomentsRequest* request,
+                             moments::ListMomentsResponse* response) override {
+        auto result = service.listMoments(request->token(),
+                                          request->before_ts(),
+                                          request->limit());
+        if (!result.ok()) return toStatus(result.error());
+        response->mutable_moments()->Reserve(
+            static_cast<int>(result.value().size()));
+        for (auto& moment : result.value())
+            toProto(std::move(moment), response->add_moments());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status LikeMoment(grpc::ServerContext*,
+                            const moments::LikeMomentRequest* request,
+                            moments::LikeMomentResponse*) override {
+        auto result = service.likeMoment(request->token(), request->moment_id());
+        if (!result.ok()) return toStatus(result.error());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status CommentMoment(grpc::ServerContext*,
+                               const moments::CommentMomentRequest* request,
+                               moments::CommentMomentResponse* response)
+        override {
+        auto result = service.commentMoment(
+            request->token(), request->moment_id(), request->text());
+        if (!result.ok()) return toStatus(result.error());
+        toProto(std::move(result.value()), response->mutable_comment());
+        return grpc::Status::OK;
+    }
+
+    grpc::Status ListComments(grpc::ServerContext*,
+                              const moments::ListCommentsRequest* request,
+                              moments::ListCommentsResponse* response)
+        override {
+        auto result =
+            service.listComments(request->token(), request->moment_id(),
+                                 request->after_ts(), request->limit());
+        if (!result.ok()) return toStatus(result.error());
+        for (auto& comment : result.value().comments)
+            toProto(std::move(comment), response->add_comments());
+        response->set_has_more(result.value().hasMore);
+        return grpc::Status::OK;
+    }
+
+private:
+    MockMomentService service;
+};
+
+} // namespace
+
+GrpcLocalServer::GrpcLocalServer(std::shared_ptr<MockDataStore> store,
+                                 GrpcServerOptions options)
+    : dataStore(std::move(store)) {
+    services.push_back(std::make_unique<AuthHandler>(dataStore));
+    services.push_back(std::make_unique<ChatHandler>(dataStore));
+    services.push_back(std::make_unique<ContactHandler>(dataStore));
+    services.push_back(std::make_unique<GroupHandler>(dataStore));
+    services.push_back(std::make_unique<MomentHandler>(dataStore));
+
+    grpc::ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort(options.address,
+                             grpc::InsecureServerCredentials(), &port);
+    if (options.permitKeepaliveWithoutCalls) {
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+        builder.AddChannelArgument(
+            GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS,
+            static_cast<int>(options.minPingInterval.count()));
+    }
+    for (auto& service : services) builder.RegisterService(service.get());
+
+    server = builder.BuildAndStart();
+    if (!server || port == 0) {
+        spdlog::error("failed to start gRPC server on {}", options.address);
+        server.reset();
+        return;
+    }
+
+    auto host = options.address.substr(0, options.address.rfind(':'));
+    boundAddress = host + ":" + std::to_string(port);
+}
+
+GrpcLocalServer::~GrpcLocalServer() {
+    if (!server) return;
+    server->Shutdown();
+    server->Wait();
+}
+
+std::shared_ptr<grpc::Channel> GrpcLocalServer::inProcessChannel(
+    const GrpcChannelOptions& options) {
+    return server->InProcessChannel(channelArguments(options));
+}
+
+} // namespace wechat::network
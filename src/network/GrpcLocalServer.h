@@ -0,0 +1,64 @@
+#pragma once
+
+#include "GrpcChannel.h"
+#include "MockDataStore.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace wechat::network {
+
+struct GrpcServerOptions {
+    /// 监听地址；端口为 0 时由系统分配，实际地址见 GrpcLocalServer::address()
+    std::string address = "127.0.0.1:0";
+    /// 放开 keepalive 限制，配合 GrpcChannelOptions::keepaliveWithoutCalls：
+    /// 接受空闲连接上的 ping，且 ping 最小间隔降到 minPingInterval。
+    /// 默认不放开，与默认配置的 gRPC 服务端行为一致
+    bool permitKeepaliveWithoutCalls = false;
+    std::chrono::milliseconds minPingInterval{10'000};
+};
+
+/// 本地 gRPC 服务端：把 MockDataStore 上的 Mock 服务通过真实的 gRPC 接口
+/// 暴露出来，后端就绪前用于走通并测量序列化与传输开销
+///
+/// 构造后即开始服务（端口被占用等启动失败时 running() 为 false），析构时停止。
+/// 既可以经 address() 走 TCP 回环，也可以用 inProcessChannel() 跳过网络栈，
+/// 只保留序列化与 gRPC 调度。
+///
+/// 用法:
+///   GrpcLocalServer server;
+///   GrpcNetworkClient client(server.address());
+///   client.auth().login("alice", "pass");
+class GrpcLocalServer {
+public:
+    explicit GrpcLocalServer(
+        std::shared_ptr<MockDataStore> store = std::make_shared<MockDataStore>(),
+        GrpcServerOptions options = {});
+    ~GrpcLocalServer();
+
+    GrpcLocalServer(const GrpcLocalServer&) = delete;
+    GrpcLocalServer& operator=(const GrpcLocalServer&) = delete;
+
+    [[nodiscard]] bool running() const { return server != nullptr; }
+
+    /// 实际监听地址，如 "127.0.0.1:43127"
+    const std::string& address() const { return boundAddress; }
+
+    /// 不经过网络栈的进程内 channel（要求 running()）
+    std::shared_ptr<grpc::Channel> inProcessChannel(
+        const GrpcChannelOptions& options = {});
+
+    MockDataStore& store() { return *dataStore; }
+
+private:
+    std::shared_ptr<MockDataStore> dataStore;
+    std::vector<std::unique_ptr<grpc::Service>> services;
+    std::unique_ptr<grpc::Server> server;
+    std::string boundAddress;
+};
+
+} // namespace wechat::network
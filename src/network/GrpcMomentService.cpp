@@ -0,0 +1,106 @@
+#include "GrpcMomentService.h"
+
+#include "GrpcConvert.h"
+
+namespace wechat::network {
+
+namespace proto = wechat::moments;
+using google::protobuf::Arena;
+
+GrpcMomentService::GrpcMomentService(std::shared_ptr<grpc::Channel> channel,
+                                     GrpcChannelOptions options)
+    : stub(proto::MomentService::NewStub(channel)), options(options) {}
+
+Result<Moment> GrpcMomentService::postMoment(
+    const std::string& token, const std::string& text,
+    const std::vector<std::string>& imageIds) {
+    proto::PostMomentRequest request;
+    request.set_token(token);
+    request.set_text(text);
+    request.mutable_image_ids()->Reserve(static_cast<int>(imageIds.size()));
+    for (auto& image : imageIds) request.add_image_ids(image);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::PostMomentResponse response;
+    auto status = stub->PostMoment(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return fromProto(std::move(*response.mutable_moment()));
+}
+
+Result<std::vector<Moment>> GrpcMomentService::listMoments(
+    const std::string& token, int64_t beforeTs, int limit) {
+    proto::ListMomentsRequest request;
+    request.set_token(token);
+    request.set_before_ts(beforeTs);
+    request.set_limit(limit);
+
+    // 一页动态含大量小字符串，子消息分配在 arena 上，字符串移出后整体释放
+    Arena arena;
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    auto* response = Arena::CreateMessage<proto::ListMomentsResponse>(&arena);
+    auto status = stub->ListMoments(&context, request, response);
+    if (!status.ok()) return toError(status);
+
+    std::vector<Moment> moments;
+    moments.reserve(response->moments_size());
+    for (auto& moment : *response->mutable_moments())
+        moments.push_back(fromProto(std::move(moment)));
+    return moments;
+}
+
+VoidResult GrpcMomentService::likeMoment(const std::string& token,
+                                         const std::string& momentId) {
+    proto::LikeMomentRequest request;
+    request.set_token(token);
+    request.set_moment_id(momentId);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::LikeMomentResponse response;
+    auto status = stub->LikeMoment(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return success();
+}
+
+Result<Moment::Comment> GrpcMomentService::commentMoment(
+    const std::string& token, const std::string& momentId,
+    const std::string& text) {
+    proto::CommentMomentRequest request;
+    request.set_token(token);
+    request.set_moment_id(momentId);
+    request.set_text(text);
+
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    proto::CommentMomentResponse response;
+    auto status = stub->CommentMoment(&context, request, &response);
+    if (!status.ok()) return toError(status);
+    return fromProto(std::move(*response.mutable_comment()));
+}
+
+Result<ListCommentsResponse> GrpcMomentService::listComments(
+    const std::string& token, const std::string& momentId, int64_t afterTs,
+    int limit) {
+    proto::ListCommentsRequest request;
+    request.set_token(token);
+    request.set_moment_id(momentId);
+    request.set_after_ts(afterTs);
+    request.set_limit(limit);
+
+    Arena arena;
+    grpc::ClientContext context;
+    prepareContext(context, options);
+    auto* response = Arena::CreateMessage<proto::ListCommentsResponse>(&arena);
+    auto status = stub->ListComments(&context, request, response);
+    if (!status.ok()) return toError(status);
+
+    ListCommentsResponse result{{}, response->has_more()};
+    result.comments.reserve(response->comments_size());
+    for (auto& comment : *response->mutable_comments())
+        result.comments.push_back(fromProto(std::move(comment)));
+    return result;
+}
+
+} // namespace wechat::network
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <wechat/network/MomentService.h>
+
+#include "GrpcChannel.h"
+#include "moments.grpc.pb.h"
+
+#include <memory>
+
+namespace wechat::network {
+
+/// 基于 proto/moments.proto 的 MomentService 客户端，调用约定同 GrpcAuthService
+class GrpcMomentService : public MomentService {
+public:
+    GrpcMomentService(std::shared_ptr<grpc::Channel> channel,
+                      GrpcChannelOptions options = {});
+
+    Result<Moment> postMoment(
+        const std::string& token, const std::string& text,
+        const std::vector<std::string>& imageIds) override;
+    Result<std::vector<Moment>> listMoments(
+        const std::string& token, int64_t beforeTs, int limit) override;
+    VoidResult likeMoment(const std::string& token,
+                          const std::string& momentId) override;
+    Result<Moment::Comment> commentMoment(
+        const std::string& token, const std::string& momentId,
+        const std::string& text) override;
+    Result<ListCommentsResponse> listComments(
+        const std::string& token, const std::string& momentId,
+        int64_t afterTs, int limit) override;
+
+private:
+    std::unique_ptr<wechat::moments::MomentService::Stub> stub;
+    GrpcChannelOptions options;
+};
+
+} // namespace wechat::network
@@ -1,42 +1,39 @@
 #include "GrpcNetworkClient.h"
 
-#include "GrpcAuthService.h"
-#include "MockAuthService.h"
-#include "MockChatService.h"
-#include "MockContactService.h"
-#include "MockGroupService.h"
-#include "MockMomentService.h"
-#include "auth.pb.h"
-#include "auth.grpc.pb.h"
 namespace wechat {
 namespace network {
 
-GrpcNetworkClient::GrpcNetworkClient(const std::string& serverAddress)
-    : store(std::make_shared<MockDataStore>()),
-      authService(std::make_unique<GrpcAuthService>(serverAddress)),
-      chatService(std::make_unique<MockChatService>(store)),
-      contactService(std::make_unique<MockContactService>(store)),
-      groupService(std::make_unique<MockGroupService>(store)),
-      momentService(std::make_unique<MockMomentService>(store)) {}
+GrpcNetworkClient::GrpcNetworkClient(const std::string& serverAddress,
+                                     GrpcChannelOptions options)
+    : GrpcNetworkClient(createGrpcChannel(serverAddress, options), options) {}
+
+GrpcNetworkClient::GrpcNetworkClient(std::shared_ptr<grpc::Channel> channel,
+                                     GrpcChannelOptions options)
+    : channel(std::move(channel)),
+      authService(this->channel, options),
+      chatService(this->channel, options),
+      contactService(this->channel, options),
+      groupService(this->channel, options),
+      momentService(this->channel, options) {}
 
 AuthService& GrpcNetworkClient::auth() {
-    return *authService;
+    return authService;
 }
 
 ChatService& GrpcNetworkClient::chat() {
-    return *chatService;
+    return chatService;
 }
 
 ContactService& GrpcNetworkClient::contacts() {
-    return *contactService;
+    return contactService;
 }
 
 GroupService& GrpcNetworkClient::groups() {
-    return *groupService;
+    return groupService;
 }
 
 MomentService& GrpcNetworkClient::moments() {
-    return *momentService;
+    return momentService;
 }
 
 std::unique_ptr<NetworkClient> createGrpcClient(
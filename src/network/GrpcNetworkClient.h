@@ -1,29 +1,32 @@
 #pragma once
 
 #include <wechat/network/NetworkClient.h>
-#include "MockDataStore.h"
+
 #include "GrpcAuthService.h"
-#include "MockChatService.h"
-#include "MockContactService.h"
-#include "MockGroupService.h"
-#include "MockMomentService.h"
-#include "auth.pb.h"
-#include "auth.grpc.pb.h"
+#include "GrpcChannel.h"
+#include "GrpcChatService.h"
+#include "GrpcContactService.h"
+#include "GrpcGroupService.h"
+#include "GrpcMomentService.h"
+
 #include <memory>
 #include <string>
-using namespace wechat::auth;
+
 namespace wechat {
 namespace network {
 
-// 前向声明
-class GrpcAuthService;
-
 /// gRPC 网络客户端实现
-/// 需要后端服务运行才能使用
+///
+/// 所有 Service 共用一个 channel（连接复用、keepalive），
+/// 接口定义见 src/network/proto/*.proto。
 class GrpcNetworkClient : public NetworkClient {
 public:
     explicit GrpcNetworkClient(const std::string& serverAddress =
-                                  "localhost:50051");
+                                   "localhost:50051",
+                               GrpcChannelOptions options = {});
+    /// 使用现成的 channel（如 GrpcLocalServer::inProcessChannel()）
+    explicit GrpcNetworkClient(std::shared_ptr<grpc::Channel> channel,
+                               GrpcChannelOptions options = {});
 
     AuthService& auth() override;
     ChatService& chat() override;
@@ -32,16 +35,15 @@ public:
     MomentService& moments() override;
 
 private:
-    std::shared_ptr<MockDataStore> store;
-    std::unique_ptr<GrpcAuthService> authService;
-    std::unique_ptr<MockChatService> chatService;
-    std::unique_ptr<MockContactService> contactService;
-    std::unique_ptr<MockGroupService> groupService;
-    std::unique_ptr<MockMomentService> momentService;
+    std::shared_ptr<grpc::Channel> channel;
+    GrpcAuthService authService;
+    GrpcChatService chatService;
+    GrpcContactService contactService;
+    GrpcGroupService groupService;
+    GrpcMomentService momentService;
 };
 
 /// 创建 gRPC 客户端
-/// TODO: 当后端就绪时启用
 std::unique_ptr<NetworkClient> createGrpcClient(
     const std::string& serverAddress = "localhost:50051");
 
@@ -0,0 +1,252 @@
+#include "MeteredNetworkClient.h"
+
+namespace wechat::network {
+
+namespace {
+
+template <typename Call>
+auto measured(const log::Timer& timer, Call&& call) {
+    log::ScopedTimer scope(timer);
+    auto result = call();
+    if (!result.ok()) scope.fail();
+    return result;
+}
+
+} // namespace
+
+// ── Auth ──
+
+MeteredAuthService::MeteredAuthService(AuthService& inner,
+                                       log::MetricsRegistry& registry)
+    : inner(inner),
+      registerTimer(registry.timer("rpc.auth.registerUser")),
+      loginTimer(registry.timer("rpc.auth.login")),
+      logoutTimer(registry.timer("rpc.auth.logout")),
+      currentUserTimer(registry.timer("rpc.auth.getCurrentUser")) {}
+
+Result<LoginResponse> MeteredAuthService::registerUser(
+    const std::string& username, const std::string& password) {
+    return measured(registerTimer,
+                    [&] { return inner.registerUser(username, password); });
+}
+
+Result<LoginResponse> MeteredAuthService::login(const std::string& username,
+                                                const std::string& password) {
+    return measured(loginTimer,
+                    [&] { return inner.login(username, password); });
+}
+
+VoidResult MeteredAuthService::logout(const std::string& token) {
+    return measured(logoutTimer, [&] { return inner.logout(token); });
+}
+
+Result<core::User> MeteredAuthService::getCurrentUser(
+    const std::string& token) {
+    return measured(currentUserTimer,
+                    [&] { return inner.getCurrentUser(token); });
+}
+
+// ── Chat ──
+
+MeteredChatService::MeteredChatService(ChatService& inner,
+                                       log::MetricsRegistry& registry)
+    : inner(inner),
+      sendTimer(registry.timer("rpc.chat.sendMessage")),
+      syncTimer(registry.timer("rpc.chat.syncMessages")),
+      revokeTimer(registry.timer("rpc.chat.revokeMessage")),
+      editTimer(registry.timer("rpc.chat.editMessage")),
+      markReadTimer(registry.timer("rpc.chat.markRead")) {}
+
+Result<core::MessagePtr> MeteredChatService::sendMessage(
+    const std::string& token, const std::string& chatId,
+    const std::string& replyTo, const core::MessageContent& content) {
+    return measured(sendTimer, [&] {
+        return inner.sendMessage(token, chatId, replyTo, content);
+    });
+}
+
+Result<SyncMessagesResponse> MeteredChatService::syncMessages(
+    const std::string& token, const std::string& chatId, int64_t sinceTs,
+    int limit) {
+    return measured(syncTimer, [&] {
+        return inner.syncMessages(token, chatId, sinceTs, limit);
+    });
+}
+
+VoidResult MeteredChatService::revokeMessage(const std::string& token,
+                                             const std::string& messageId) {
+    return measured(revokeTimer,
+                    [&] { return inner.revokeMessage(token, messageId); });
+}
+
+VoidResult MeteredChatService::editMessage(
+    const std::string& token, const std::string& messageId,
+    const core::MessageContent& newContent) {
+    return measured(editTimer, [&] {
+        return inner.editMessage(token, messageId, newContent);
+    });
+}
+
+VoidResult MeteredChatService::markRead(const std::string& token,
+                                        const std::string& chatId,
+                                        const std::string& lastMessageId) {
+    return measured(markReadTimer, [&] {
+        return inner.markRead(token, chatId, lastMessageId);
+    });
+}
+
+// ── Contacts ──
+
+MeteredContactService::MeteredContactService(ContactService& inner,
+                                             log::MetricsRegistry& registry)
+    : inner(inner),
+      addTimer(registry.timer("rpc.contacts.addFriend")),
+      removeTimer(registry.timer("rpc.contacts.removeFriend")),
+      listTimer(registry.timer("rpc.contacts.listFriends")),
+      searchTimer(registry.timer("rpc.contacts.searchUser")) {}
+
+VoidResult MeteredContactService::addFriend(const std::string& token,
+                                            const std::string& targetUserId) {
+    return measured(addTimer,
+                    [&] { return inner.addFriend(token, targetUserId); });
+}
+
+VoidResult MeteredContactService::removeFriend(
+    const std::string& token, const std::string& targetUserId) {
+    return measured(removeTimer,
+                    [&] { return inner.removeFriend(token, targetUserId); });
+}
+
+Result<std::vector<core::User>> MeteredContactService::listFriends(
+    const std::string& token) {
+    return measured(listTimer, [&] { return inner.listFriends(token); });
+}
+
+Result<std::vector<core::User>> MeteredContactService::searchUser(
+    const std::string& token, const std::string& keyword, int offset,
+    int limit) {
+    return measured(searchTimer, [&] {
+        return inner.searchUser(token, keyword, offset, limit);
+    });
+}
+
+// ── Groups ──
+
+MeteredGroupService::MeteredGroupService(GroupService& inner,
+                                         log::MetricsRegistry& registry)
+    : inner(inner),
+      createTimer(registry.timer("rpc.groups.createGroup")),
+      dissolveTimer(registry.timer("rpc.groups.dissolveGroup")),
+      addMemberTimer(registry.timer("rpc.groups.addMember")),
+      removeMemberTimer(registry.timer("rpc.groups.removeMember")),
+      listMembersTimer(registry.timer("rpc.groups.listMembers")),
+      listMyGroupsTimer(registry.timer("rpc.groups.listMyGroups")) {}
+
+Result<core::Group> MeteredGroupService::createGroup(
+    const std::string& token, const std::vector<std::string>& memberIds) {
+    return measured(createTimer,
+                    [&] { return inner.createGroup(token, memberIds); });
+}
+
+VoidResult MeteredGroupService::dissolveGroup(const std::string& token,
+                                              const std::string& groupId) {
+    return measured(dissolveTimer,
+                    [&] { return inner.dissolveGroup(token, groupId); });
+}
+
+VoidResult MeteredGroupService::addMember(const std::string& token,
+                                          const std::string& groupId,
+                                          const std::string& userId) {
+    return measured(addMemberTimer,
+                    [&] { return inner.addMember(token, groupId, userId); });
+}
+
+VoidResult MeteredGroupService::removeMember(const std::string& token,
+                                             const std::string& groupId,
+                                             const std::string& userId) {
+    return measured(removeMemberTimer, [&] {
+        return inner.removeMember(token, groupId, userId);
+    });
+}
+
+Result<std::vector<std::string>> MeteredGroupService::listMembers(
+    const std::string& token, const std::string& groupId) {
+    return measured(listMembersTimer,
+                    [&] { return inner.listMembers(token, groupId); });
+}
+
+Result<std::vector<core::Group>> MeteredGroupService::listMyGroups(
+    const std::string& token) {
+    return measured(listMyGroupsTimer,
+                    [&] { return inner.listMyGroups(token); });
+}
+
+// ── Moments ──
+
+MeteredMomentService::MeteredMomentService(MomentService& inner,
+                                           log::MetricsRegistry& registry)
+    : inner(inner),
+      postTimer(registry.timer("rpc.moments.postMoment")),
+      listTimer(registry.timer("rpc.moments.listMoments")),
+      likeTimer(registry.timer("rpc.moments.likeMoment")),
+      commentTimer(registry.timer("rpc.moments.commentMoment")),
+      listCommentsTimer(registry.timer("rpc.moments.listComments")) {}
+
+Result<Moment> MeteredMomentService::postMoment(
+    const std::string& token, const std::string& text,
+    const std::vector<std::string>& imageIds) {
+    return measured(postTimer,
+                    [&] { return inner.postMoment(token, text, imageIds); });
+}
+
+Result<std::vector<Moment>> MeteredMomentService::listMoments(
+    const std::string& token, int64_t beforeTs, int limit) {
+    return measured(listTimer,
+                    [&] { return inner.listMoments(token, beforeTs, limit); });
+}
+
+VoidResult MeteredMomentService::likeMoment(const std::string& token,
+                                            const std::string& momentId) {
+    return measured(likeTimer,
+                    [&] { return inner.likeMoment(token, momentId); });
+}
+
+Result<Moment::Comment> MeteredMomentService::commentMoment(
+    const std::string& token, const std::string& momentId,
+    const std::string& text) {
+    return measured(commentTimer,
+                    [&] { return inner.commentMoment(token, momentId, text); });
+}
+
+Result<ListCommentsResponse> MeteredMomentService::listComments(
+    const std::string& token, const std::string& momentId, int64_t afterTs,
+    int limit) {
+    return measured(listCommentsTimer, [&] {
+        return inner.listComments(token, momentId, afterTs, limit);
+    });
+}
+
+// ── Client ──
+
+MeteredNetworkClient::MeteredNetworkClient(
+    std::unique_ptr<NetworkClient> client, log::MetricsRegistry& registry)
+    : inner(std::move(client)),
+      authService(inner->auth(), registry),
+      chatService(inner->chat(), registry),
+      contactService(inner->contacts(), registry),
+      groupService(inner->groups(), registry),
+      momentService(inner->moments(), registry) {}
+
+AuthService& MeteredNetworkClient::auth() { return authService; }
+ChatService& MeteredNetworkClient::chat() { return chatService; }
+ContactService& MeteredNetworkClient::contacts() { return contactService; }
+GroupService& MeteredNetworkClient::groups() { return groupService; }
+MomentService& MeteredNetworkClient::moments() { return momentService; }
+
+std::unique_ptr<NetworkClient> withMetrics(
+    std::unique_ptr<NetworkClient> client, log::MetricsRegistry& registry) {
+    return std::make_unique<MeteredNetworkClient>(std::move(client),
+                                                  registry);
+}
+
+} // namespace wechat::network
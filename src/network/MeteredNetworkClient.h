@@ -0,0 +1,146 @@
+#pragma once
+
+#include <wechat/log/Metrics.h>
+#include <wechat/network/NetworkClient.h>
+
+#include <memory>
+
+namespace wechat::network {
+
+// 以下装饰器包装任意 Service 实现：每个方法记录耗时直方图
+// rpc.<service>.<method>（纳秒），返回错误结果时计入 rpc.<service>.<method>.errors
+
+class MeteredAuthService : public AuthService {
+public:
+    MeteredAuthService(AuthService& inner, log::MetricsRegistry& registry);
+
+    Result<LoginResponse> registerUser(
+        const std::string& username, const std::string& password) override;
+    Result<LoginResponse> login(
+        const std::string& username, const std::string& password) override;
+    VoidResult logout(const std::string& token) override;
+    Result<core::User> getCurrentUser(const std::string& token) override;
+
+private:
+    AuthService& inner;
+    log::Timer registerTimer, loginTimer, logoutTimer, currentUserTimer;
+};
+
+class MeteredChatService : public ChatService {
+public:
+    MeteredChatService(ChatService& inner, log::MetricsRegistry& registry);
+
+    Result<core::MessagePtr> sendMessage(
+        const std::string& token, const std::string& chatId,
+        const std::string& replyTo,
+        const core::MessageContent& content) override;
+    Result<SyncMessagesResponse> syncMessages(
+        const std::string& token, const std::string& chatId,
+        int64_t sinceTs, int limit) override;
+    VoidResult revokeMessage(
+        const std::string& token, const std::string& messageId) override;
+    VoidResult editMessage(
+        const std::string& token, const std::string& messageId,
+        const core::MessageContent& newContent) override;
+    VoidResult markRead(
+        const std::string& token, const std::string& chatId,
+        const std::string& lastMessageId) override;
+
+private:
+    ChatService& inner;
+    log::Timer sendTimer, syncTimer, revokeTimer, editTimer, markReadTimer;
+};
+
+class MeteredContactService : public ContactService {
+public:
+    MeteredContactService(ContactService& inner,
+                          log::MetricsRegistry& registry);
+
+    VoidResult addFriend(
+        const std::string& token, const std::string& targetUserId) override;
+    VoidResult removeFriend(
+        const std::string& token, const std::string& targetUserId) override;
+    Result<std::vector<core::User>> listFriends(
+        const std::string& token) override;
+    using ContactService::searchUser;
+    Result<std::vector<core::User>> searchUser(
+        const std::string& token, const std::string& keyword,
+        int offset, int limit) override;
+
+private:
+    ContactService& inner;
+    log::Timer addTimer, removeTimer, listTimer, searchTimer;
+};
+
+class MeteredGroupService : public GroupService {
+public:
+    MeteredGroupService(GroupService& inner, log::MetricsRegistry& registry);
+
+    Result<core::Group> createGroup(
+        const std::string& token,
+        const std::vector<std::string>& memberIds) override;
+    VoidResult dissolveGroup(
+        const std::string& token, const std::string& groupId) override;
+    VoidResult addMember(
+        const std::string& token, const std::string& groupId,
+        const std::string& userId) override;
+    VoidResult removeMember(
+        const std::string& token, const std::string& groupId,
+        const std::string& userId) override;
+    Result<std::vector<std::string>> listMembers(
+        const std::string& token, const std::string& groupId) override;
+    Result<std::vector<core::Group>> listMyGroups(
+        const std::string& token) override;
+
+private:
+    GroupService& inner;
+    log::Timer createTimer, dissolveTimer, addMemberTimer, removeMemberTimer,
+        listMembersTimer, listMyGroupsTimer;
+};
+
+class MeteredMomentService : public MomentService {
+public:
+    MeteredMomentService(MomentService& inner, log::MetricsRegistry& registry);
+
+    Result<Moment> postMoment(
+        const std::string& token, const std::string& text,
+        const std::vector<std::string>& imageIds) override;
+    Result<std::vector<Moment>> listMoments(
+        const std::string& token, int64_t beforeTs, int limit) override;
+    VoidResult likeMoment(
+        const std::string& token, const std::string& momentId) override;
+    Result<Moment::Comment> commentMoment(
+        const std::string& token, const std::string& momentId,
+        const std::string& text) override;
+    Result<ListCommentsResponse> listComments(
+        const std::string& token, const std::string& momentId,
+        int64_t afterTs, int limit) override;
+
+private:
+    MomentService& inner;
+    log::Timer postTimer, listTimer, likeTimer, commentTimer,
+        listCommentsTimer;
+};
+
+/// 持有被包装的客户端，对外提供带指标的 Service
+class MeteredNetworkClient : public NetworkClient {
+public:
+    MeteredNetworkClient(std::unique_ptr<NetworkClient> inner,
+                         log::MetricsRegistry& registry);
+
+    AuthService& auth() override;
+    ChatService& chat() override;
+    ContactService& contacts() override;
+    GroupService& groups() override;
+    MomentService& moments() override;
+
+private:
+    std::unique_ptr<NetworkClient> inner;
+    MeteredAuthService authService;
+    MeteredChatService chatService;
+    MeteredContactService contactService;
+    MeteredGroupService groupService;
+    MeteredMomentService momentService;
+};
+
+} // namespace wechat::network
@@ -5,21 +5,20 @@
 namespace wechat::network {
 
 MockAuthService::MockAuthService(std::shared_ptr<MockDataStore> store)
-    : store(std::move(store)) {}
+    : store(std::move(store)),
+      sessions(this->store->sessionTable(),
+               this->store->sessionTable().options().serviceCacheSlots) {}
 
 Result<LoginResponse> MockAuthService::registerUser(
     const std::string& username, const std::string& password) {
     if (username.empty() || password.empty())
         return {ErrorCode::InvalidArgument, "username and password required"};
 
-    // 检查用户名是否已存在 - searchUsers 使用精确匹配当搜索词与用户名长度相同时
-    // 如果 searchUsers 返回任何结果，说明用户名已存在（因为我们搜索的是完整用户名）
-    auto existingUsers = store->searchUsers(username);
-    if (!existingUsers.empty()) {
+    // addUser 在同一把锁内做用户名精确查重
+    auto userId = store->addUser(username, password);
+    if (userId.empty())
         return {ErrorCode::AlreadyExists, "username already exists"};
-    }
 
-    auto userId = store->addUser(username, password);
     auto token = store->createToken(userId);
     return LoginResponse{userId, token};
 }
@@ -35,7 +34,7 @@ Result<LoginResponse> MockAuthService::login(
 }
 
 VoidResult MockAuthService::logout(const std::string& token) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
@@ -44,11 +43,11 @@ VoidResult MockAuthService::logout(const std::string& token) {
 }
 
 Result<core::User> MockAuthService::getCurrentUser(const std::string& token) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* user = store->findUser(userId);
+    auto user = store->findUser(userId);
     if (!user)
         return {ErrorCode::Internal, "user not found"};
 
@@ -2,6 +2,8 @@
 
 #include <wechat/network/AuthService.h>
 
+#include "SessionCache.h"
+
 #include <memory>
 namespace wechat::network {
 
@@ -20,6 +22,7 @@ public:
 
 private:
     std::shared_ptr<MockDataStore> store;
+    SessionCache sessions;
 };
 
 } // namespace wechat::network
@@ -1,45 +1,61 @@
 #include "MockChatService.h"
 
+#include <wechat/log/Trace.h>
+
 #include "MockDataStore.h"
 
 #include <algorithm>
+#include <optional>
 
 namespace wechat::network {
 
 MockChatService::MockChatService(std::shared_ptr<MockDataStore> store)
-    : store(std::move(store)) {}
+    : store(std::move(store)),
+      sessions(this->store->sessionTable(),
+               this->store->sessionTable().options().serviceCacheSlots) {}
 
-Result<core::Message> MockChatService::sendMessage(
+Result<core::MessagePtr> MockChatService::sendMessage(
     const std::string& token, const std::string& chatId,
     const std::string& replyTo, const core::MessageContent& content) {
-    auto userId = store->resolveToken(token);
+    WECHAT_TRACE_SCOPE("MockChatService::sendMessage", "network");
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
     if (content.empty())
         return {ErrorCode::InvalidArgument, "empty content"};
 
-    // 验证 chatId 对应的群存在且用户是成员
-    auto* group = store->findGroup(chatId);
-    if (!group)
+    // 验证 chatId 对应的群存在且用户是成员（在存储的锁内判定）
+    auto groupId = core::Id::find(chatId);
+    auto member = store->isGroupMember(groupId, userId);
+    if (!member)
         return {ErrorCode::NotFound, "chat not found"};
 
-    auto& members = group->memberIds;
-    if (std::find(members.begin(), members.end(), userId) == members.end())
+    if (!*member)
         return {ErrorCode::PermissionDenied, "not a member of this chat"};
 
-    auto& msg = store->addMessage(userId, chatId, replyTo, content);
-    return msg;
+    // 客户端传来的 ID 只查不驻留，引用的消息必须存在
+    auto replyId = core::Id::find(replyTo);
+    if (!replyTo.empty() && !store->findMessage(replyId))
+        return {ErrorCode::NotFound, "reply target not found"};
+
+    return store->addMessage(userId, groupId, replyId, content);
 }
 
 Result<SyncMessagesResponse> MockChatService::syncMessages(
     const std::string& token, const std::string& chatId,
     int64_t sinceTs, int limit) {
-    auto userId = store->resolveToken(token);
+    WECHAT_TRACE_SCOPE("MockChatService::syncMessages", "network");
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto msgs = store->getMessages(chatId, sinceTs, limit + 1);
+    if (limit <= 0)
+        return {ErrorCode::InvalidArgument, "invalid page"};
+
+    // limit 来自客户端，先钳到单页上限，多取一条判断 hasMore 时不会溢出
+    limit = std::min(limit, MaxSyncPage);
+    auto msgs = store->getMessages(core::Id::find(chatId), sinceTs, limit + 1);
     bool hasMore = static_cast<int>(msgs.size()) > limit;
     if (hasMore) msgs.pop_back();
 
@@ -48,59 +64,77 @@ Result<SyncMessagesResponse> MockChatService::syncMessages(
 
 VoidResult MockChatService::revokeMessage(const std::string& token,
                                           const std::string& messageId) {
-    auto userId = store->resolveToken(token);
+    WECHAT_TRACE_SCOPE("MockChatService::revokeMessage", "network");
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* msg = store->findMessage(messageId);
-    if (!msg)
+    std::optional<VoidResult> error;
+    auto now = store->now();
+    auto updated = store->updateMessage(core::Id::find(messageId), [&](core::Message& msg) {
+        if (msg.senderId != userId) {
+            error = VoidResult{ErrorCode::PermissionDenied,
+                               "can only revoke own messages"};
+            return false;
+        }
+        msg.revoked = true;
+        msg.updatedAt = now;
+        return true;
+    });
+    if (error) return *error;
+    if (!updated)
         return {ErrorCode::NotFound, "message not found"};
-
-    if (msg->senderId != userId)
-        return {ErrorCode::PermissionDenied, "can only revoke own messages"};
-
-    msg->revoked = true;
-    msg->updatedAt = store->now();
     return success();
 }
 
 VoidResult MockChatService::editMessage(
     const std::string& token, const std::string& messageId,
     const core::MessageContent& newContent) {
-    auto userId = store->resolveToken(token);
+    WECHAT_TRACE_SCOPE("MockChatService::editMessage", "network");
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* msg = store->findMessage(messageId);
-    if (!msg)
-        return {ErrorCode::NotFound, "message not found"};
-
-    if (msg->senderId != userId)
-        return {ErrorCode::PermissionDenied, "can only edit own messages"};
-
-    if (msg->revoked)
-        return {ErrorCode::InvalidArgument, "cannot edit revoked message"};
-
+    std::optional<VoidResult> error;
     auto ts = store->now();
-    msg->content = newContent;
-    msg->editedAt = ts;
-    msg->updatedAt = ts;
+    auto updated = store->updateMessage(core::Id::find(messageId), [&](core::Message& msg) {
+        if (msg.senderId != userId) {
+            error = VoidResult{ErrorCode::PermissionDenied,
+                               "can only edit own messages"};
+            return false;
+        }
+        if (msg.revoked) {
+            error = VoidResult{ErrorCode::InvalidArgument,
+                               "cannot edit revoked message"};
+            return false;
+        }
+        msg.content = newContent;
+        msg.editedAt = ts;
+        msg.updatedAt = ts;
+        return true;
+    });
+    if (error) return *error;
+    if (!updated)
+        return {ErrorCode::NotFound, "message not found"};
     return success();
 }
 
 VoidResult MockChatService::markRead(const std::string& token,
                                      const std::string& chatId,
                                      const std::string& lastMessageId) {
-    auto userId = store->resolveToken(token);
+    WECHAT_TRACE_SCOPE("MockChatService::markRead", "network");
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* msg = store->findMessage(lastMessageId);
-    if (!msg)
+    auto now = store->now();
+    auto updated = store->updateMessage(core::Id::find(lastMessageId), [&](core::Message& msg) {
+        msg.readCount++;
+        msg.updatedAt = now;
+        return true;
+    });
+    if (!updated)
         return {ErrorCode::NotFound, "message not found"};
-
-    msg->readCount++;
-    msg->updatedAt = store->now();
     return success();
 }
 
@@ -2,6 +2,8 @@
 
 #include <wechat/network/ChatService.h>
 
+#include "SessionCache.h"
+
 #include <memory>
 namespace wechat::network {
 
@@ -11,7 +13,7 @@ class MockChatService : public ChatService {
 public:
     explicit MockChatService(std::shared_ptr<MockDataStore> store);
 
-    Result<core::Message> sendMessage(
+    Result<core::MessagePtr> sendMessage(
         const std::string& token, const std::string& chatId,
         const std::string& replyTo,
         const core::MessageContent& content) override;
@@ -29,6 +31,7 @@ public:
 
 private:
     std::shared_ptr<MockDataStore> store;
+    SessionCache sessions;
 };
 
 } // namespace wechat::network
@@ -5,62 +5,69 @@
 namespace wechat::network {
 
 MockContactService::MockContactService(std::shared_ptr<MockDataStore> store)
-    : store(std::move(store)) {}
+    : store(std::move(store)),
+      sessions(this->store->sessionTable(),
+               this->store->sessionTable().options().serviceCacheSlots) {}
 
 VoidResult MockContactService::addFriend(const std::string& token,
                                          const std::string& targetUserId) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
     if (userId == targetUserId)
         return {ErrorCode::InvalidArgument, "cannot add yourself"};
 
-    if (!store->findUser(targetUserId))
+    auto targetId = core::Id::find(targetUserId);
+    if (!store->findUser(targetId))
         return {ErrorCode::NotFound, "user not found"};
 
-    if (store->areFriends(userId, targetUserId))
+    if (store->areFriends(userId, targetId))
         return {ErrorCode::AlreadyExists, "already friends"};
 
-    store->addFriendship(userId, targetUserId);
+    store->addFriendship(userId, targetId);
     return success();
 }
 
 VoidResult MockContactService::removeFriend(const std::string& token,
                                             const std::string& targetUserId) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    if (!store->areFriends(userId, targetUserId))
+    auto targetId = core::Id::find(targetUserId);
+    if (!store->areFriends(userId, targetId))
         return {ErrorCode::NotFound, "not friends"};
 
-    store->removeFriendship(userId, targetUserId);
+    store->removeFriendship(userId, targetId);
     return success();
 }
 
 Result<std::vector<core::User>> MockContactService::listFriends(
     const std::string& token) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
     auto friendIds = store->getFriendIds(userId);
     std::vector<core::User> result;
     for (auto& fid : friendIds) {
-        auto* u = store->findUser(fid);
-        if (u) result.push_back(*u);
+        if (auto u = store->findUser(fid)) result.push_back(std::move(*u));
     }
     return result;
 }
 
 Result<std::vector<core::User>> MockContactService::searchUser(
-    const std::string& token, const std::string& keyword) {
-    auto userId = store->resolveToken(token);
+    const std::string& token, const std::string& keyword, int offset,
+    int limit) {
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    return store->searchUsers(keyword);
+    if (offset < 0 || limit <= 0)
+        return {ErrorCode::InvalidArgument, "invalid page"};
+
+    return store->searchUsers(keyword, offset, limit);
 }
 
 } // namespace wechat::network
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <wechat/network/ContactService.h>
+
+#include "SessionCache.h"
 #include <memory>
 namespace wechat::network {
 
@@ -16,11 +18,14 @@ public:
         const std::string& token, const std::string& targetUserId) override;
     Result<std::vector<core::User>> listFriends(
         const std::string& token) override;
+    using ContactService::searchUser;
     Result<std::vector<core::User>> searchUser(
-        const std::string& token, const std::string& keyword) override;
+        const std::string& token, const std::string& keyword,
+        int offset, int limit) override;
 
 private:
     std::shared_ptr<MockDataStore> store;
+    SessionCache sessions;
 };
 
 } // namespace wechat::network
@@ -1,10 +1,15 @@
 #include "MockDataStore.h"
 
+#include <wechat/log/Trace.h>
+
 #include <algorithm>
+#include <queue>
 
 namespace wechat::network {
 
-MockDataStore::MockDataStore() : clock(1000000), idCounter(0) {}
+MockDataStore::MockDataStore(SessionOptions sessionOptions)
+    : clock(1000000), sessions(sessionOptions),
+      feedFanoutThreshold(DefaultFeedFanoutThreshold) {}
 
 int64_t MockDataStore::now() {
     std::lock_guard lock(mutex);
@@ -12,24 +17,27 @@ int64_t MockDataStore::now() {
 }
 
 std::string MockDataStore::nextId(const std::string& prefix) {
-    std::lock_guard lock(mutex);
-    return prefix + std::to_string(++idCounter);
+    return ids.nextString(prefix);
 }
 
 // ── 用户 / 认证 ──
 
-std::string MockDataStore::addUser(const std::string& username,
-                                   const std::string& password) {
+core::Id MockDataStore::addUser(const std::string& username,
+                                const std::string& password) {
+    auto idText = ids.nextString("u");
     std::lock_guard lock(mutex);
-    auto id = "u" + std::to_string(++idCounter);
+    if (usersByName.contains(username)) return {};
+    // 查重通过后才驻留，重复注册不会往驻留表里留下废 ID
+    core::Id id(idText);
     core::User user{id};
-    usersByName[username] = UserRecord{user, password};
+    usersByName.emplace(username, UserRecord{user, password});
     userIdToName[id] = username;
+    userSearch.add(id, username);
     return id;
 }
 
-std::string MockDataStore::authenticate(const std::string& username,
-                                        const std::string& password) {
+core::Id MockDataStore::authenticate(const std::string& username,
+                                     const std::string& password) {
     std::lock_guard lock(mutex);
     auto it = usersByName.find(username);
     if (it == usersByName.end() || it->second.password != password)
@@ -37,187 +45,366 @@ std::string MockDataStore::authenticate(const std::string& username,
     return it->second.user.id;
 }
 
-std::string MockDataStore::createToken(const std::string& userId) {
-    std::lock_guard lock(mutex);
-    auto token = "tok_" + std::to_string(++idCounter);
-    tokens[token] = userId;
-    return token;
+std::string MockDataStore::createToken(core::Id userId) {
+    return sessions.create(userId);
 }
 
-std::string MockDataStore::resolveToken(const std::string& token) {
-    std::lock_guard lock(mutex);
-    auto it = tokens.find(token);
-    return it != tokens.end() ? it->second : std::string{};
+core::Id MockDataStore::resolveToken(const std::string& token) {
+    return sessions.resolve(token);
 }
 
 void MockDataStore::removeToken(const std::string& token) {
-    std::lock_guard lock(mutex);
-    tokens.erase(token);
+    sessions.remove(token);
 }
 
-core::User* MockDataStore::findUser(const std::string& userId) {
+SessionTable& MockDataStore::sessionTable() { return sessions; }
+
+std::optional<core::User> MockDataStore::findUser(core::Id userId) {
     std::lock_guard lock(mutex);
     auto nameIt = userIdToName.find(userId);
-    if (nameIt == userIdToName.end()) return nullptr;
+    if (nameIt == userIdToName.end()) return std::nullopt;
     auto it = usersByName.find(nameIt->second);
-    if (it == usersByName.end()) return nullptr;
-    return &it->second.user;
+    if (it == usersByName.end()) return std::nullopt;
+    return it->second.user;
 }
 
-std::vector<core::User> MockDataStore::searchUsers(const std::string& keyword) {
+std::vector<core::User> MockDataStore::searchUsers(const std::string& keyword,
+                                                  int offset, int limit) {
     std::lock_guard lock(mutex);
     std::vector<core::User> result;
-    for (auto& [name, record] : usersByName) {
-        if (name.find(keyword) != std::string::npos ||
-            record.user.id.find(keyword) != std::string::npos) {
-            result.push_back(record.user);
-        }
+    for (auto& id : userSearch.search(keyword, offset, limit)) {
+        result.push_back(core::User{core::Id::find(id)});
     }
     return result;
 }
 
 // ── 好友 ──
 
-std::pair<std::string, std::string> MockDataStore::ordered(
-    const std::string& a, const std::string& b) {
-    return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
-}
-
-void MockDataStore::addFriendship(const std::string& a, const std::string& b) {
+void MockDataStore::addFriendship(core::Id a, core::Id b) {
     std::lock_guard lock(mutex);
-    friendships.insert(ordered(a, b));
+    if (!friendsByUser[a].insert(b).second) return;
+    friendsByUser[b].insert(a);
+    // 新好友此前推送过的动态补进收件箱；未推送的动态读时拉取
+    backfillInbox(a, b);
+    backfillInbox(b, a);
 }
 
-void MockDataStore::removeFriendship(const std::string& a,
-                                     const std::string& b) {
+void MockDataStore::removeFriendship(core::Id a, core::Id b) {
     std::lock_guard lock(mutex);
-    friendships.erase(ordered(a, b));
+    if (auto it = friendsByUser.find(a); it != friendsByUser.end())
+        it->second.erase(b);
+    if (auto it = friendsByUser.find(b); it != friendsByUser.end())
+        it->second.erase(a);
+    if (auto it = inboxes.find(a); it != inboxes.end())
+        std::erase_if(it->second, [&](auto& e) { return e.authorId == b; });
+    if (auto it = inboxes.find(b); it != inboxes.end())
+        std::erase_if(it->second, [&](auto& e) { return e.authorId == a; });
 }
 
-bool MockDataStore::areFriends(const std::string& a, const std::string& b) {
+bool MockDataStore::areFriends(core::Id a, core::Id b) {
     std::lock_guard lock(mutex);
-    return friendships.contains(ordered(a, b));
+    auto it = friendsByUser.find(a);
+    return it != friendsByUser.end() && it->second.contains(b);
 }
 
-std::vector<std::string> MockDataStore::getFriendIds(
-    const std::string& userId) {
+std::vector<core::Id> MockDataStore::getFriendIds(core::Id userId) {
     std::lock_guard lock(mutex);
-    std::vector<std::string> result;
-    for (auto& [a, b] : friendships) {
-        if (a == userId) result.push_back(b);
-        else if (b == userId) result.push_back(a);
-    }
-    return result;
+    auto it = friendsByUser.find(userId);
+    if (it == friendsByUser.end()) return {};
+    return {it->second.begin(), it->second.end()};
 }
 
 // ── 群组 ──
 
-core::Group& MockDataStore::createGroup(
-    const std::string& ownerId,
-    const std::vector<std::string>& memberIds) {
+core::Group MockDataStore::createGroup(
+    core::Id ownerId, const std::vector<core::Id>& memberIds) {
+    core::Id id(ids.nextString("g"));
     std::lock_guard lock(mutex);
-    auto id = "g" + std::to_string(++idCounter);
-    core::Group group{id, ownerId, memberIds};
+    core::Group group{id, ownerId, core::IdSet(memberIds)};
     auto [it, _] = groups.emplace(id, std::move(group));
+    for (auto& uid : it->second.memberIds) groupsByUser[uid].insert(id);
     return it->second;
 }
 
-core::Group* MockDataStore::findGroup(const std::string& groupId) {
+std::optional<core::Group> MockDataStore::findGroup(core::Id groupId) {
+    WECHAT_TRACE_SCOPE("MockDataStore::findGroup", "network");
     std::lock_guard lock(mutex);
     auto it = groups.find(groupId);
-    return it != groups.end() ? &it->second : nullptr;
+    if (it == groups.end()) return std::nullopt;
+    return it->second;
 }
 
-void MockDataStore::removeGroup(const std::string& groupId) {
+std::optional<bool> MockDataStore::isGroupMember(core::Id groupId,
+                                                 core::Id userId) {
+    WECHAT_TRACE_SCOPE("MockDataStore::isGroupMember", "network");
     std::lock_guard lock(mutex);
-    groups.erase(groupId);
+    auto it = groups.find(groupId);
+    if (it == groups.end()) return std::nullopt;
+    return it->second.memberIds.contains(userId);
 }
 
-std::vector<core::Group> MockDataStore::getGroupsByUser(
-    const std::string& userId) {
+void MockDataStore::removeGroup(core::Id groupId) {
+    std::lock_guard lock(mutex);
+    auto it = groups.find(groupId);
+    if (it == groups.end()) return;
+    for (auto& uid : it->second.memberIds) {
+        if (auto idx = groupsByUser.find(uid); idx != groupsByUser.end())
+            idx->second.erase(groupId);
+    }
+    groups.erase(it);
+}
+
+bool MockDataStore::addGroupMember(core::Id groupId, core::Id userId) {
+    std::lock_guard lock(mutex);
+    auto it = groups.find(groupId);
+    if (it == groups.end()) return false;
+    if (!it->second.memberIds.insert(userId)) return false;
+    groupsByUser[userId].insert(groupId);
+    return true;
+}
+
+bool MockDataStore::removeGroupMember(core::Id groupId,
+                                      core::Id userId) {
+    std::lock_guard lock(mutex);
+    auto it = groups.find(groupId);
+    if (it == groups.end()) return false;
+    if (!it->second.memberIds.erase(userId)) return false;
+    if (auto idx = groupsByUser.find(userId); idx != groupsByUser.end())
+        idx->second.erase(groupId);
+    return true;
+}
+
+std::vector<core::Group> MockDataStore::getGroupsByUser(core::Id userId) {
     std::lock_guard lock(mutex);
     std::vector<core::Group> result;
-    for (auto& [_, g] : groups) {
-        auto& m = g.memberIds;
-        if (std::find(m.begin(), m.end(), userId) != m.end()) {
-            result.push_back(g);
-        }
+    auto idx = groupsByUser.find(userId);
+    if (idx == groupsByUser.end()) return result;
+    result.reserve(idx->second.size());
+    for (auto& gid : idx->second) {
+        auto it = groups.find(gid);
+        if (it != groups.end()) result.push_back(it->second);
     }
     return result;
 }
 
 // ── 消息 ──
 
-core::Message& MockDataStore::addMessage(
-    const std::string& senderId, const std::string& chatId,
-    const std::string& replyTo, const core::MessageContent& content) {
+core::MessagePtr MockDataStore::addMessage(
+    core::Id senderId, core::Id chatId, core::Id replyTo,
+    const core::MessageContent& content) {
+    WECHAT_TRACE_SCOPE("MockDataStore::addMessage", "network");
     std::lock_guard lock(mutex);
-    auto id = "m" + std::to_string(++idCounter);
+    // 在锁内取号：同一会话中 ID 与 timestamp 同序，ID 也可作分页键
+    core::Id id(ids.nextString("m"));
     auto ts = ++clock;
-    core::Message msg{id, senderId, chatId, replyTo, content,
-                      ts, 0, false, 0, 0};
-    auto [it, _] = messages.emplace(id, std::move(msg));
-    chatMessages[chatId].push_back(id);
-    return it->second;
+    // clock 单调递增，追加到末尾即保持 timestamp 有序
+    auto& history = chatMessages[chatId];
+    auto msg = core::makeSnapshot(core::Message{
+        id, senderId, chatId, replyTo, content, ts, 0, false, 0, 0});
+    messages.emplace(id, MessageSlot{chatId, history.size()});
+    history.push_back(msg);
+    return msg;
 }
 
-core::Message* MockDataStore::findMessage(const std::string& messageId) {
+core::MessagePtr MockDataStore::findMessage(core::Id messageId) {
+    WECHAT_TRACE_SCOPE("MockDataStore::findMessage", "network");
     std::lock_guard lock(mutex);
     auto it = messages.find(messageId);
-    return it != messages.end() ? &it->second : nullptr;
+    if (it == messages.end()) return nullptr;
+    return chatMessages[it->second.chatId][it->second.index];
 }
 
-std::vector<core::Message> MockDataStore::getMessages(
-    const std::string& chatId, int64_t sinceTs, int limit) {
+core::MessagePtr MockDataStore::updateMessage(
+    core::Id messageId, const std::function<bool(core::Message&)>& edit) {
+    WECHAT_TRACE_SCOPE("MockDataStore::updateMessage", "network");
     std::lock_guard lock(mutex);
-    std::vector<core::Message> result;
-    auto it = chatMessages.find(chatId);
-    if (it == chatMessages.end()) return result;
+    auto it = messages.find(messageId);
+    if (it == messages.end()) return nullptr;
+    auto& slot = chatMessages[it->second.chatId][it->second.index];
+    core::Message next = *slot;
+    if (!edit(next)) return nullptr;
+    slot = core::makeSnapshot(std::move(next));
+    return slot;
+}
 
-    for (auto& msgId : it->second) {
-        auto msgIt = messages.find(msgId);
-        if (msgIt != messages.end() && msgIt->second.timestamp > sinceTs) {
-            result.push_back(msgIt->second);
-            if (static_cast<int>(result.size()) >= limit) break;
-        }
-    }
-    return result;
+std::vector<core::MessagePtr> MockDataStore::getMessages(core::Id chatId,
+                                                         int64_t sinceTs,
+                                                         int limit) {
+    WECHAT_TRACE_SCOPE("MockDataStore::getMessages", "network");
+    std::lock_guard lock(mutex);
+    auto it = chatMessages.find(chatId);
+    if (it == chatMessages.end() || limit <= 0) return {};
+
+    // 二分定位第一条 timestamp > sinceTs 的消息，只取请求的一页
+    auto& history = it->second;
+    auto first = std::upper_bound(
+        history.begin(), history.end(), sinceTs,
+        [](int64_t ts, const core::MessagePtr& m) { return ts < m->timestamp; });
+    auto count = std::min<std::ptrdiff_t>(limit, history.end() - first);
+    return {first, first + count};
 }
 
 // ── 朋友圈 ──
 
-Moment& MockDataStore::addMoment(const std::string& authorId,
-                                 const std::string& text,
-                                 const std::vector<std::string>& imageIds) {
+Moment MockDataStore::addMoment(core::Id authorId, const std::string& text,
+                                const std::vector<std::string>& imageIds) {
     std::lock_guard lock(mutex);
-    auto id = "mo" + std::to_string(++idCounter);
+    core::Id id(ids.nextString("mo"));
     auto ts = ++clock;
-    Moment moment{id, authorId, text, imageIds, ts, {}, {}};
+    Moment moment{id, authorId, text, imageIds, ts, 0, false, 0, {}};
     auto [it, _] = moments.emplace(id, std::move(moment));
-    momentTimeline.insert(momentTimeline.begin(), id);
+    interactions.try_emplace(id);
+
+    // fan-out-on-write：好友数不超过阈值时直接投递到每个好友的收件箱
+    auto friendIt = friendsByUser.find(authorId);
+    auto friendCount =
+        friendIt != friendsByUser.end() ? friendIt->second.size() : 0;
+    FeedEntry entry{ts, id, authorId, friendCount <= feedFanoutThreshold};
+    outboxes[authorId].push_back(entry);
+    if (entry.pushed) {
+        if (friendCount > 0) {
+            for (auto& friendId : friendIt->second)
+                inboxes[friendId].push_back(entry);
+        }
+    } else {
+        pullOutboxes[authorId].push_back(entry);
+    }
     return it->second;
 }
 
-Moment* MockDataStore::findMoment(const std::string& momentId) {
+bool MockDataStore::hasMoment(core::Id momentId) {
     std::lock_guard lock(mutex);
-    auto it = moments.find(momentId);
-    return it != moments.end() ? &it->second : nullptr;
+    return moments.contains(momentId);
 }
 
-std::vector<Moment> MockDataStore::getMoments(
-    const std::set<std::string>& visibleUserIds,
-    int64_t beforeTs, int limit) {
+void MockDataStore::setFeedFanoutThreshold(std::size_t threshold) {
+    std::lock_guard lock(mutex);
+    feedFanoutThreshold = threshold;
+}
+
+void MockDataStore::backfillInbox(core::Id userId, core::Id authorId) {
+    auto outIt = outboxes.find(authorId);
+    if (outIt == outboxes.end()) return;
+
+    Timeline pushed;
+    std::copy_if(outIt->second.begin(), outIt->second.end(),
+                 std::back_inserter(pushed), [](auto& e) { return e.pushed; });
+    if (pushed.empty()) return;
+
+    auto& inbox = inboxes[userId];
+    Timeline merged;
+    merged.reserve(inbox.size() + pushed.size());
+    std::merge(inbox.begin(), inbox.end(), pushed.begin(), pushed.end(),
+               std::back_inserter(merged),
+               [](auto& x, auto& y) { return x.timestamp < y.timestamp; });
+    inbox = std::move(merged);
+}
+
+std::vector<Moment> MockDataStore::getFeed(core::Id userId, int64_t beforeTs,
+                                           int limit) {
+    WECHAT_TRACE_SCOPE("MockDataStore::getFeed", "network");
     std::lock_guard lock(mutex);
     std::vector<Moment> result;
-    for (auto& id : momentTimeline) {
-        auto it = moments.find(id);
-        if (it == moments.end()) continue;
-        auto& m = it->second;
-        if (m.timestamp >= beforeTs) continue;
-        if (!visibleUserIds.contains(m.authorId)) continue;
-        result.push_back(m);
-        if (static_cast<int>(result.size()) >= limit) break;
+    if (limit <= 0) return result;
+
+    // 数据源：自己的发件箱 + 收件箱（推）+ 大 V 好友的发件箱（拉）
+    std::vector<const Timeline*> sources;
+    if (auto it = outboxes.find(userId); it != outboxes.end())
+        sources.push_back(&it->second);
+    if (auto it = inboxes.find(userId); it != inboxes.end())
+        sources.push_back(&it->second);
+    if (auto it = friendsByUser.find(userId); it != friendsByUser.end()) {
+        auto& friends = it->second;
+        if (friends.size() <= pullOutboxes.size()) {
+            for (auto& friendId : friends) {
+                if (auto p = pullOutboxes.find(friendId);
+                    p != pullOutboxes.end())
+                    sources.push_back(&p->second);
+            }
+        } else {
+            for (auto& [authorId, timeline] : pullOutboxes) {
+                if (friends.contains(authorId)) sources.push_back(&timeline);
+            }
+        }
+    }
+
+    // 多路归并：每个数据源从 beforeTs 之前的位置倒序取
+    struct Cursor {
+        int64_t timestamp;
+        std::size_t source;
+        std::size_t pos;
+        bool operator<(const Cursor& other) const {
+            return timestamp < other.timestamp;
+        }
+    };
+    std::priority_queue<Cursor> heap;
+    auto byTs = [](const FeedEntry& e, int64_t ts) { return e.timestamp < ts; };
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        auto& tl = *sources[i];
+        auto end = std::lower_bound(tl.begin(), tl.end(), beforeTs, byTs);
+        if (end != tl.begin()) {
+            auto pos = static_cast<std::size_t>(end - tl.begin()) - 1;
+            heap.push({tl[pos].timestamp, i, pos});
+        }
     }
+
+    while (!heap.empty() && static_cast<int>(result.size()) < limit) {
+        auto top = heap.top();
+        heap.pop();
+        auto& entry = (*sources[top.source])[top.pos];
+        if (auto it = moments.find(entry.momentId); it != moments.end()) {
+            auto& moment = result.emplace_back(it->second);
+            auto& social = interactions[entry.momentId];
+            moment.likedByMe = social.likedBy.contains(userId);
+            auto preview = std::min<std::size_t>(Moment::PreviewComments,
+                                                 social.comments.size());
+            moment.comments.assign(social.comments.begin(),
+                                   social.comments.begin() + preview);
+        }
+        if (top.pos > 0) {
+            auto pos = top.pos - 1;
+            heap.push({(*sources[top.source])[pos].timestamp, top.source, pos});
+        }
+    }
+    return result;
+}
+
+bool MockDataStore::addLike(core::Id momentId, core::Id userId) {
+    std::lock_guard lock(mutex);
+    auto it = moments.find(momentId);
+    if (it == moments.end()) return false;
+    if (!interactions[momentId].likedBy.insert(userId).second) return false;
+    ++it->second.likeCount;
+    return true;
+}
+
+Moment::Comment MockDataStore::addComment(core::Id momentId,
+                                          core::Id authorId,
+                                          const std::string& text) {
+    std::lock_guard lock(mutex);
+    auto it = moments.find(momentId);
+    if (it == moments.end()) return {};
+    auto id = ids.nextString("c");
+    auto ts = ++clock;
+    Moment::Comment comment{id, authorId, text, ts};
+    interactions[momentId].comments.push_back(comment);
+    ++it->second.commentCount;
+    return comment;
+}
+
+std::vector<Moment::Comment> MockDataStore::getComments(
+    core::Id momentId, int64_t afterTs, int limit) {
+    std::lock_guard lock(mutex);
+    std::vector<Moment::Comment> result;
+    auto it = interactions.find(momentId);
+    if (it == interactions.end() || limit <= 0) return result;
+
+    auto& comments = it->second.comments;
+    auto first = std::upper_bound(
+        comments.begin(), comments.end(), afterTs,
+        [](int64_t ts, const Moment::Comment& c) { return ts < c.timestamp; });
+    auto count = std::min<std::ptrdiff_t>(limit, comments.end() - first);
+    result.assign(first, first + count);
     return result;
 }
 
@@ -1,26 +1,37 @@
 #pragma once
 
 #include <wechat/core/Group.h>
+#include <wechat/core/IdGenerator.h>
 #include <wechat/core/Message.h>
 #include <wechat/core/User.h>
 #include <wechat/network/MomentService.h>
+#include "SessionTable.h"
+#include "UserSearchIndex.h"
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 namespace wechat { namespace network {
 /// Mock 服务端内存状态
 /// 所有 MockXxxService 共享同一个 MockDataStore 实例
+///
+/// gRPC 服务端在多个线程上并发调用，因此这里只返回在锁内做好的拷贝 /
+/// 判定结果，不把指向内部容器的指针或引用交给锁外使用。
 class MockDataStore {
 public:
-    MockDataStore();
+    explicit MockDataStore(SessionOptions sessionOptions = {});
 
     // ── 时间 ──
     int64_t now();
 
     // ── ID 生成 ──
+    /// prefix + 定长 Snowflake 字符串，按生成时间排序；不经过全局锁
     std::string nextId(const std::string& prefix);
 
     // ── 用户 / 认证 ──
@@ -30,85 +41,144 @@ public:
         std::string password;
     };
 
-    /// 注册，返回 userId
-    std::string addUser(const std::string& username, const std::string& password);
+    /// 注册，返回 userId（空 = 用户名已存在）
+    core::Id addUser(const std::string& username, const std::string& password);
     /// 验证密码，返回 userId（空 = 失败）
-    std::string authenticate(const std::string& username, const std::string& password);
+    core::Id authenticate(const std::string& username, const std::string& password);
     /// 创建 token
-    std::string createToken(const std::string& userId);
-    /// token -> userId（空 = 无效）
-    std::string resolveToken(const std::string& token);
+    std::string createToken(core::Id userId);
+    /// token -> userId（空 = 无效或已过期）
+    core::Id resolveToken(const std::string& token);
     /// 删除 token
     void removeToken(const std::string& token);
-    /// 查找用户
-    core::User* findUser(const std::string& userId);
-    /// 按关键字搜索用户
-    std::vector<core::User> searchUsers(const std::string& keyword);
+    /// 会话表（自带并发控制，不经过全局锁）
+    SessionTable& sessionTable();
+    /// 查找用户（拷贝）
+    std::optional<core::User> findUser(core::Id userId);
+    /// 按关键字搜索用户（精确 > 前缀 > 子串排序，分页）
+    std::vector<core::User> searchUsers(const std::string& keyword,
+                                        int offset, int limit);
 
     // ── 好友 ──
 
-    void addFriendship(const std::string& a, const std::string& b);
-    void removeFriendship(const std::string& a, const std::string& b);
-    bool areFriends(const std::string& a, const std::string& b);
-    std::vector<std::string> getFriendIds(const std::string& userId);
+    void addFriendship(core::Id a, core::Id b);
+    void removeFriendship(core::Id a, core::Id b);
+    bool areFriends(core::Id a, core::Id b);
+    std::vector<core::Id> getFriendIds(core::Id userId);
 
     // ── 群组 ──
 
-    core::Group& createGroup(const std::string& ownerId,
-                             const std::vector<std::string>& memberIds);
-    core::Group* findGroup(const std::string& groupId);
-    void removeGroup(const std::string& groupId);
-    std::vector<core::Group> getGroupsByUser(const std::string& userId);
+    core::Group createGroup(core::Id ownerId,
+                            const std::vector<core::Id>& memberIds);
+    /// 群的拷贝；只判断成员关系时用 isGroupMember，不必拷贝成员列表
+    std::optional<core::Group> findGroup(core::Id groupId);
+    /// userId 是否为群成员，nullopt = 群不存在
+    std::optional<bool> isGroupMember(core::Id groupId, core::Id userId);
+    void removeGroup(core::Id groupId);
+    /// 添加群成员，返回 false = 群不存在或已是成员
+    bool addGroupMember(core::Id groupId, core::Id userId);
+    /// 移除群成员，返回 false = 群不存在或不是成员
+    bool removeGroupMember(core::Id groupId, core::Id userId);
+    std::vector<core::Group> getGroupsByUser(core::Id userId);
 
     // ── 消息 ──
 
-    core::Message& addMessage(const std::string& senderId,
-                              const std::string& chatId,
-                              const std::string& replyTo,
-                              const core::MessageContent& content);
-    core::Message* findMessage(const std::string& messageId);
-    std::vector<core::Message> getMessages(const std::string& chatId,
-                                           int64_t sinceTs, int limit);
+    core::MessagePtr addMessage(core::Id senderId, core::Id chatId,
+                                core::Id replyTo,
+                                const core::MessageContent& content);
+    /// 当前快照，不存在返回 nullptr
+    core::MessagePtr findMessage(core::Id messageId);
+    /// 写时复制：拷贝当前快照，在锁内执行 edit，再以新快照替换；
+    /// edit 返回 false 时放弃修改。返回新快照，未找到或放弃时返回 nullptr
+    core::MessagePtr updateMessage(
+        core::Id messageId, const std::function<bool(core::Message&)>& edit);
+    /// 返回的是共享快照，不拷贝消息
+    std::vector<core::MessagePtr> getMessages(core::Id chatId, int64_t sinceTs,
+                                              int limit);
 
     // ── 朋友圈 ──
 
-    Moment& addMoment(const std::string& authorId,
-                      const std::string& text,
-                      const std::vector<std::string>& imageIds);
-    Moment* findMoment(const std::string& momentId);
-    std::vector<Moment> getMoments(const std::set<std::string>& visibleUserIds,
-                                   int64_t beforeTs, int limit);
+    Moment addMoment(core::Id authorId, const std::string& text,
+                     const std::vector<std::string>& imageIds);
+    bool hasMoment(core::Id momentId);
+    /// userId 可见的朋友圈（自己 + 好友），timestamp < beforeTs，按时间倒序
+    /// 返回的 Moment 只带点赞 / 评论计数和前 PreviewComments 条评论
+    std::vector<Moment> getFeed(core::Id userId, int64_t beforeTs, int limit);
+    /// 点赞，返回 false = 动态不存在或已点赞
+    bool addLike(core::Id momentId, core::Id userId);
+    /// 评论，返回新评论（动态不存在时 id 为空）
+    Moment::Comment addComment(core::Id momentId, core::Id authorId,
+                               const std::string& text);
+    /// 评论分页：timestamp > afterTs，按时间升序
+    std::vector<Moment::Comment> getComments(core::Id momentId,
+                                             int64_t afterTs, int limit);
+
+    /// 推拉结合阈值：作者好友数不超过该值时发布即推送到好友收件箱，
+    /// 否则只写作者自己的发件箱，由读者拉取
+    static constexpr std::size_t DefaultFeedFanoutThreshold = 500;
+    void setFeedFanoutThreshold(std::size_t threshold);
 
 private:
     std::mutex mutex;
     int64_t clock;
-    int64_t idCounter;
+    // 无锁取号，不需要全局锁
+    core::IdGenerator ids;
 
     // username -> UserRecord
     std::map<std::string, UserRecord> usersByName;
+    // 以下 ID 键均为驻留 core::Id，查找只比较 / 哈希整数句柄
+
     // userId -> username (反向索引)
-    std::map<std::string, std::string> userIdToName;
+    std::unordered_map<core::Id, std::string> userIdToName;
+    // 用户名前缀 / 子串搜索索引
+    UserSearchIndex userSearch;
     // token -> userId
-    std::map<std::string, std::string> tokens;
+    SessionTable sessions;
 
-    // 好友关系 (ordered pair set)
-    std::set<std::pair<std::string, std::string>> friendships;
+    // 好友关系邻接表 userId -> {friendId...}（双向各存一份）
+    std::unordered_map<core::Id, std::set<core::Id>> friendsByUser;
 
     // groupId -> Group
-    std::map<std::string, core::Group> groups;
+    std::unordered_map<core::Id, core::Group> groups;
+    // userId -> {groupId...} (反向索引，随成员变更维护)
+    std::unordered_map<core::Id, std::set<core::Id>> groupsByUser;
+
+    // chatId -> [快照...] (按 timestamp 升序，可二分定位)
+    std::unordered_map<core::Id, std::vector<core::MessagePtr>> chatMessages;
+    // messageId -> 快照在 chatMessages 中的位置（修改时原位替换）
+    struct MessageSlot {
+        core::Id chatId;
+        std::size_t index;
+    };
+    std::unordered_map<core::Id, MessageSlot> messages;
+
+    // momentId -> Moment（comments 字段不在此维护）
+    std::unordered_map<core::Id, Moment> moments;
 
-    // messageId -> Message
-    std::map<std::string, core::Message> messages;
-    // chatId -> [messageId...] (按时间序)
-    std::map<std::string, std::vector<std::string>> chatMessages;
+    // 点赞集合与评论列表与 Moment 分开存储，避免列表页整体拷贝
+    struct MomentInteractions {
+        std::unordered_set<core::Id> likedBy;
+        std::vector<Moment::Comment> comments; // 按时间升序
+    };
+    std::unordered_map<core::Id, MomentInteractions> interactions;
+
+    struct FeedEntry {
+        int64_t timestamp;
+        core::Id momentId;
+        core::Id authorId;
+        bool pushed; // 发布时是否已推送到好友收件箱
+    };
+    using Timeline = std::vector<FeedEntry>; // 按时间升序，追加 O(1)
 
-    // momentId -> Moment
-    std::map<std::string, Moment> moments;
-    // 按时间倒序的 momentId 列表
-    std::vector<std::string> momentTimeline;
+    // authorId -> 作者发布的全部动态
+    std::unordered_map<core::Id, Timeline> outboxes;
+    // authorId -> 未推送、需要读者拉取的动态
+    std::unordered_map<core::Id, Timeline> pullOutboxes;
+    // userId -> 好友推送来的动态
+    std::unordered_map<core::Id, Timeline> inboxes;
+    std::size_t feedFanoutThreshold;
 
-    static std::pair<std::string, std::string> ordered(
-        const std::string& a, const std::string& b);
+    void backfillInbox(core::Id userId, core::Id authorId);
 };
 
 } } // namespace wechat::network
@@ -8,102 +8,104 @@ namespace wechat {
 namespace network {
 
 MockGroupService::MockGroupService(std::shared_ptr<MockDataStore> store)
-    : store(std::move(store)) {}
+    : store(std::move(store)),
+      sessions(this->store->sessionTable(),
+               this->store->sessionTable().options().serviceCacheSlots) {}
 
 Result<core::Group> MockGroupService::createGroup(
     const std::string& token,
     const std::vector<std::string>& memberIds) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    // 确保创建者在成员列表中
-    auto ids = memberIds;
-    if (std::find(ids.begin(), ids.end(), userId) == ids.end())
-        ids.insert(ids.begin(), userId);
+    // 确保创建者在成员列表中（去重由 IdSet 负责）；
+    // 从未出现过的 ID 不可能是已注册用户，直接忽略，不驻留
+    std::vector<core::Id> ids;
+    ids.reserve(memberIds.size() + 1);
+    for (auto& member : memberIds)
+        if (auto id = core::Id::find(member); !id.empty()) ids.push_back(id);
+    ids.push_back(userId);
 
-    auto& group = store->createGroup(userId, ids);
-    return group;
+    return store->createGroup(userId, ids);
 }
 
 VoidResult MockGroupService::dissolveGroup(const std::string& token,
                                            const std::string& groupId) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* group = store->findGroup(groupId);
+    auto group = store->findGroup(core::Id::find(groupId));
     if (!group)
         return {ErrorCode::NotFound, "group not found"};
 
     if (group->ownerId != userId)
         return {ErrorCode::PermissionDenied, "only owner can dissolve"};
 
-    store->removeGroup(groupId);
+    store->removeGroup(group->id);
     return success();
 }
 
 VoidResult MockGroupService::addMember(const std::string& token,
                                        const std::string& groupId,
                                        const std::string& userId) {
-    auto callerId = store->resolveToken(token);
+    auto callerId = sessions.resolve(token);
     if (callerId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* group = store->findGroup(groupId);
+    auto group = store->findGroup(core::Id::find(groupId));
     if (!group)
         return {ErrorCode::NotFound, "group not found"};
 
-    if (!store->findUser(userId))
+    auto memberId = core::Id::find(userId);
+    if (!store->findUser(memberId))
         return {ErrorCode::NotFound, "user not found"};
 
-    auto& m = group->memberIds;
-    if (std::find(m.begin(), m.end(), userId) != m.end())
+    if (!store->addGroupMember(group->id, memberId))
         return {ErrorCode::AlreadyExists, "already a member"};
 
-    m.push_back(userId);
     return success();
 }
 
 VoidResult MockGroupService::removeMember(const std::string& token,
                                           const std::string& groupId,
                                           const std::string& userId) {
-    auto callerId = store->resolveToken(token);
+    auto callerId = sessions.resolve(token);
     if (callerId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* group = store->findGroup(groupId);
+    auto group = store->findGroup(core::Id::find(groupId));
     if (!group)
         return {ErrorCode::NotFound, "group not found"};
 
     if (group->ownerId != callerId)
         return {ErrorCode::PermissionDenied, "only owner can remove members"};
 
-    auto& m = group->memberIds;
-    auto it = std::find(m.begin(), m.end(), userId);
-    if (it == m.end())
+    if (!store->removeGroupMember(group->id, core::Id::find(userId)))
         return {ErrorCode::NotFound, "not a member"};
 
-    m.erase(it);
     return success();
 }
 
 Result<std::vector<std::string>> MockGroupService::listMembers(
     const std::string& token, const std::string& groupId) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* group = store->findGroup(groupId);
+    auto group = store->findGroup(core::Id::find(groupId));
     if (!group)
         return {ErrorCode::NotFound, "group not found"};
 
-    return group->memberIds;
+    // group 是锁内拷贝，并发的 addMember / dissolveGroup 不影响这里的遍历
+    return std::vector<std::string>(group->memberIds.begin(),
+                                    group->memberIds.end());
 }
 
 Result<std::vector<core::Group>> MockGroupService::listMyGroups(
     const std::string& token) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
@@ -2,6 +2,8 @@
 
 #include <wechat/network/GroupService.h>
 
+#include "SessionCache.h"
+
 #include <memory>
 namespace wechat::network {
 
@@ -29,6 +31,7 @@ public:
 
 private:
     std::shared_ptr<MockDataStore> store;
+    SessionCache sessions;
 };
 
 } // namespace wechat::network
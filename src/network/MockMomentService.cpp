@@ -3,80 +3,97 @@
 #include "MockDataStore.h"
 
 #include <algorithm>
-#include <set>
 
 namespace wechat {
 namespace network {
 
 MockMomentService::MockMomentService(std::shared_ptr<MockDataStore> store)
-    : store(std::move(store)) {}
+    : store(std::move(store)),
+      sessions(this->store->sessionTable(),
+               this->store->sessionTable().options().serviceCacheSlots) {}
 
 Result<Moment> MockMomentService::postMoment(
     const std::string& token, const std::string& text,
     const std::vector<std::string>& imageIds) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
     if (text.empty() && imageIds.empty())
         return {ErrorCode::InvalidArgument, "moment must have text or images"};
 
-    auto& moment = store->addMoment(userId, text, imageIds);
-    return moment;
+    return store->addMoment(userId, text, imageIds);
 }
 
 Result<std::vector<Moment>> MockMomentService::listMoments(
     const std::string& token, int64_t beforeTs, int limit) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    // 可见范围：自己 + 好友
-    auto friendIds = store->getFriendIds(userId);
-    std::set<std::string> visible(friendIds.begin(), friendIds.end());
-    visible.insert(userId);
-
-    return store->getMoments(visible, beforeTs, limit);
+    // 可见范围：自己 + 好友（由 store 的收件箱 / 发件箱维护）
+    return store->getFeed(userId, beforeTs, limit);
 }
 
 VoidResult MockMomentService::likeMoment(const std::string& token,
                                          const std::string& momentId) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* moment = store->findMoment(momentId);
-    if (!moment)
+    auto id = core::Id::find(momentId);
+    if (!store->hasMoment(id))
         return {ErrorCode::NotFound, "moment not found"};
 
-    auto& likes = moment->likedBy;
-    if (std::find(likes.begin(), likes.end(), userId) != likes.end())
+    if (!store->addLike(id, userId))
         return {ErrorCode::AlreadyExists, "already liked"};
 
-    likes.push_back(userId);
     return success();
 }
 
 Result<Moment::Comment> MockMomentService::commentMoment(
     const std::string& token, const std::string& momentId,
     const std::string& text) {
-    auto userId = store->resolveToken(token);
+    auto userId = sessions.resolve(token);
     if (userId.empty())
         return {ErrorCode::Unauthorized, "invalid token"};
 
-    auto* moment = store->findMoment(momentId);
-    if (!moment)
+    auto id = core::Id::find(momentId);
+    if (!store->hasMoment(id))
         return {ErrorCode::NotFound, "moment not found"};
 
     if (text.empty())
         return {ErrorCode::InvalidArgument, "comment text required"};
 
-    auto commentId = store->nextId("c");
-    auto ts = store->now();
-    Moment::Comment comment{commentId, userId, text, ts};
-    moment->comments.push_back(comment);
+    auto comment = store->addComment(id, userId, text);
+    if (comment.id.empty())
+        return {ErrorCode::NotFound, "moment not found"};
+
     return comment;
 }
 
+Result<ListCommentsResponse> MockMomentService::listComments(
+    const std::string& token, const std::string& momentId, int64_t afterTs,
+    int limit) {
+    auto userId = sessions.resolve(token);
+    if (userId.empty())
+        return {ErrorCode::Unauthorized, "invalid token"};
+
+    if (limit <= 0)
+        return {ErrorCode::InvalidArgument, "invalid page"};
+
+    auto id = core::Id::find(momentId);
+    if (!store->hasMoment(id))
+        return {ErrorCode::NotFound, "moment not found"};
+
+    // limit 来自客户端，先钳到单页上限，多取一条判断 hasMore 时不会溢出
+    limit = std::min(limit, MaxCommentPage);
+    auto comments = store->getComments(id, afterTs, limit + 1);
+    bool hasMore = static_cast<int>(comments.size()) > limit;
+    if (hasMore) comments.pop_back();
+
+    return ListCommentsResponse{std::move(comments), hasMore};
+}
+
 } // namespace network
 } // namespace wechat
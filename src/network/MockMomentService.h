@@ -2,6 +2,8 @@
 
 #include <wechat/network/MomentService.h>
 
+#include "SessionCache.h"
+
 #include <memory>
 namespace wechat::network {
 
@@ -21,9 +23,13 @@ public:
     Result<Moment::Comment> commentMoment(
         const std::string& token, const std::string& momentId,
         const std::string& text) override;
+    Result<ListCommentsResponse> listComments(
+        const std::string& token, const std::string& momentId,
+        int64_t afterTs, int limit) override;
 
 private:
     std::shared_ptr<MockDataStore> store;
+    SessionCache sessions;
 };
 
 } // namespace wechat::network
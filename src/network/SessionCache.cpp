@@ -0,0 +1,40 @@
+#include "SessionCache.h"
+
+#include <wechat/log/Trace.h>
+
+#include <functional>
+
+namespace wechat {
+namespace network {
+
+SessionCache::SessionCache(SessionTable& table, std::size_t slots)
+    : table(table), slots(slots) {}
+
+SessionCache::~SessionCache() {
+    for (auto& slot : slots) delete slot.load();
+}
+
+core::Id SessionCache::resolve(const std::string& token) {
+    WECHAT_TRACE_SCOPE("SessionCache::resolve", "network");
+    if (slots.empty()) return table.resolve(token);
+
+    auto& slot = slots[std::hash<std::string>{}(token) % slots.size()];
+    auto guard = domain.pin();
+    auto* entry = slot.load(std::memory_order_acquire);
+    if (entry && entry->token == token) {
+        if (!table.touch(*entry->session)) return {};
+        return entry->session->userId;
+    }
+
+    // 未命中：查会话表后换入新缓存项，换下的旧项延迟释放
+    auto session = table.find(token);
+    if (!session || !table.touch(*session)) return {};
+    auto userId = session->userId;
+    auto* replaced = slot.exchange(new Entry{token, std::move(session)},
+                                   std::memory_order_acq_rel);
+    if (replaced) domain.retire(replaced);
+    return userId;
+}
+
+} // namespace network
+} // namespace wechat
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "SessionTable.h"
+
+#include <wechat/core/Rcu.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace wechat {
+namespace network {
+
+/// 单个服务内的 token 解析缓存（直接映射）
+///
+/// 命中时跳过会话表的分片查找，只做失效与过期校验；命中路径不加锁，
+/// 槽位是指向不可变缓存项的原子指针，被替换的缓存项延迟到没有读者时释放。
+/// 会话被删除或回收时只有持有它的缓存项失效（Session::revoked），
+/// 其他缓存项不受影响。slots = 0 时直接透传。
+class SessionCache {
+public:
+    SessionCache(SessionTable& table, std::size_t slots);
+    ~SessionCache();
+
+    SessionCache(SessionCache const&) = delete;
+    SessionCache& operator=(SessionCache const&) = delete;
+
+    /// 与 SessionTable::resolve 语义一致
+    core::Id resolve(const std::string& token);
+
+private:
+    struct Entry {
+        std::string token;
+        std::shared_ptr<SessionTable::Session> session;
+    };
+
+    SessionTable& table;
+    core::EpochDomain domain;
+    std::vector<std::atomic<Entry*>> slots;
+};
+
+} // namespace network
+} // namespace wechat
@@ -0,0 +1,251 @@
+#include "SessionTable.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace wechat {
+namespace network {
+
+namespace {
+
+int64_t steadyNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+SessionTable::SessionTable(SessionOptions options, Clock clock)
+    : opts(options), clock(clock ? std::move(clock) : steadyNowMs),
+      wheel(toTick(this->clock())) {}
+
+SessionTable::~SessionTable() {
+    std::lock_guard lock(collectMutex);
+    if (pendingCollect.valid()) pendingCollect.wait();
+}
+
+SessionTable::Buckets::Buckets(std::size_t count)
+    : mask(count - 1), heads(new std::atomic<Node*>[count]) {
+    for (std::size_t i = 0; i < count; ++i) heads[i].store(nullptr);
+}
+
+SessionTable::Buckets::~Buckets() {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        for (auto* node = heads[i].load(); node;) {
+            auto* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+}
+
+std::size_t SessionTable::hashOf(const std::string& token) {
+    return std::hash<std::string>{}(token);
+}
+
+SessionTable::Shard& SessionTable::shardFor(std::size_t hash) const {
+    return shards[hash % ShardCount];
+}
+
+SessionTable::Node* SessionTable::lookup(const Buckets& buckets,
+                                         std::size_t hash,
+                                         const std::string& token) {
+    auto& head = buckets.heads[(hash / ShardCount) & buckets.mask];
+    for (auto* node = head.load(std::memory_order_acquire); node;
+         node = node->next.load(std::memory_order_acquire)) {
+        if (node->token == token) return node;
+    }
+    return nullptr;
+}
+
+void SessionTable::grow(Shard& shard) {
+    auto* old = shard.buckets.load(std::memory_order_relaxed);
+    auto* next = new Buckets((old->mask + 1) * 2);
+    // 读者可能正在旧链上遍历，节点复制到新表而不是改挂
+    for (std::size_t i = 0; i <= old->mask; ++i) {
+        for (auto* node = old->heads[i].load(std::memory_order_relaxed); node;
+             node = node->next.load(std::memory_order_relaxed)) {
+            auto& head =
+                next->heads[(hashOf(node->token) / ShardCount) & next->mask];
+            auto* copy = new Node{node->token, node->session};
+            copy->next.store(head.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+            head.store(copy, std::memory_order_relaxed);
+        }
+    }
+    shard.buckets.store(next, std::memory_order_release);
+    domain.retire(old);
+}
+
+bool SessionTable::unlink(Shard& shard, std::size_t hash,
+                          const std::string& token) {
+    auto& buckets = *shard.buckets.load(std::memory_order_relaxed);
+    auto* link = &buckets.heads[(hash / ShardCount) & buckets.mask];
+    for (auto* node = link->load(std::memory_order_relaxed); node;
+         link = &node->next, node = link->load(std::memory_order_relaxed)) {
+        if (node->token != token) continue;
+        // 正在遍历该节点的读者仍能沿 next 走完，节点等读者离开后再释放
+        link->store(node->next.load(std::memory_order_relaxed),
+                    std::memory_order_release);
+        node->session->revoked.store(true, std::memory_order_release);
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+        domain.retire(node);
+        return true;
+    }
+    return false;
+}
+
+int64_t SessionTable::deadlineOf(const Session& session) const {
+    return std::min(session.expiresAt,
+                    session.lastSeen.load(std::memory_order_relaxed) +
+                        opts.idleTimeout.count());
+}
+
+uint64_t SessionTable::toTick(int64_t ms) const {
+    auto tickMs = std::max<int64_t>(opts.tick.count(), 1);
+    return ms <= 0 ? 0 : static_cast<uint64_t>((ms + tickMs - 1) / tickMs);
+}
+
+bool SessionTable::expired(const Session& session, int64_t now) const {
+    return now >= deadlineOf(session);
+}
+
+std::string SessionTable::create(core::Id userId) {
+    auto now = clock();
+    auto seq = ++tokenCounter;
+    auto token = "tok_" + std::to_string(seq);
+    auto session = std::make_shared<Session>();
+    session->userId = userId;
+    session->expiresAt = now + opts.ttl.count();
+    session->lastSeen.store(now, std::memory_order_relaxed);
+    auto deadline = deadlineOf(*session);
+
+    auto hash = hashOf(token);
+    auto& shard = shardFor(hash);
+    {
+        std::lock_guard lock(shard.writeMutex);
+        if (shard.count.load(std::memory_order_relaxed) >=
+            shard.buckets.load(std::memory_order_relaxed)->mask + 1)
+            grow(shard);
+        auto& buckets = *shard.buckets.load(std::memory_order_relaxed);
+        auto& head = buckets.heads[(hash / ShardCount) & buckets.mask];
+        auto* node = new Node{token, std::move(session)};
+        node->next.store(head.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+        head.store(node, std::memory_order_release);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(wheelMutex);
+        wheel.schedule(token, toTick(deadline));
+    }
+    // 回收摊到写路径上，读路径不做任何清理
+    if (seq % CollectInterval == 0) scheduleCollect();
+    return token;
+}
+
+void SessionTable::scheduleCollect() {
+    if (!opts.executor) {
+        collectExpired();
+        return;
+    }
+    std::lock_guard lock(collectMutex);
+    if (pendingCollect.valid() &&
+        pendingCollect.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready)
+        return;
+    pendingCollect = opts.executor->submit([this] { collectExpired(); },
+                                           core::TaskPriority::Low);
+}
+
+std::shared_ptr<SessionTable::Session> SessionTable::find(
+    const std::string& token) const {
+    auto hash = hashOf(token);
+    auto& shard = shardFor(hash);
+    auto guard = domain.pin();
+    auto* node =
+        lookup(*shard.buckets.load(std::memory_order_acquire), hash, token);
+    return node ? node->session : nullptr;
+}
+
+bool SessionTable::touch(Session& session) {
+    if (session.revoked.load(std::memory_order_acquire)) return false;
+    auto now = clock();
+    if (expired(session, now)) return false;
+    session.lastSeen.store(now, std::memory_order_relaxed);
+    return true;
+}
+
+core::Id SessionTable::resolve(const std::string& token) {
+    // 热路径：不加锁，也不复制 shared_ptr（不碰共享的引用计数）
+    auto hash = hashOf(token);
+    auto& shard = shardFor(hash);
+    auto guard = domain.pin();
+    auto* node =
+        lookup(*shard.buckets.load(std::memory_order_acquire), hash, token);
+    if (!node || !touch(*node->session)) return {};
+    return node->session->userId;
+}
+
+void SessionTable::remove(const std::string& token) {
+    auto hash = hashOf(token);
+    auto& shard = shardFor(hash);
+    std::lock_guard lock(shard.writeMutex);
+    unlink(shard, hash, token);
+}
+
+std::size_t SessionTable::collectExpired() {
+    auto now = clock();
+    std::vector<std::string> fired;
+    {
+        std::lock_guard lock(wheelMutex);
+        fired = wheel.advance(toTick(now));
+    }
+    if (fired.empty()) return 0;
+
+    // 按分片归并，每个分片只加一次写锁
+    std::map<Shard*, std::vector<std::pair<std::size_t, std::string>>> byShard;
+    for (auto& token : fired) {
+        auto hash = hashOf(token);
+        byShard[&shardFor(hash)].emplace_back(hash, std::move(token));
+    }
+
+    std::size_t collected = 0;
+    std::vector<std::pair<std::string, int64_t>> reschedule;
+    for (auto& [shard, tokens] : byShard) {
+        std::lock_guard lock(shard->writeMutex);
+        auto& buckets = *shard->buckets.load(std::memory_order_relaxed);
+        for (auto& [hash, token] : tokens) {
+            auto* node = lookup(buckets, hash, token);
+            if (!node) continue; // 已被 remove
+            if (!expired(*node->session, now)) {
+                // 期间有访问，按新的空闲截止时间重新排队
+                reschedule.emplace_back(std::move(token),
+                                        deadlineOf(*node->session));
+                continue;
+            }
+            unlink(*shard, hash, token);
+            ++collected;
+        }
+    }
+
+    if (!reschedule.empty()) {
+        std::lock_guard lock(wheelMutex);
+        for (auto& [token, deadline] : reschedule) {
+            wheel.schedule(std::move(token), toTick(deadline));
+        }
+    }
+    return collected;
+}
+
+std::size_t SessionTable::size() const {
+    std::size_t total = 0;
+    for (auto& shard : shards)
+        total += shard.count.load(std::memory_order_relaxed);
+    return total;
+}
+
+} // namespace network
+} // namespace wechat
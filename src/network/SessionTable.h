@@ -0,0 +1,149 @@
+#pragma once
+
+#include "TimingWheel.h"
+
+#include <wechat/core/Executor.h>
+#include <wechat/core/Id.h>
+#include <wechat/core/Rcu.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace wechat {
+namespace network {
+
+struct SessionOptions {
+    /// 绝对有效期：创建后超过 ttl 即失效
+    std::chrono::milliseconds ttl = std::chrono::hours(24 * 7);
+    /// 空闲超时：超过 idleTimeout 未被 resolve 即失效
+    std::chrono::milliseconds idleTimeout = std::chrono::hours(24);
+    /// 时间轮精度
+    std::chrono::milliseconds tick = std::chrono::seconds(1);
+    /// 每个 Mock 服务内 SessionCache 的槽数，0 = 不启用缓存
+    std::size_t serviceCacheSlots = 0;
+    /// 非空时写路径上的周期回收以 Low 优先级投递到该线程池，不阻塞 create；
+    /// 线程池必须比 SessionTable 活得久
+    core::Executor* executor = nullptr;
+};
+
+/// token -> userId 会话表
+///
+/// - 按 token 哈希分片，每个分片是一张拉链哈希表：读路径不加锁，
+///   在 EpochDomain 登记后沿原子指针查找，写路径只锁一个分片的写锁并
+///   原地挂链 / 摘链，不复制其他会话；摘下的节点延迟到没有读者时释放
+/// - 桶数按负载翻倍：新桶表复制节点后整体替换，旧桶表同样延迟释放
+/// - 删除或回收的会话打上 revoked 标记，持有它的缓存项逐个失效
+/// - 过期与空闲超时由分层时间轮驱动回收；resolve 时也会校验时间，
+///   所以回收的及时性不影响正确性
+class SessionTable {
+public:
+    /// 时间源，返回毫秒
+    using Clock = std::function<int64_t()>;
+
+    struct Session {
+        core::Id userId;
+        int64_t expiresAt;
+        std::atomic<int64_t> lastSeen;
+        /// 已被删除或回收；SessionCache 中的旧引用据此失效
+        std::atomic<bool> revoked{false};
+    };
+
+    explicit SessionTable(SessionOptions options = {}, Clock clock = {});
+    /// 等待已投递的回收任务结束
+    ~SessionTable();
+
+    SessionTable(SessionTable const &) = delete;
+    SessionTable &operator=(SessionTable const &) = delete;
+
+    /// 创建会话，返回 token
+    std::string create(core::Id userId);
+    /// token -> userId（空 = 无效或已过期），并刷新空闲计时
+    core::Id resolve(const std::string& token);
+    /// 删除会话
+    void remove(const std::string& token);
+
+    /// 查找会话记录（不校验过期，供 SessionCache 使用）
+    std::shared_ptr<Session> find(const std::string& token) const;
+    /// 校验会话是否仍有效（未删除、未过期），有效则刷新空闲计时
+    bool touch(Session& session);
+
+    /// 推进时间轮并回收到期会话，返回回收数量
+    std::size_t collectExpired();
+
+    /// 当前会话数（含尚未回收的过期会话）
+    [[nodiscard]] std::size_t size() const;
+
+    [[nodiscard]] const SessionOptions& options() const { return opts; }
+
+private:
+    static constexpr std::size_t ShardCount = 64;
+    /// 每创建这么多会话顺带推进一次时间轮
+    static constexpr uint64_t CollectInterval = 64;
+
+    /// 初始桶数；会话数超过桶数时翻倍
+    static constexpr std::size_t InitialBuckets = 16;
+
+    /// 链表节点，发布后只有 next 会变
+    struct Node {
+        std::string token;
+        std::shared_ptr<Session> session;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    struct Buckets {
+        explicit Buckets(std::size_t count);
+        /// 释放仍挂在链上的节点（已摘下的节点单独退休）
+        ~Buckets();
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Node*>[]> heads;
+    };
+
+    struct alignas(64) Shard {
+        Shard() : buckets(new Buckets(InitialBuckets)) {}
+        ~Shard() { delete buckets.load(); }
+
+        std::mutex writeMutex;
+        std::atomic<Buckets*> buckets;
+        std::atomic<std::size_t> count{0};
+    };
+
+    static std::size_t hashOf(const std::string& token);
+    Shard& shardFor(std::size_t hash) const;
+    /// 调用方需持有 domain 的 Guard 或分片写锁
+    static Node* lookup(const Buckets& buckets, std::size_t hash,
+                        const std::string& token);
+    /// 持有分片写锁时调用：摘下 token 并退休节点，返回是否存在
+    bool unlink(Shard& shard, std::size_t hash, const std::string& token);
+    /// 持有分片写锁时调用：桶数翻倍
+    void grow(Shard& shard);
+    int64_t deadlineOf(const Session& session) const;
+    uint64_t toTick(int64_t ms) const;
+    bool expired(const Session& session, int64_t now) const;
+    /// 写路径触发的回收：有线程池则投递，否则就地执行
+    void scheduleCollect();
+
+    SessionOptions opts;
+    Clock clock;
+    // 读路径的登记与摘下节点 / 旧桶表的延迟释放
+    core::EpochDomain domain;
+    mutable std::array<Shard, ShardCount> shards;
+    std::atomic<uint64_t> tokenCounter{0};
+
+    std::mutex wheelMutex;
+    TimingWheel wheel;
+
+    // 同一时间最多一个回收任务在排队或执行
+    std::mutex collectMutex;
+    std::future<void> pendingCollect;
+};
+
+} // namespace network
+} // namespace wechat
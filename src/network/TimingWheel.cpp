@@ -0,0 +1,62 @@
+#include "TimingWheel.h"
+
+namespace wechat {
+namespace network {
+
+TimingWheel::TimingWheel(uint64_t startTick) : current(startTick), count(0) {}
+
+void TimingWheel::schedule(std::string key, uint64_t deadlineTick) {
+    ++count;
+    place(Timer{std::move(key), deadlineTick});
+}
+
+void TimingWheel::place(Timer timer) {
+    if (timer.deadline <= current) timer.deadline = current + 1;
+
+    auto delta = timer.deadline - current;
+    int level = 0;
+    while (level < Levels - 1 &&
+           delta >= (uint64_t{1} << (LevelBits * (level + 1)))) {
+        ++level;
+    }
+    // 超出最高层范围的定时器先落在最高层，cascade 时会被重新放置
+    auto slot = (timer.deadline >> (LevelBits * level)) & (SlotsPerLevel - 1);
+    wheels[level][slot].push_back(std::move(timer));
+}
+
+std::vector<std::string> TimingWheel::advance(uint64_t nowTick) {
+    std::vector<std::string> fired;
+
+    while (current < nowTick) {
+        if (count == 0) {
+            current = nowTick;
+            break;
+        }
+        ++current;
+
+        // 从最高的对齐层开始逐层下放
+        int top = 0;
+        while (top < Levels - 1 &&
+               (current & ((uint64_t{1} << (LevelBits * (top + 1))) - 1)) ==
+                   0) {
+            ++top;
+        }
+        for (int level = top; level >= 0; --level) {
+            auto slot = (current >> (LevelBits * level)) & (SlotsPerLevel - 1);
+            auto timers = std::move(wheels[level][slot]);
+            wheels[level][slot].clear();
+            for (auto& timer : timers) {
+                if (timer.deadline <= current) {
+                    fired.push_back(std::move(timer.key));
+                    --count;
+                } else {
+                    place(std::move(timer));
+                }
+            }
+        }
+    }
+    return fired;
+}
+
+} // namespace network
+} // namespace wechat
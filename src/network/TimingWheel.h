@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wechat {
+namespace network {
+
+/// 分层时间轮（非线程安全，调用方负责加锁）
+///
+/// Levels 层，每层 2^LevelBits 个槽。定时器按剩余 tick 数放入对应层，
+/// 低层转满一圈时把上一层的当前槽下放（cascade）。schedule 为 O(1)，
+/// advance 的开销与经过的 tick 数和到期定时器数成正比。
+///
+/// 不支持取消：到期后由调用方检查 key 对应的状态是否仍然有效。
+class TimingWheel {
+public:
+    static constexpr int LevelBits = 6;
+    static constexpr int Levels = 4;
+    static constexpr std::size_t SlotsPerLevel = std::size_t{1} << LevelBits;
+
+    explicit TimingWheel(uint64_t startTick = 0);
+
+    /// 在 deadlineTick 到期；已过期的定时器在下一个 tick 触发
+    void schedule(std::string key, uint64_t deadlineTick);
+
+    /// 推进到 nowTick，返回所有到期的 key
+    std::vector<std::string> advance(uint64_t nowTick);
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] uint64_t currentTick() const { return current; }
+
+private:
+    struct Timer {
+        std::string key;
+        uint64_t deadline;
+    };
+
+    void place(Timer timer);
+
+    std::array<std::array<std::vector<Timer>, SlotsPerLevel>, Levels> wheels;
+    uint64_t current;
+    std::size_t count;
+};
+
+} // namespace network
+} // namespace wechat
@@ -0,0 +1,109 @@
+#include "UserSearchIndex.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace wechat {
+namespace network {
+
+uint32_t UserSearchIndex::ngramKey(std::string_view gram) {
+    uint32_t key = 0;
+    for (char c : gram) key = (key << 8) | static_cast<unsigned char>(c);
+    return key;
+}
+
+void UserSearchIndex::add(const std::string& userId,
+                          const std::string& username) {
+    auto ordinal = static_cast<uint32_t>(entries.size());
+    auto& entry = entries.emplace_back(Entry{userId, username});
+    byName.emplace(entry.username, ordinal);
+    byId.emplace(entry.userId, ordinal);
+    addNgrams(nameNgrams, username, ordinal);
+    addNgrams(idNgrams, userId, ordinal);
+}
+
+void UserSearchIndex::addNgrams(NgramIndex& index, std::string_view text,
+                                uint32_t ordinal) {
+    if (text.size() < NgramSize) return;
+    std::vector<uint32_t> keys;
+    keys.reserve(text.size() - NgramSize + 1);
+    for (std::size_t i = 0; i + NgramSize <= text.size(); ++i)
+        keys.push_back(ngramKey(text.substr(i, NgramSize)));
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (auto key : keys) index[key].push_back(ordinal);
+}
+
+const std::vector<uint32_t>*
+UserSearchIndex::candidates(const NgramIndex& index, std::string_view keyword) {
+    const std::vector<uint32_t>* shortest = nullptr;
+    for (std::size_t i = 0; i + NgramSize <= keyword.size(); ++i) {
+        auto it = index.find(ngramKey(keyword.substr(i, NgramSize)));
+        if (it == index.end()) return nullptr;
+        if (!shortest || it->second.size() < shortest->size())
+            shortest = &it->second;
+    }
+    return shortest;
+}
+
+std::vector<std::string> UserSearchIndex::search(std::string_view keyword,
+                                                 int offset,
+                                                 int limit) const {
+    std::vector<std::string> result;
+    if (keyword.empty() || offset < 0 || limit <= 0) return result;
+
+    auto need = static_cast<std::size_t>(offset) + limit;
+    std::vector<uint32_t> ranked;
+    std::unordered_set<uint32_t> seen;
+    auto take = [&](uint32_t ordinal) {
+        if (seen.insert(ordinal).second) ranked.push_back(ordinal);
+    };
+
+    // 1. 精确匹配
+    if (auto it = byId.find(keyword); it != byId.end()) take(it->second);
+    if (auto it = byName.find(keyword); it != byName.end()) take(it->second);
+
+    // 2. 前缀匹配：有序扫描，凑够一页即停
+    for (auto it = byName.lower_bound(keyword);
+         it != byName.end() && ranked.size() < need &&
+         it->first.starts_with(keyword);
+         ++it) {
+        take(it->second);
+    }
+
+    // 3. 子串匹配：取最短的 trigram 倒排表作为候选，再逐个校验；
+    //    先用户名后 userId，已入选的用户不重复
+    auto substring = [&](const NgramIndex& index, auto field) {
+        if (ranked.size() >= need || keyword.size() < NgramSize) return;
+        auto* shortest = candidates(index, keyword);
+        if (!shortest) return;
+
+        std::vector<uint32_t> matches;
+        for (auto ordinal : *shortest) {
+            if (!seen.contains(ordinal) &&
+                std::string_view(entries[ordinal].*field).find(keyword) !=
+                    std::string_view::npos)
+                matches.push_back(ordinal);
+        }
+        std::sort(matches.begin(), matches.end(),
+                  [this](uint32_t a, uint32_t b) {
+                      return entries[a].username < entries[b].username;
+                  });
+        for (auto ordinal : matches) {
+            if (ranked.size() >= need) break;
+            take(ordinal);
+        }
+    };
+    substring(nameNgrams, &Entry::username);
+    substring(idNgrams, &Entry::userId);
+
+    auto begin = std::min<std::size_t>(offset, ranked.size());
+    auto end = std::min(need, ranked.size());
+    result.reserve(end - begin);
+    for (auto i = begin; i < end; ++i)
+        result.push_back(entries[ranked[i]].userId);
+    return result;
+}
+
+} // namespace network
+} // namespace wechat
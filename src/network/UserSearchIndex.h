@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wechat {
+namespace network {
+
+/// 用户搜索索引（Mock 服务端使用，调用方负责加锁）
+///
+/// - 前缀索引：按用户名有序的 map，lower_bound 后顺序扫描即为前缀子树，
+///   效果等同前缀 trie，且内存紧凑
+/// - n-gram 索引：用户名与 userId 各一份 trigram -> 用户序号倒排表，
+///   用于子串匹配
+///
+/// 排序规则：userId / 用户名精确匹配 > 用户名前缀匹配 > 用户名子串匹配
+/// > userId 子串匹配，同一档内按用户名字典序。子串匹配要求关键字至少
+/// NgramSize 个字符。
+class UserSearchIndex {
+public:
+    static constexpr std::size_t NgramSize = 3;
+
+    void add(const std::string& userId, const std::string& username);
+
+    /// 按相关度排序分页搜索，返回 userId 列表
+    std::vector<std::string> search(std::string_view keyword, int offset,
+                                    int limit) const;
+
+    std::size_t size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        std::string userId;
+        std::string username;
+    };
+
+    using NgramIndex = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+    static uint32_t ngramKey(std::string_view gram);
+    static void addNgrams(NgramIndex& index, std::string_view text,
+                          uint32_t ordinal);
+    /// keyword 各 trigram 中最短的倒排表；有 trigram 不存在时为 nullptr
+    static const std::vector<uint32_t>* candidates(const NgramIndex& index,
+                                                   std::string_view keyword);
+
+    // 序号 -> Entry；deque 保证元素地址稳定，索引中的 string_view 不会失效
+    std::deque<Entry> entries;
+    // username -> 序号（有序，用于精确 / 前缀查找）
+    std::map<std::string_view, uint32_t, std::less<>> byName;
+    // userId -> 序号
+    std::unordered_map<std::string_view, uint32_t> byId;
+    // trigram -> [序号...]（升序，无重复）
+    NgramIndex nameNgrams;
+    NgramIndex idNgrams;
+};
+
+} // namespace network
+} // namespace wechat
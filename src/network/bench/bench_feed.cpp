@@ -0,0 +1,59 @@
+// 朋友圈 feed 性能基准
+//
+// 全局动态数不断增长时，单个读者（50 个好友，其中 1 个大 V）拉取一页
+// feed 的耗时应保持平稳。
+
+#include "MockDataStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace wechat::network;
+using wechat::core::Id;
+
+namespace {
+
+constexpr int UserCount = 10'000;
+constexpr int FriendsPerReader = 50;
+constexpr int StarFollowers = 2'000;
+constexpr int PageSize = 20;
+constexpr int Iterations = 2000;
+
+double measureFeed(MockDataStore& store) {
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        sink += store.getFeed(Id("reader"), INT64_MAX, PageSize).size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (sink == 0) std::printf("unexpected empty feed\n");
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           Iterations;
+}
+
+} // namespace
+
+int main() {
+    MockDataStore store;
+
+    for (int i = 0; i < FriendsPerReader; ++i)
+        store.addFriendship(Id("reader"), Id("u" + std::to_string(i)));
+    // 大 V：好友数超过推送阈值，发布走拉模式
+    for (int i = 0; i < StarFollowers; ++i)
+        store.addFriendship(Id("star"), Id("u" + std::to_string(i)));
+    store.addFriendship(Id("star"), Id("reader"));
+
+    std::printf("%-16s %14s\n", "global moments", "feed (us/op)");
+    int posted = 0;
+    for (int target : {10'000, 100'000, 1'000'000}) {
+        for (; posted < target; ++posted) {
+            auto author = posted % 100 == 0
+                              ? std::string("star")
+                              : "u" + std::to_string(posted % UserCount);
+            store.addMoment(Id(author), "post", {});
+        }
+        std::printf("%-16d %14.2f\n", target, measureFeed(store));
+    }
+    return 0;
+}
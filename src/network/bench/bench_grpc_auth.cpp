@@ -0,0 +1,133 @@
+// AuthService 调用开销：直接调用 Mock / gRPC 进程内 channel / gRPC TCP 回环
+//
+// 三者服务端逻辑相同（MockAuthService over MockDataStore），差值即
+// protobuf 序列化、gRPC 调度与网络栈的开销。
+//
+// --keepalive：另外检查空闲连接在不同 keepalive 配置下能否存活
+// （每项要空闲数秒，不放进单元测试）。
+
+#include "GrpcLocalServer.h"
+#include "GrpcNetworkClient.h"
+#include "MockAuthService.h"
+#include "auth.pb.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace wechat::network;
+
+namespace {
+
+constexpr int Calls = 20'000;
+
+template <typename Fn> double nsPerCall(int calls, Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+/// getCurrentUser 是最轻的服务端操作，耗时基本都在调用路径上
+double measure(AuthService &auth, const std::string &token, int &failures) {
+    for (int i = 0; i < 200; ++i) auth.getCurrentUser(token); // 预热连接
+    return nsPerCall(Calls, [&](int) {
+        if (!auth.getCurrentUser(token).ok()) ++failures;
+    });
+}
+
+/// 调用一次建立连接，空闲 idle 后返回连接是否仍然保持
+bool survivesIdle(GrpcLocalServer &server, const GrpcChannelOptions &options,
+                  std::chrono::milliseconds idle) {
+    auto channel = createGrpcChannel(server.address(), options);
+    GrpcNetworkClient client(channel, options);
+    // 用户不存在也是一次完整的往返，连接已建立
+    if (client.auth().login("nobody", "x").error().code !=
+        ErrorCode::Unauthorized)
+        return false;
+    std::this_thread::sleep_for(idle);
+    // 被服务端以 GOAWAY 断开后 channel 回到 IDLE，不会自己重连
+    return channel->GetState(false) == GRPC_CHANNEL_READY;
+}
+
+/// 返回与预期不符的项数
+int checkKeepalive() {
+    GrpcChannelOptions aggressive;
+    aggressive.keepaliveTime = std::chrono::milliseconds(100);
+    aggressive.keepaliveWithoutCalls = true;
+    GrpcServerOptions permissive;
+    permissive.permitKeepaliveWithoutCalls = true;
+    permissive.minPingInterval = std::chrono::milliseconds(50);
+
+    GrpcLocalServer strict; // 不加任何 keepalive 相关的服务端参数
+    GrpcLocalServer relaxed(std::make_shared<MockDataStore>(), permissive);
+    if (!strict.running() || !relaxed.running()) return 1;
+
+    // 客户端 ping 最快每秒一次，默认服务端第三次违规时发 GOAWAY
+    constexpr auto Idle = std::chrono::milliseconds(4000);
+    struct Case {
+        const char *name;
+        GrpcLocalServer &server;
+        GrpcChannelOptions options;
+        bool expected;
+    } cases[] = {
+        {"defaults, default server", strict, {}, true},
+        {"aggressive, default server", strict, aggressive, false},
+        {"aggressive, permissive server", relaxed, aggressive, true},
+    };
+
+    std::printf("keepalive idle survival (%lld ms idle)\n",
+                static_cast<long long>(Idle.count()));
+    int mismatches = 0;
+    for (auto &c : cases) {
+        auto alive = survivesIdle(c.server, c.options, Idle);
+        if (alive != c.expected) ++mismatches;
+        std::printf("  %-30s %-6s %s\n", c.name, alive ? "alive" : "closed",
+                    alive == c.expected ? "ok" : "UNEXPECTED");
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    auto store = std::make_shared<MockDataStore>();
+    GrpcLocalServer server(store);
+    if (!server.running()) return 1;
+
+    MockAuthService direct(store);
+    auto token = direct.registerUser("bench", "pass").value().token;
+
+    GrpcNetworkClient inProcess(server.inProcessChannel());
+    GrpcNetworkClient loopback(server.address());
+
+    int failures = 0;
+    auto directNs = measure(direct, token, failures);
+    auto inProcessNs = measure(inProcess.auth(), token, failures);
+    auto loopbackNs = measure(loopback.auth(), token, failures);
+
+    // 仅序列化：一次请求 + 一次响应的编解码
+    wechat::auth::LoginResponse response;
+    response.set_user_id("u_000123");
+    response.set_token(token);
+    std::string wire;
+    wechat::auth::LoginResponse parsed;
+    auto codecNs = nsPerCall(Calls * 10, [&](int) {
+        response.SerializeToString(&wire);
+        parsed.ParseFromString(wire);
+    });
+
+    std::printf("getCurrentUser x %d (single thread)\n", Calls);
+    std::printf("  direct Mock call:        %10.1f ns/call\n", directNs);
+    std::printf("  gRPC in-process channel: %10.1f ns/call\n", inProcessNs);
+    std::printf("  gRPC TCP loopback:       %10.1f ns/call\n", loopbackNs);
+    std::printf("  protobuf encode+decode:  %10.1f ns (%zu bytes)\n", codecNs,
+                wire.size());
+
+    if (argc > 1 && std::strcmp(argv[1], "--keepalive") == 0)
+        failures += checkKeepalive();
+    return failures == 0 ? 0 : 1;
+}
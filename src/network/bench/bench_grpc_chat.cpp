@@ -0,0 +1,173 @@
+// 消息收发吞吐：直接调用 Mock / gRPC 进程内 channel / gRPC TCP 回环
+//
+// 每条消息含一段文字和一张带扩展属性的图片；同步按页拉取。
+// 另外单独对比整页解码：堆上的 proto + 逐条 Message，与 arena 上的
+// proto + MessagePage 内存池。
+
+#include <wechat/core/MessagePage.h>
+
+#include "GrpcConvert.h"
+#include "GrpcLocalServer.h"
+#include "GrpcNetworkClient.h"
+#include "MockNetworkClient.h"
+
+#include <google/protobuf/arena.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wechat::core;
+using namespace wechat::network;
+
+namespace {
+
+constexpr int Sends = 2'000;
+constexpr int Syncs = 500;
+constexpr int PageSize = 50;
+constexpr int DecodeRounds = 2'000;
+
+MessageContent sampleContent(int i) {
+    auto suffix = std::to_string(i);
+    ResourceContent image{std::pmr::string("res_" + suffix),
+                          ResourceType::Image, ResourceSubtype::Jpeg,
+                          ResourceMeta{48'000,
+                                       std::pmr::string("IMG_" + suffix + ".jpg"),
+                                       ImageAttributes{1080, 1920}, {}}};
+    image.meta.extra.emplace("camera", "front");
+    return MessageContent{
+        TextContent{"message body number " + suffix +
+                    " with a little more text to look like chat"},
+        std::move(image)};
+}
+
+template <typename Fn> double seconds(Fn &&fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+}
+
+struct Throughput {
+    double sendsPerSec;
+    double messagesSyncedPerSec;
+};
+
+/// threads 个线程并发发送，再并发按页同步
+Throughput run(NetworkClient &client, int threads) {
+    auto reg = client.auth().registerUser(
+        "bench" + std::to_string(std::chrono::steady_clock::now()
+                                     .time_since_epoch()
+                                     .count()),
+        "p");
+    auto token = reg.value().token;
+    std::string chatId =
+        client.groups().createGroup(token, {reg.value().userId}).value().id;
+
+    auto sendSec = seconds([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                for (int i = t; i < Sends; i += threads)
+                    client.chat().sendMessage(token, chatId, "",
+                                              sampleContent(i));
+            });
+        for (auto &w : workers) w.join();
+    });
+
+    std::size_t synced = 0;
+    auto syncSec = seconds([&] {
+        std::vector<std::thread> workers;
+        std::vector<std::size_t> counts(threads);
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                for (int i = t; i < Syncs; i += threads) {
+                    auto page = client.chat().syncMessages(
+                        token, chatId, i % (Sends - PageSize), PageSize);
+                    counts[t] += page.value().messages.size();
+                }
+            });
+        for (auto &w : workers) w.join();
+        for (auto n : counts) synced += n;
+    });
+    return {Sends / sendSec, synced / syncSec};
+}
+
+} // namespace
+
+int main() {
+    auto threads =
+        static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+    GrpcLocalServer server;
+    if (!server.running()) return 1;
+    MockNetworkClient direct;
+    GrpcNetworkClient inProcess(server.inProcessChannel());
+    GrpcNetworkClient loopback(server.address());
+
+    std::printf("%d sends, %d syncs of %d messages, %d threads\n", Sends,
+                Syncs, PageSize, threads);
+    std::printf("  %-24s %12s %16s\n", "", "sends/s", "synced msgs/s");
+    for (auto [name, client] :
+         {std::pair<const char *, NetworkClient *>{"direct Mock", &direct},
+          {"gRPC in-process", &inProcess},
+          {"gRPC TCP loopback", &loopback}}) {
+        auto r = run(*client, threads);
+        std::printf("  %-24s %12.0f %16.0f\n", name, r.sendsPerSec,
+                    r.messagesSyncedPerSec);
+    }
+
+    // 整页解码：同一份线上字节
+    wechat::chat::SyncMessagesResponse source;
+    for (int i = 0; i < PageSize; ++i) {
+        Message msg{.id = Id("m" + std::to_string(i)),
+                    .senderId = Id("u1"),
+                    .chatId = Id("g1"),
+                    .replyTo = {},
+                    .content = sampleContent(i),
+                    .timestamp = i,
+                    .editedAt = 0,
+                    .revoked = false,
+                    .readCount = 0,
+                    .updatedAt = 0};
+        toProto(msg, source.add_messages());
+    }
+    auto wire = source.SerializeAsString();
+
+    std::size_t sink = 0;
+    auto heapSec = seconds([&] {
+        for (int r = 0; r < DecodeRounds; ++r) {
+            wechat::chat::SyncMessagesResponse response;
+            response.ParseFromString(wire);
+            std::vector<MessagePtr> messages;
+            messages.reserve(response.messages_size());
+            for (auto &m : response.messages())
+                messages.push_back(makeSnapshot(fromProto(m)));
+            sink += messages.size();
+        }
+    });
+    auto arenaSec = seconds([&] {
+        for (int r = 0; r < DecodeRounds; ++r) {
+            google::protobuf::Arena arena;
+            auto *response = google::protobuf::Arena::CreateMessage<
+                wechat::chat::SyncMessagesResponse>(&arena);
+            response->ParseFromString(wire);
+            MessagePage page;
+            page.reserve(response->messages_size());
+            for (auto &m : response->messages())
+                page.add(fromProto(m, page.allocator()));
+            sink += MessagePage::share(std::move(page)).size();
+        }
+    });
+
+    std::printf("decode %d-message page (%zu bytes)\n", PageSize, wire.size());
+    std::printf("  heap proto + per-message snapshots: %8.1f us/page\n",
+                heapSec * 1e6 / DecodeRounds);
+    std::printf("  arena proto + MessagePage:          %8.1f us/page\n",
+                arenaSec * 1e6 / DecodeRounds);
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+// 用户搜索 / 注册性能基准（1M 用户）
+//
+// - 注册：addUser 精确查重 + 建索引，耗时不随用户数增长
+// - 搜索：前缀 / 子串两类关键字的分页搜索耗时
+
+#include "MockDataStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace wechat;
+using namespace wechat::network;
+
+namespace {
+
+constexpr std::size_t UserCount = 1'000'000;
+constexpr std::size_t ReportEvery = 200'000;
+constexpr int SearchIterations = 1000;
+constexpr int PageSize = 20;
+
+std::string randomName(std::mt19937& rng) {
+    std::uniform_int_distribution<int> len(6, 12);
+    std::uniform_int_distribution<int> ch('a', 'z');
+    std::string name(len(rng), 'a');
+    for (auto& c : name) c = static_cast<char>(ch(rng));
+    return name;
+}
+
+double measureSearch(MockDataStore& store, const std::string& keyword) {
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SearchIterations; ++i) {
+        sink += store.searchUsers(keyword, 0, PageSize).size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (sink == 0) std::printf("  (no match for '%s')\n", keyword.c_str());
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           SearchIterations;
+}
+
+} // namespace
+
+int main() {
+    MockDataStore store;
+    std::mt19937 rng(42);
+    std::vector<std::string> names;
+    names.reserve(UserCount);
+
+    std::printf("%-12s %18s\n", "users", "register (us/op)");
+    auto batchStart = std::chrono::steady_clock::now();
+    for (std::size_t i = 1; i <= UserCount; ++i) {
+        auto name = randomName(rng) + std::to_string(i);
+        store.addUser(name, "p");
+        names.push_back(std::move(name));
+        if (i % ReportEvery == 0) {
+            auto elapsed = std::chrono::steady_clock::now() - batchStart;
+            std::printf("%-12zu %18.2f\n", i,
+                        std::chrono::duration<double, std::micro>(elapsed)
+                                .count() /
+                            ReportEvery);
+            batchStart = std::chrono::steady_clock::now();
+        }
+    }
+
+    std::printf("\n%-24s %16s\n", "query", "search (us/op)");
+    auto& sample = names[UserCount / 2];
+    struct Query {
+        const char* label;
+        std::string keyword;
+    };
+    for (auto& q : {Query{"exact", sample},
+                    Query{"prefix (3 chars)", sample.substr(0, 3)},
+                    Query{"prefix (1 char)", sample.substr(0, 1)},
+                    Query{"substring (4 chars)", sample.substr(2, 4)},
+                    Query{"substring (digits)", std::string("77777")}}) {
+        std::printf("%-24s %16.2f\n", q.label, measureSearch(store, q.keyword));
+    }
+    return 0;
+}
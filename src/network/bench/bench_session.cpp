@@ -0,0 +1,105 @@
+// token 解析性能基准
+//
+// 对比：全局 mutex + std::map（旧实现） / SessionTable / SessionTable +
+// SessionCache，在多线程并发 resolve 下的吞吐。
+
+#include "SessionCache.h"
+#include "SessionTable.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wechat::network;
+
+namespace {
+
+constexpr int SessionCount = 100'000;
+constexpr int LookupsPerThread = 1'000'000;
+// 热点 token 数：模拟少量活跃连接反复请求
+constexpr int HotTokens = 512;
+
+class MutexMapTable {
+public:
+    std::string create(const std::string& userId) {
+        std::lock_guard lock(mutex);
+        auto token = "tok_" + std::to_string(++counter);
+        tokens[token] = userId;
+        return token;
+    }
+
+    std::string resolve(const std::string& token) {
+        std::lock_guard lock(mutex);
+        auto it = tokens.find(token);
+        return it != tokens.end() ? it->second : std::string{};
+    }
+
+private:
+    std::mutex mutex;
+    std::map<std::string, std::string> tokens;
+    int64_t counter = 0;
+};
+
+template <typename Resolve>
+double measure(int threads, const std::vector<std::string>& hot,
+               Resolve resolve) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::size_t sink = 0;
+            for (int i = 0; i < LookupsPerThread; ++i) {
+                sink += !resolve(hot[(i * 7 + t) % hot.size()]).empty();
+            }
+            if (sink == 0) std::printf("unexpected miss\n");
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto total = static_cast<double>(threads) * LookupsPerThread;
+    return total / std::chrono::duration<double>(elapsed).count() / 1e6;
+}
+
+} // namespace
+
+int main() {
+    MutexMapTable legacy;
+    SessionTable table;
+    SessionCache cache(table, 4096);
+
+    std::vector<std::string> legacyHot, hot;
+    std::chrono::steady_clock::duration createTime{};
+    for (int i = 0; i < SessionCount; ++i) {
+        auto user = "u" + std::to_string(i);
+        auto a = legacy.create(user);
+        auto start = std::chrono::steady_clock::now();
+        auto b = table.create(wechat::core::Id(user));
+        createTime += std::chrono::steady_clock::now() - start;
+        if (i % (SessionCount / HotTokens) == 0) {
+            legacyHot.push_back(a);
+            hot.push_back(b);
+        }
+    }
+    // 写路径只改一个分片，不随会话总数变慢
+    std::printf("create: %.2f us/op over %d sessions\n",
+                std::chrono::duration<double, std::micro>(createTime).count() /
+                    SessionCount,
+                SessionCount);
+
+    std::printf("%-8s %16s %16s %16s\n", "threads", "mutex map (M/s)",
+                "table (M/s)", "cached (M/s)");
+    for (int threads : {1, 2, 4, 8}) {
+        auto a = measure(threads, legacyHot,
+                         [&](const std::string& t) { return legacy.resolve(t); });
+        auto b = measure(threads, hot,
+                         [&](const std::string& t) { return table.resolve(t); });
+        auto c = measure(threads, hot,
+                         [&](const std::string& t) { return cache.resolve(t); });
+        std::printf("%-8d %16.2f %16.2f %16.2f\n", threads, a, b, c);
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// MockDataStore::getMessages 同步性能基准
+//
+// 在不同历史长度下测量增量同步一页 (limit=50) 的耗时，
+// 期望耗时与历史长度无关（二分定位 + 只复制一页快照指针）。
+
+#include "MockDataStore.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace wechat;
+using namespace wechat::network;
+
+namespace {
+
+constexpr int PageSize = 50;
+constexpr int Iterations = 2000;
+
+double measureSync(std::size_t historySize) {
+    MockDataStore store;
+    core::MessageContent content = {core::TextContent{"hello"}};
+
+    int64_t midTs = 0;
+    for (std::size_t i = 0; i < historySize; ++i) {
+        auto msg = store.addMessage(core::Id("u1"), core::Id("g1"), {},
+                                    content);
+        if (i == historySize / 2) midTs = msg->timestamp;
+    }
+
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        sink += store.getMessages(core::Id("g1"), midTs, PageSize).size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (sink == 0) std::printf("unexpected empty page\n");
+
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           Iterations;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-12s %14s\n", "history", "sync (us/op)");
+    for (std::size_t n : {1'000u, 10'000u, 100'000u, 1'000'000u}) {
+        std::printf("%-12zu %14.2f\n", n, measureSync(n));
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <wechat/core/Executor.h>
+#include <wechat/core/Task.h>
+#include <wechat/network/AsyncNetworkClient.h>
+#include <wechat/network/NetworkClient.h>
+
+#include <string>
+#include <vector>
+
+using namespace wechat::core;
+using namespace wechat::network;
+
+class AsyncClientTest : public ::testing::Test {
+protected:
+    std::unique_ptr<NetworkClient> client = createMockClient();
+    Executor pool{ExecutorOptions{.threads = 2}};
+    AsyncNetworkClient async{*client, pool};
+};
+
+TEST_F(AsyncClientTest, AwaitsEachServiceOnExecutor) {
+    auto flow = [&]() -> Task<std::string> {
+        auto alice = co_await async.auth().registerUser("alice", "p");
+        auto bob = co_await async.auth().registerUser("bob", "p");
+        EXPECT_TRUE(pool.inWorkerThread()); // 在完成请求的工作线程上继续
+        if (!alice.ok() || !bob.ok()) co_return "register failed";
+
+        auto token = alice.value().token;
+        auto added = co_await async.contacts().addFriend(token, bob.value().userId);
+        EXPECT_TRUE(added.ok());
+        auto found = co_await async.contacts().searchUser(token, "bob");
+        EXPECT_EQ(found.value().size(), 1u);
+
+        // GCC 12 无法在 co_await 表达式中使用花括号初始化列表，先构造局部变量
+        std::vector<std::string> members{alice.value().userId,
+                                         bob.value().userId};
+        auto group = co_await async.groups().createGroup(token, members);
+        auto chatId = group.value().id;
+        MessageContent content{TextContent{"hi"}};
+        auto sent = co_await async.chat().sendMessage(token, chatId, "", content);
+        EXPECT_TRUE(sent.ok());
+
+        auto moment = co_await async.moments().postMoment(token, "sunny", {});
+        EXPECT_TRUE(moment.ok());
+
+        auto sync = co_await async.chat().syncMessages(bob.value().token,
+                                                       chatId, 0, 50);
+        co_return std::string(
+            std::get<TextContent>(sync.value().messages[0]->content[0]).text);
+    };
+    EXPECT_EQ(syncWait(flow()), "hi");
+}
+
+TEST_F(AsyncClientTest, ErrorsArriveAsResults) {
+    auto me = syncWait(async.auth().getCurrentUser("bad-token"));
+    ASSERT_FALSE(me.ok());
+    EXPECT_EQ(me.error().code, ErrorCode::Unauthorized);
+}
+
+TEST_F(AsyncClientTest, HundredsOfRequestsInFlightOnTwoThreads) {
+    auto alice = client->auth().registerUser("alice", "p").value();
+    auto group = client->groups().createGroup(alice.token, {alice.userId});
+    auto chatId = group.value().id;
+
+    constexpr int Count = 300;
+    std::vector<Task<Result<MessagePtr>>> sends;
+    for (int i = 0; i < Count; ++i) {
+        sends.push_back(async.chat().sendMessage(
+            alice.token, chatId, "", {TextContent{std::to_string(i)}}));
+    }
+    auto results = syncWait(whenAll(std::move(sends)));
+
+    ASSERT_EQ(results.size(), static_cast<std::size_t>(Count));
+    for (int i = 0; i < Count; ++i) {
+        ASSERT_TRUE(results[i].ok());
+        EXPECT_EQ(std::get<TextContent>(results[i].value()->content[0]).text,
+                  std::to_string(i).c_str());
+    }
+    EXPECT_EQ(pool.threadCount(), 2u);
+    EXPECT_GE(pool.stats().completed, static_cast<std::uint64_t>(Count));
+
+    auto sync = client->chat().syncMessages(alice.token, chatId, 0, Count);
+    EXPECT_EQ(sync.value().messages.size(), static_cast<std::size_t>(Count));
+}
@@ -61,6 +61,12 @@ TEST_F(AuthTest, RegisterDuplicateUsername) {
     EXPECT_EQ(r.error().code, ErrorCode::AlreadyExists);
 }
 
+TEST_F(AuthTest, RegisterUsernameThatIsSubstringOfExisting) {
+    ASSERT_TRUE(client->auth().registerUser("bobby", "p").ok());
+    ASSERT_TRUE(client->auth().registerUser("bob", "p").ok());
+    ASSERT_TRUE(client->auth().registerUser("obb", "p").ok());
+}
+
 TEST_F(AuthTest, LoginUnknownUser) {
     auto r = client->auth().login("nobody", "pass");
     ASSERT_FALSE(r.ok());
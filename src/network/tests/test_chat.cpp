@@ -1,9 +1,14 @@
 #include <gtest/gtest.h>
 
 #include <wechat/core/Message.h>
+#include <wechat/log/Trace.h>
 #include <wechat/network/NetworkClient.h>
 #include <wechat/network/NetworkTypes.h>
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+
 using namespace wechat::core;
 using namespace wechat::network;
 
@@ -36,17 +41,39 @@ TEST_F(ChatTest, SendAndSyncMessages) {
     MessageContent content = {TextContent{"hello bob!"}};
     auto sent = client->chat().sendMessage(tokenA, chatId, "", content);
     ASSERT_TRUE(sent.ok());
-    EXPECT_EQ(sent.value().senderId, regA.value().userId);
+    EXPECT_EQ(sent.value()->senderId, regA.value().userId);
 
     auto sync = client->chat().syncMessages(tokenB, chatId, 0, 50);
     ASSERT_TRUE(sync.ok());
     EXPECT_EQ(sync.value().messages.size(), 1u);
 
-    auto* text = std::get_if<TextContent>(&sync.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "hello bob!");
 }
 
+TEST_F(ChatTest, SyncClampsHugeLimit) {
+    auto reg = client->auth().registerUser("alice", "p");
+    auto token = reg.value().token;
+    auto chatId =
+        client->groups().createGroup(token, {reg.value().userId}).value().id;
+    MessageContent content = {TextContent{"hi"}};
+    for (int i = 0; i < 3; ++i)
+        client->chat().sendMessage(token, chatId, "", content);
+
+    auto sync = client->chat().syncMessages(token, chatId, 0,
+                                            std::numeric_limits<int>::max());
+    ASSERT_TRUE(sync.ok());
+    EXPECT_EQ(sync.value().messages.size(), 3u);
+    EXPECT_FALSE(sync.value().hasMore);
+
+    for (int limit : {0, -1, std::numeric_limits<int>::min()}) {
+        auto bad = client->chat().syncMessages(token, chatId, 0, limit);
+        ASSERT_FALSE(bad.ok()) << limit;
+        EXPECT_EQ(bad.error().code, ErrorCode::InvalidArgument);
+    }
+}
+
 TEST_F(ChatTest, SendMessageNotMember) {
     auto regA = client->auth().registerUser("alice", "p");
     auto regB = client->auth().registerUser("bob", "p");
@@ -69,13 +96,13 @@ TEST_F(ChatTest, RevokeMessage) {
 
     auto sent = client->chat().sendMessage(
         tokenA, chatId, "", MessageContent{TextContent{"oops"}});
-    auto msgId = sent.value().id;
+    auto msgId = sent.value()->id;
 
     auto r = client->chat().revokeMessage(tokenA, msgId);
     ASSERT_TRUE(r.ok());
 
     auto sync = client->chat().syncMessages(tokenA, chatId, 0, 50);
-    EXPECT_TRUE(sync.value().messages[0].revoked);
+    EXPECT_TRUE(sync.value().messages[0]->revoked);
 }
 
 TEST_F(ChatTest, RevokeOtherUserMessage) {
@@ -89,7 +116,7 @@ TEST_F(ChatTest, RevokeOtherUserMessage) {
     auto sent = client->chat().sendMessage(
         regA.value().token, chatId, "", MessageContent{TextContent{"hi"}});
 
-    auto r = client->chat().revokeMessage(regB.value().token, sent.value().id);
+    auto r = client->chat().revokeMessage(regB.value().token, sent.value()->id);
     ASSERT_FALSE(r.ok());
     EXPECT_EQ(r.error().code, ErrorCode::PermissionDenied);
 }
@@ -103,17 +130,47 @@ TEST_F(ChatTest, EditMessage) {
 
     auto sent = client->chat().sendMessage(
         tokenA, chatId, "", MessageContent{TextContent{"typo"}});
-    auto msgId = sent.value().id;
+    auto msgId = sent.value()->id;
 
     MessageContent newContent = {TextContent{"fixed"}};
     auto r = client->chat().editMessage(tokenA, msgId, newContent);
     ASSERT_TRUE(r.ok());
 
     auto sync = client->chat().syncMessages(tokenA, chatId, 0, 50);
-    auto* text = std::get_if<TextContent>(&sync.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "fixed");
-    EXPECT_GT(sync.value().messages[0].editedAt, 0);
+    EXPECT_GT(sync.value().messages[0]->editedAt, 0);
+}
+
+TEST_F(ChatTest, SnapshotsAreSharedAndEditsReplaceThem) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto tokenA = regA.value().token;
+    auto group = client->groups().createGroup(tokenA, {regA.value().userId});
+    auto chatId = group.value().id;
+
+    auto sent = client->chat().sendMessage(
+        tokenA, chatId, "", MessageContent{TextContent{"typo"}});
+    ASSERT_TRUE(sent.ok());
+    auto original = sent.value();
+
+    // 同步拿到的是同一个快照，不拷贝
+    auto sync = client->chat().syncMessages(tokenA, chatId, 0, 50);
+    ASSERT_EQ(sync.value().messages.size(), 1u);
+    EXPECT_EQ(sync.value().messages[0].get(), original.get());
+
+    ASSERT_TRUE(client->chat()
+                    .editMessage(tokenA, original->id,
+                                 MessageContent{TextContent{"fixed"}})
+                    .ok());
+
+    // 编辑生成新快照，旧快照保持不变
+    auto after = client->chat().syncMessages(tokenA, chatId, 0, 50);
+    auto& edited = after.value().messages[0];
+    EXPECT_NE(edited.get(), original.get());
+    EXPECT_EQ(std::get<TextContent>(edited->content[0]).text, "fixed");
+    EXPECT_EQ(std::get<TextContent>(original->content[0]).text, "typo");
+    EXPECT_EQ(original->editedAt, 0);
 }
 
 TEST_F(ChatTest, MarkRead) {
@@ -127,11 +184,11 @@ TEST_F(ChatTest, MarkRead) {
     auto sent = client->chat().sendMessage(
         regA.value().token, chatId, "", MessageContent{TextContent{"hi"}});
 
-    auto r = client->chat().markRead(regB.value().token, chatId, sent.value().id);
+    auto r = client->chat().markRead(regB.value().token, chatId, sent.value()->id);
     ASSERT_TRUE(r.ok());
 
     auto sync = client->chat().syncMessages(regA.value().token, chatId, 0, 50);
-    EXPECT_EQ(sync.value().messages[0].readCount, 1u);
+    EXPECT_EQ(sync.value().messages[0]->readCount, 1u);
 }
 
 TEST_F(ChatTest, SyncMessagesPagination) {
@@ -152,13 +209,45 @@ TEST_F(ChatTest, SyncMessagesPagination) {
     EXPECT_EQ(sync.value().messages.size(), 3u);
     EXPECT_TRUE(sync.value().hasMore);
 
-    auto lastTs = sync.value().messages.back().timestamp;
+    auto lastTs = sync.value().messages.back()->timestamp;
     auto sync2 = client->chat().syncMessages(tokenA, chatId, lastTs, 3);
     ASSERT_TRUE(sync2.ok());
     EXPECT_EQ(sync2.value().messages.size(), 2u);
     EXPECT_FALSE(sync2.value().hasMore);
 }
 
+TEST_F(ChatTest, SyncMessagesFromMiddleOfInterleavedChats) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto tokenA = regA.value().token;
+
+    auto chat1 = client->groups().createGroup(tokenA, {regA.value().userId});
+    auto chat2 = client->groups().createGroup(tokenA, {regA.value().userId});
+
+    std::vector<MessagePtr> sent;
+    for (int i = 0; i < 6; ++i) {
+        sent.push_back(client->chat().sendMessage(
+            tokenA, chat1.value().id, "",
+            MessageContent{TextContent{"c1 " + std::to_string(i)}}).value());
+        client->chat().sendMessage(
+            tokenA, chat2.value().id, "",
+            MessageContent{TextContent{"c2 " + std::to_string(i)}});
+    }
+
+    auto sync = client->chat().syncMessages(
+        tokenA, chat1.value().id, sent[2]->timestamp, 2);
+    ASSERT_TRUE(sync.ok());
+    ASSERT_EQ(sync.value().messages.size(), 2u);
+    EXPECT_EQ(sync.value().messages[0]->id, sent[3]->id);
+    EXPECT_EQ(sync.value().messages[1]->id, sent[4]->id);
+    EXPECT_TRUE(sync.value().hasMore);
+
+    auto tail = client->chat().syncMessages(
+        tokenA, chat1.value().id, sent[5]->timestamp, 10);
+    ASSERT_TRUE(tail.ok());
+    EXPECT_TRUE(tail.value().messages.empty());
+    EXPECT_FALSE(tail.value().hasMore);
+}
+
 TEST_F(ChatTest, SendMessageReplyTo) {
     auto regA = client->auth().registerUser("alice", "p");
     auto regB = client->auth().registerUser("bob", "p");
@@ -171,11 +260,58 @@ TEST_F(ChatTest, SendMessageReplyTo) {
         regA.value().token, chatId, "",
         MessageContent{TextContent{"original"}});
     auto msg2 = client->chat().sendMessage(
-        regB.value().token, chatId, msg1.value().id,
+        regB.value().token, chatId, msg1.value()->id,
         MessageContent{TextContent{"reply"}});
 
     ASSERT_TRUE(msg2.ok());
-    EXPECT_EQ(msg2.value().replyTo, msg1.value().id);
+    EXPECT_EQ(msg2.value()->replyTo, msg1.value()->id);
+}
+
+TEST_F(ChatTest, MessageIdsSortByTime) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto tokenA = regA.value().token;
+    auto group = client->groups().createGroup(tokenA, {regA.value().userId});
+    auto chatId = group.value().id;
+
+    std::vector<std::string> ids;
+    for (int i = 0; i < 5; ++i) {
+        auto sent = client->chat().sendMessage(
+            tokenA, chatId, "", MessageContent{TextContent{"m"}});
+        ids.push_back(sent.value()->id.str());
+    }
+    // 定长字符串，字典序即生成顺序，可直接作为分页键
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_EQ(ids.front().size(), ids.back().size());
+}
+
+TEST_F(ChatTest, UnknownIdsAreNotInterned) {
+    auto alice = client->auth().registerUser("alice", "p").value();
+    auto group = client->groups().createGroup(alice.token, {alice.userId});
+    auto chatId = group.value().id;
+    MessageContent content = {TextContent{"hi"}};
+
+    // 客户端随意构造的 ID 只查不驻留，驻留表不随之增长
+    auto before = Id::internedCount();
+    for (int i = 0; i < 100; ++i) {
+        auto bogus = "bogus_" + std::to_string(i);
+        EXPECT_EQ(client->chat().revokeMessage(alice.token, bogus).error().code,
+                  ErrorCode::NotFound);
+        EXPECT_FALSE(
+            client->chat().editMessage(alice.token, bogus, content).ok());
+        EXPECT_FALSE(client->chat().markRead(alice.token, chatId, bogus).ok());
+        EXPECT_TRUE(client->chat()
+                        .syncMessages(alice.token, bogus, 0, 10)
+                        .value()
+                        .messages.empty());
+        EXPECT_EQ(client->chat()
+                      .sendMessage(alice.token, chatId, bogus, content)
+                      .error().code,
+                  ErrorCode::NotFound);
+        EXPECT_FALSE(client->contacts().addFriend(alice.token, bogus).ok());
+        EXPECT_FALSE(client->groups().addMember(alice.token, bogus, bogus).ok());
+        EXPECT_FALSE(client->moments().likeMoment(alice.token, bogus).ok());
+    }
+    EXPECT_EQ(Id::internedCount(), before);
 }
 
 TEST_F(ChatTest, SendEmptyMessage) {
@@ -189,3 +325,42 @@ TEST_F(ChatTest, SendEmptyMessage) {
     ASSERT_FALSE(r.ok());
     EXPECT_EQ(r.error().code, ErrorCode::InvalidArgument);
 }
+
+TEST_F(ChatTest, SyncStagesAreTraced) {
+    namespace log = wechat::log;
+    auto alice = client->auth().registerUser("alice", "p").value();
+    auto group = client->groups().createGroup(alice.token, {alice.userId});
+    auto chatId = group.value().id;
+    MessageContent content = {TextContent{"traced"}};
+
+    // 关闭时不记录
+    log::clearTrace();
+    client->chat().sendMessage(alice.token, chatId, "", content);
+    EXPECT_EQ(log::exportChromeTrace().find("MockChatService"),
+              std::string::npos);
+
+    log::startTracing();
+    std::thread worker([&] {
+        log::setTraceThreadName("sync");
+        client->chat().sendMessage(alice.token, chatId, "", content);
+        client->chat().syncMessages(alice.token, chatId, 0, 50);
+    });
+    worker.join();
+    log::stopTracing();
+
+    auto trace = log::exportChromeTrace();
+    for (auto name : {"MockChatService::sendMessage",
+                      "MockChatService::syncMessages",
+                      "SessionCache::resolve",
+                      "MockDataStore::addMessage",
+                      "MockDataStore::getMessages"}) {
+        EXPECT_NE(trace.find(std::string("\"name\":\"") + name + "\""),
+                  std::string::npos)
+            << name;
+    }
+    EXPECT_NE(trace.find(R"("ph":"X")"), std::string::npos);
+    EXPECT_NE(trace.find(R"("args":{"name":"sync"})"), std::string::npos);
+    EXPECT_EQ(trace.front(), '{');
+    EXPECT_EQ(trace.back(), '}');
+    log::clearTrace();
+}
@@ -72,6 +72,52 @@ TEST_F(ContactTest, SearchUserEmptyResult) {
     EXPECT_EQ(r.value().size(), 0u);
 }
 
+TEST_F(ContactTest, SearchUserRankedAndPaginated) {
+    auto tokenA = registerAndLogin("alice", "p");
+    registerAndLogin("bobby", "p");
+    registerAndLogin("mr_bob", "p");
+    auto bob = client->auth().registerUser("bob", "p");
+    registerAndLogin("bobcat", "p");
+
+    auto all = client->contacts().searchUser(tokenA, "bob", 0, 10);
+    ASSERT_TRUE(all.ok());
+    ASSERT_EQ(all.value().size(), 4u);
+    // 精确匹配排第一，子串匹配排在前缀匹配之后
+    EXPECT_EQ(all.value()[0].id, bob.value().userId);
+
+    auto page1 = client->contacts().searchUser(tokenA, "bob", 0, 2);
+    auto page2 = client->contacts().searchUser(tokenA, "bob", 2, 2);
+    ASSERT_EQ(page1.value().size(), 2u);
+    ASSERT_EQ(page2.value().size(), 2u);
+    EXPECT_EQ(page1.value()[1].id, all.value()[1].id);
+    EXPECT_EQ(page2.value()[0].id, all.value()[2].id);
+    EXPECT_EQ(page2.value()[1].id, all.value()[3].id);
+
+    auto byId = client->contacts().searchUser(tokenA, bob.value().userId);
+    ASSERT_TRUE(byId.ok());
+    ASSERT_FALSE(byId.value().empty());
+    EXPECT_EQ(byId.value()[0].id, bob.value().userId);
+
+    auto bad = client->contacts().searchUser(tokenA, "bob", -1, 2);
+    ASSERT_FALSE(bad.ok());
+    EXPECT_EQ(bad.error().code, ErrorCode::InvalidArgument);
+}
+
+TEST_F(ContactTest, SearchUserMatchesIdSubstringAfterNames) {
+    auto tokenA = registerAndLogin("alice", "p");
+    auto bob = client->auth().registerUser("bob", "p");
+    std::string id = bob.value().userId;
+    auto keyword = id.substr(id.size() - 6);
+    // 用户名含关键字的排在 userId 子串匹配之前
+    auto named = client->auth().registerUser("x" + keyword, "p");
+
+    auto r = client->contacts().searchUser(tokenA, keyword, 0, 10);
+    ASSERT_TRUE(r.ok());
+    ASSERT_GE(r.value().size(), 2u);
+    EXPECT_EQ(r.value()[0].id, named.value().userId);
+    EXPECT_EQ(r.value()[1].id, bob.value().userId);
+}
+
 TEST_F(ContactTest, BidirectionalFriendship) {
     auto tokenA = registerAndLogin("alice", "p");
     auto regB = client->auth().registerUser("bob", "p");
@@ -105,3 +105,25 @@ TEST_F(GroupTest, DissolveNonExistentGroup) {
     ASSERT_FALSE(r.ok());
     EXPECT_EQ(r.error().code, ErrorCode::NotFound);
 }
+
+TEST_F(GroupTest, ListMyGroupsTracksMembershipChanges) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto regB = client->auth().registerUser("bob", "p");
+    auto tokenA = regA.value().token;
+    auto tokenB = regB.value().token;
+
+    auto g = client->groups().createGroup(tokenA, {regA.value().userId});
+    auto groupId = g.value().id;
+    EXPECT_TRUE(client->groups().listMyGroups(tokenB).value().empty());
+
+    client->groups().addMember(tokenA, groupId, regB.value().userId);
+    auto joined = client->groups().listMyGroups(tokenB);
+    ASSERT_EQ(joined.value().size(), 1u);
+    EXPECT_EQ(joined.value()[0].id, groupId);
+
+    client->groups().removeMember(tokenA, groupId, regB.value().userId);
+    EXPECT_TRUE(client->groups().listMyGroups(tokenB).value().empty());
+
+    client->groups().dissolveGroup(tokenA, groupId);
+    EXPECT_TRUE(client->groups().listMyGroups(tokenA).value().empty());
+}
@@ -0,0 +1,402 @@
+#include <gtest/gtest.h>
+
+#include <wechat/core/Message.h>
+#include <wechat/network/NetworkTypes.h>
+
+#include "GrpcConvert.h"
+#include "GrpcLocalServer.h"
+#include "GrpcNetworkClient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <map>
+#include <memory_resource>
+#include <thread>
+
+using namespace wechat::core;
+using namespace wechat::network;
+
+namespace {
+
+MessageContent mixedContent() {
+    ResourceContent image{"res_img", ResourceType::Image, ResourceSubtype::Png,
+                          ResourceMeta{2048, "cat.png",
+                                       ImageAttributes{640, 480}, {}}};
+    image.meta.extra.emplace("exif", "none");
+    ResourceContent video{"res_vid", ResourceType::Video, ResourceSubtype::Mp4,
+                          ResourceMeta{1 << 20, "clip.mp4",
+                                       VideoAttributes{1280, 720, 42}, {}}};
+    ResourceContent voice{"res_aud", ResourceType::Audio, ResourceSubtype::Aac,
+                          ResourceMeta{512, "voice.aac",
+                                       AudioAttributes{7}, {}}};
+    ResourceContent file{"res_doc", ResourceType::File, ResourceSubtype::Pdf,
+                         ResourceMeta{99, "spec.pdf", std::monostate{}, {}}};
+    return MessageContent{TextContent{"look"}, image, video,
+                          voice, file, std::monostate{}};
+}
+
+void expectMixedContent(const MessageContent& content) {
+    ASSERT_EQ(content.size(), 6u);
+    EXPECT_EQ(std::get<TextContent>(content[0]).text, "look");
+
+    auto& image = std::get<ResourceContent>(content[1]);
+    EXPECT_EQ(image.resourceId, "res_img");
+    EXPECT_EQ(image.type, ResourceType::Image);
+    EXPECT_EQ(image.subtype, ResourceSubtype::Png);
+    EXPECT_EQ(image.meta.size, 2048u);
+    EXPECT_EQ(image.meta.filename, "cat.png");
+    EXPECT_EQ(std::get<ImageAttributes>(image.meta.media).height, 480u);
+    ASSERT_EQ(image.meta.extra.size(), 1u);
+    EXPECT_EQ(image.meta.extra.begin()->second, "none");
+
+    auto& video = std::get<ResourceContent>(content[2]);
+    EXPECT_EQ(std::get<VideoAttributes>(video.meta.media).duration, 42u);
+    auto& voice = std::get<ResourceContent>(content[3]);
+    EXPECT_EQ(voice.subtype, ResourceSubtype::Aac);
+    EXPECT_EQ(std::get<AudioAttributes>(voice.meta.media).duration, 7u);
+    auto& file = std::get<ResourceContent>(content[4]);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(file.meta.media));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(content[5]));
+}
+
+} // namespace
+
+TEST(GrpcConvertTest, ContentRoundTripsIntoTargetArena) {
+    auto content = mixedContent();
+    wechat::chat::SendMessageRequest request;
+    toProto(content, request.mutable_content());
+
+    std::pmr::monotonic_buffer_resource arena;
+    auto decoded = fromProto(request.content(), &arena);
+    expectMixedContent(decoded);
+    EXPECT_EQ(decoded.get_allocator().resource(), &arena);
+    auto& image = std::get<ResourceContent>(decoded[1]);
+    EXPECT_EQ(image.resourceId.get_allocator().resource(), &arena);
+    EXPECT_EQ(image.meta.extra.begin()->first.get_allocator().resource(),
+              &arena);
+}
+
+TEST(GrpcConvertTest, UnknownEnumValuesFallBack) {
+    wechat::chat::SendMessageRequest request;
+    auto* resource = request.add_content()->mutable_resource();
+    resource->set_type(static_cast<wechat::chat::ResourceType>(99));
+    resource->set_subtype(static_cast<wechat::chat::ResourceSubtype>(99));
+
+    auto decoded = fromProto(request.content());
+    auto& res = std::get<ResourceContent>(decoded[0]);
+    EXPECT_EQ(res.type, ResourceType::File);
+    EXPECT_EQ(res.subtype, ResourceSubtype::Unknown);
+}
+
+class GrpcAuthTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_TRUE(server.running()); }
+
+    GrpcLocalServer server;
+};
+
+TEST_F(GrpcAuthTest, RoundTripOverLoopback) {
+    GrpcNetworkClient client(server.address());
+
+    auto reg = client.auth().registerUser("alice", "pass123");
+    ASSERT_TRUE(reg.ok()) << reg.error().message;
+    EXPECT_FALSE(reg.value().token.empty());
+
+    auto login = client.auth().login("alice", "pass123");
+    ASSERT_TRUE(login.ok());
+    EXPECT_EQ(login.value().userId, reg.value().userId);
+
+    auto user = client.auth().getCurrentUser(login.value().token);
+    ASSERT_TRUE(user.ok());
+    EXPECT_EQ(user.value().id, reg.value().userId);
+
+    ASSERT_TRUE(client.auth().logout(login.value().token).ok());
+    auto after = client.auth().getCurrentUser(login.value().token);
+    ASSERT_FALSE(after.ok());
+    EXPECT_EQ(after.error().code, ErrorCode::Unauthorized);
+}
+
+TEST_F(GrpcAuthTest, ErrorCodesSurviveTheWire) {
+    GrpcNetworkClient client(server.address());
+    ASSERT_TRUE(client.auth().registerUser("bob", "secret").ok());
+
+    auto duplicate = client.auth().registerUser("bob", "other");
+    ASSERT_FALSE(duplicate.ok());
+    EXPECT_EQ(duplicate.error().code, ErrorCode::AlreadyExists);
+    EXPECT_EQ(duplicate.error().message, "username already exists");
+
+    auto wrong = client.auth().login("bob", "wrong");
+    ASSERT_FALSE(wrong.ok());
+    EXPECT_EQ(wrong.error().code, ErrorCode::Unauthorized);
+
+    auto empty = client.auth().registerUser("", "");
+    ASSERT_FALSE(empty.ok());
+    EXPECT_EQ(empty.error().code, ErrorCode::InvalidArgument);
+}
+
+TEST_F(GrpcAuthTest, InProcessChannelSharesServerState) {
+    GrpcNetworkClient tcp(server.address());
+    GrpcNetworkClient local(server.inProcessChannel());
+
+    auto reg = tcp.auth().registerUser("carol", "pass");
+    ASSERT_TRUE(reg.ok());
+
+    auto login = local.auth().login("carol", "pass");
+    ASSERT_TRUE(login.ok());
+    EXPECT_EQ(login.value().userId, reg.value().userId);
+    EXPECT_EQ(server.store().authenticate("carol", "pass"),
+              reg.value().userId);
+}
+
+TEST(GrpcChannelTest, UnreachableServerFailsWithinDeadline) {
+    GrpcChannelOptions options;
+    options.deadline = std::chrono::milliseconds(300);
+    GrpcNetworkClient client("127.0.0.1:1", options);
+
+    auto start = std::chrono::steady_clock::now();
+    auto r = client.auth().login("dave", "pass");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_FALSE(r.ok());
+    EXPECT_TRUE(r.error().code == ErrorCode::Unavailable ||
+                r.error().code == ErrorCode::Timeout)
+        << r.error().message;
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
+
+namespace {
+
+/// channelArguments 中的整数参数
+std::map<std::string, int> intArguments(const GrpcChannelOptions& options) {
+    auto args = channelArguments(options);
+    grpc_channel_args raw;
+    args.SetChannelArgs(&raw);
+    std::map<std::string, int> values;
+    for (std::size_t i = 0; i < raw.num_args; ++i)
+        if (raw.args[i].type == GRPC_ARG_INTEGER)
+            values[raw.args[i].key] = raw.args[i].value.integer;
+    return values;
+}
+
+} // namespace
+
+// 空闲连接能否存活要实际等待数秒，放在 bench_grpc_auth --keepalive 中手动运行
+
+TEST(GrpcChannelTest, DefaultsRespectDefaultServerPingPolicy) {
+    auto values = intArguments({});
+    EXPECT_GE(values[GRPC_ARG_KEEPALIVE_TIME_MS], 5 * 60 * 1000);
+    EXPECT_FALSE(values.contains(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS));
+    EXPECT_FALSE(values.contains(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA));
+}
+
+TEST(GrpcChannelTest, AggressiveKeepaliveSetsIdlePingArguments) {
+    GrpcChannelOptions aggressive;
+    aggressive.keepaliveTime = std::chrono::milliseconds(100);
+    aggressive.keepaliveTimeout = std::chrono::milliseconds(50);
+    aggressive.keepaliveWithoutCalls = true;
+
+    auto values = intArguments(aggressive);
+    EXPECT_EQ(values[GRPC_ARG_KEEPALIVE_TIME_MS], 100);
+    EXPECT_EQ(values[GRPC_ARG_KEEPALIVE_TIMEOUT_MS], 50);
+    EXPECT_EQ(values[GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS], 1);
+    EXPECT_EQ(values[GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA], 0);
+}
+
+// ══════════════════════════════════════════════════
+// Chat / Group / Contact / Moment over the wire
+// ══════════════════════════════════════════════════
+
+class GrpcServicesTest : public GrpcAuthTest {
+protected:
+    LoginResponse registerUser(const std::string& name) {
+        auto r = client.auth().registerUser(name, "p");
+        EXPECT_TRUE(r.ok());
+        return r.value();
+    }
+
+    GrpcNetworkClient client{server.inProcessChannel()};
+};
+
+TEST_F(GrpcServicesTest, ChatSendSyncEditRevoke) {
+    auto alice = registerUser("alice");
+    auto bob = registerUser("bob");
+    auto group = client.groups().createGroup(alice.token,
+                                             {alice.userId, bob.userId});
+    ASSERT_TRUE(group.ok());
+    std::string chatId = group.value().id;
+
+    auto sent = client.chat().sendMessage(alice.token, chatId, "",
+                                          mixedContent());
+    ASSERT_TRUE(sent.ok()) << sent.error().message;
+    EXPECT_EQ(sent.value()->senderId, alice.userId);
+    expectMixedContent(sent.value()->content);
+
+    auto reply = client.chat().sendMessage(bob.token, chatId,
+                                           sent.value()->id,
+                                           MessageContent{TextContent{"ok"}});
+    ASSERT_TRUE(reply.ok());
+
+    auto sync = client.chat().syncMessages(bob.token, chatId, 0, 1);
+    ASSERT_TRUE(sync.ok());
+    EXPECT_TRUE(sync.value().hasMore);
+    sync = client.chat().syncMessages(bob.token, chatId, 0, 50);
+    ASSERT_TRUE(sync.ok());
+    ASSERT_EQ(sync.value().messages.size(), 2u);
+    expectMixedContent(sync.value().messages[0]->content);
+    EXPECT_EQ(sync.value().messages[1]->replyTo, sent.value()->id);
+
+    std::string messageId = sent.value()->id;
+    ASSERT_TRUE(client.chat()
+                    .editMessage(alice.token, messageId,
+                                 MessageContent{TextContent{"edited"}})
+                    .ok());
+    ASSERT_TRUE(client.chat().markRead(bob.token, chatId, messageId).ok());
+    ASSERT_TRUE(client.chat().revokeMessage(alice.token, messageId).ok());
+
+    sync = client.chat().syncMessages(bob.token, chatId, 0, 50);
+    ASSERT_TRUE(sync.ok());
+    auto& edited = *sync.value().messages[0];
+    EXPECT_TRUE(edited.revoked);
+    EXPECT_NE(edited.editedAt, 0);
+
+    auto stranger = registerUser("mallory");
+    auto denied = client.chat().sendMessage(stranger.token, chatId, "",
+                                            MessageContent{TextContent{"x"}});
+    ASSERT_FALSE(denied.ok());
+    EXPECT_EQ(denied.error().code, ErrorCode::PermissionDenied);
+}
+
+TEST_F(GrpcServicesTest, GroupsAndContacts) {
+    auto alice = registerUser("alice");
+    auto bob = registerUser("bob");
+    auto carol = registerUser("carol");
+
+    auto group = client.groups().createGroup(alice.token, {alice.userId});
+    ASSERT_TRUE(group.ok());
+    EXPECT_EQ(group.value().ownerId, alice.userId);
+    std::string groupId = group.value().id;
+
+    ASSERT_TRUE(client.groups().addMember(alice.token, groupId,
+                                          bob.userId).ok());
+    auto members = client.groups().listMembers(alice.token, groupId);
+    ASSERT_TRUE(members.ok());
+    EXPECT_EQ(members.value().size(), 2u);
+    auto mine = client.groups().listMyGroups(bob.token);
+    ASSERT_TRUE(mine.ok());
+    ASSERT_EQ(mine.value().size(), 1u);
+    EXPECT_TRUE(mine.value()[0].memberIds.contains(Id::find(bob.userId)));
+
+    auto notOwner = client.groups().dissolveGroup(bob.token, groupId);
+    ASSERT_FALSE(notOwner.ok());
+    EXPECT_EQ(notOwner.error().code, ErrorCode::PermissionDenied);
+    ASSERT_TRUE(client.groups().removeMember(alice.token, groupId,
+                                             bob.userId).ok());
+    ASSERT_TRUE(client.groups().dissolveGroup(alice.token, groupId).ok());
+
+    ASSERT_TRUE(client.contacts().addFriend(alice.token, carol.userId).ok());
+    auto friends = client.contacts().listFriends(alice.token);
+    ASSERT_TRUE(friends.ok());
+    ASSERT_EQ(friends.value().size(), 1u);
+    EXPECT_EQ(friends.value()[0].id, carol.userId);
+    auto found = client.contacts().searchUser(alice.token, "car");
+    ASSERT_TRUE(found.ok());
+    ASSERT_FALSE(found.value().empty());
+    EXPECT_EQ(found.value()[0].id, carol.userId);
+    ASSERT_TRUE(client.contacts().removeFriend(alice.token, carol.userId).ok());
+    EXPECT_TRUE(client.contacts().listFriends(alice.token).value().empty());
+}
+
+TEST_F(GrpcServicesTest, ConcurrentMembershipChangesAndSends) {
+    // 同步服务端在多个线程上并发执行处理函数：加成员会让成员集合重新分配，
+    // 解散会删除群，发送 / 列成员不能读到锁外的旧指针
+    auto alice = registerUser("alice");
+    std::vector<std::string> users;
+    for (int i = 0; i < 64; ++i)
+        users.push_back(registerUser("user" + std::to_string(i)).userId);
+    std::string groupId =
+        client.groups().createGroup(alice.token, {alice.userId}).value().id;
+    std::string doomedId =
+        client.groups().createGroup(alice.token, {alice.userId}).value().id;
+
+    std::atomic<bool> done{false};
+    std::thread adder([&] {
+        for (auto& user : users)
+            EXPECT_TRUE(client.groups().addMember(alice.token, groupId, user)
+                            .ok());
+        EXPECT_TRUE(client.groups().dissolveGroup(alice.token, doomedId).ok());
+        done = true;
+    });
+    std::thread lister([&] {
+        while (!done) {
+            auto members = client.groups().listMembers(alice.token, groupId);
+            ASSERT_TRUE(members.ok());
+            EXPECT_GE(members.value().size(), 1u);
+        }
+    });
+    int sent = 0;
+    while (!done) {
+        MessageContent text{TextContent{"hi"}};
+        EXPECT_TRUE(client.chat().sendMessage(alice.token, groupId, "", text)
+                        .ok());
+        auto doomed = client.chat().sendMessage(alice.token, doomedId, "", text);
+        EXPECT_TRUE(doomed.ok() || doomed.error().code == ErrorCode::NotFound);
+        ++sent;
+    }
+    adder.join();
+    lister.join();
+
+    EXPECT_EQ(client.groups().listMembers(alice.token, groupId).value().size(),
+              users.size() + 1);
+    auto sync = client.chat().syncMessages(alice.token, groupId, 0,
+                                           ChatService::MaxSyncPage);
+    ASSERT_TRUE(sync.ok());
+    EXPECT_EQ(sync.value().messages.size(),
+              std::min<std::size_t>(sent, ChatService::MaxSyncPage));
+}
+
+TEST_F(GrpcServicesTest, MomentsWithCommentsAndPaging) {
+    auto alice = registerUser("alice");
+    auto bob = registerUser("bob");
+    ASSERT_TRUE(client.contacts().addFriend(alice.token, bob.userId).ok());
+
+    auto posted = client.moments().postMoment(alice.token, "sunset",
+                                              {"img1", "img2"});
+    ASSERT_TRUE(posted.ok());
+    EXPECT_EQ(posted.value().imageIds.size(), 2u);
+    std::string momentId = posted.value().id;
+
+    ASSERT_TRUE(client.moments().likeMoment(bob.token, momentId).ok());
+    auto again = client.moments().likeMoment(bob.token, momentId);
+    ASSERT_FALSE(again.ok());
+    EXPECT_EQ(again.error().code, ErrorCode::AlreadyExists);
+
+    for (int i = 0; i < 5; ++i) {
+        auto comment = client.moments().commentMoment(
+            bob.token, momentId, "nice " + std::to_string(i));
+        ASSERT_TRUE(comment.ok());
+        EXPECT_EQ(comment.value().authorId, bob.userId);
+    }
+
+    auto feed = client.moments().listMoments(bob.token, INT64_MAX, 10);
+    ASSERT_TRUE(feed.ok());
+    ASSERT_EQ(feed.value().size(), 1u);
+    auto& moment = feed.value()[0];
+    EXPECT_EQ(moment.text, "sunset");
+    EXPECT_EQ(moment.likeCount, 1u);
+    EXPECT_TRUE(moment.likedByMe);
+    EXPECT_EQ(moment.commentCount, 5u);
+    EXPECT_EQ(moment.comments.size(),
+              static_cast<std::size_t>(Moment::PreviewComments));
+    EXPECT_EQ(moment.comments[0].text, "nice 0");
+
+    auto page = client.moments().listComments(bob.token, momentId, 0, 3);
+    ASSERT_TRUE(page.ok());
+    EXPECT_EQ(page.value().comments.size(), 3u);
+    EXPECT_TRUE(page.value().hasMore);
+
+    auto missing = client.moments().likeMoment(bob.token, "nonexistent");
+    ASSERT_FALSE(missing.ok());
+    EXPECT_EQ(missing.error().code, ErrorCode::NotFound);
+}
@@ -47,17 +47,17 @@ TEST_F(IntegrationTest, EndToEndFlow) {
     EXPECT_EQ(sync.value().messages.size(), 1u);
 
     auto msg2 = client->chat().sendMessage(
-        tokenB, chatId, msg1.value().id,
+        tokenB, chatId, msg1.value()->id,
         MessageContent{TextContent{"hey alice!"}});
     ASSERT_TRUE(msg2.ok());
-    EXPECT_EQ(msg2.value().replyTo, msg1.value().id);
+    EXPECT_EQ(msg2.value()->replyTo, msg1.value()->id);
 
     auto sync2 = client->chat().syncMessages(
-        tokenA, chatId, msg1.value().timestamp, 50);
+        tokenA, chatId, msg1.value()->timestamp, 50);
     ASSERT_TRUE(sync2.ok());
     EXPECT_EQ(sync2.value().messages.size(), 1u);
 
-    auto* text = std::get_if<TextContent>(&sync2.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync2.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "hey alice!");
 
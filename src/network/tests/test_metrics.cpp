@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <wechat/log/Metrics.h>
+#include <wechat/network/NetworkClient.h>
+
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace wechat::log;
+using namespace wechat::network;
+
+TEST(MetricsTest, HistogramPercentilesWithinBucketError) {
+    Histogram h;
+    for (uint64_t v = 1; v <= 100000; ++v) h.record(v);
+    auto s = h.snapshot();
+
+    EXPECT_EQ(s.count, 100000u);
+    EXPECT_EQ(s.min, 1u);
+    EXPECT_EQ(s.max, 100000u);
+    EXPECT_DOUBLE_EQ(s.mean(), 50000.5);
+    for (double q : {0.5, 0.99, 0.999}) {
+        auto expected = q * 100000;
+        auto actual = static_cast<double>(s.percentile(q));
+        EXPECT_LE(std::abs(actual - expected) / expected, 1.0 / 32) << q;
+    }
+    EXPECT_EQ(s.percentile(1.0), 100000u);
+
+    // 小值精确，桶边界单调
+    EXPECT_EQ(Histogram::bucketIndex(31), 31u);
+    EXPECT_EQ(Histogram::bucketUpperBound(Histogram::bucketIndex(64)), 65u);
+    EXPECT_EQ(Histogram::bucketIndex(~uint64_t{0}), Histogram::BucketCount - 1);
+    for (std::size_t i = 1; i < Histogram::BucketCount; ++i)
+        ASSERT_GT(Histogram::bucketUpperBound(i),
+                  Histogram::bucketUpperBound(i - 1));
+}
+
+TEST(MetricsTest, ConcurrentRecordingAndDumps) {
+    MetricsRegistry registry;
+    auto& latency = registry.histogram("work");
+    auto& done = registry.counter("work.done");
+    registry.gauge("queue").set(-3);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) {
+                latency.record(static_cast<uint64_t>(i));
+                done.add();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    auto snapshot = registry.snapshot();
+    EXPECT_EQ(snapshot.histogram("work")->count, 40000u);
+    EXPECT_EQ(snapshot.counter("work.done")->value, 40000u);
+    EXPECT_EQ(snapshot.gauge("queue")->value, -3);
+    EXPECT_EQ(snapshot.histogram("missing"), nullptr);
+
+    auto text = snapshot.toText();
+    EXPECT_NE(text.find("counter   work.done 40000"), std::string::npos);
+    EXPECT_NE(text.find("histogram work count=40000"), std::string::npos);
+    auto json = snapshot.toJson();
+    EXPECT_NE(json.find(R"("counters":{"work.done":40000})"),
+              std::string::npos);
+    EXPECT_NE(json.find(R"("gauges":{"queue":-3})"), std::string::npos);
+    EXPECT_NE(json.find(R"("histograms":{"work":{"count":40000,)"),
+              std::string::npos);
+
+    registry.reset();
+    EXPECT_EQ(registry.snapshot().histogram("work")->count, 0u);
+    EXPECT_EQ(&registry.counter("work.done"), &done);
+}
+
+TEST(MetricsTest, HistogramShardsFollowThreads) {
+    // 线程数多于 CPU，且分两批：退出线程的分片被复用，数据仍计入快照
+    Histogram h;
+    for (int round = 0; round < 2; ++round) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 24; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 1000; ++i)
+                    h.record(static_cast<uint64_t>(t));
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+    auto s = h.snapshot();
+    EXPECT_EQ(s.count, 48000u);
+    EXPECT_EQ(s.min, 0u);
+    EXPECT_EQ(s.max, 23u);
+    EXPECT_EQ(s.sum, 2u * 1000u * (23u * 24u / 2));
+
+    // 本线程写过的直方图销毁后，新直方图不会拿到旧分片
+    for (int i = 0; i < 3; ++i) {
+        auto other = std::make_unique<Histogram>();
+        other->record(7);
+        EXPECT_EQ(other->snapshot().count, 1u);
+    }
+}
+
+TEST(MetricsTest, MeteredClientTimesEveryCallAndCountsErrors) {
+    MetricsRegistry registry;
+    auto client = withMetrics(createMockClient(), registry);
+
+    auto reg = client->auth().registerUser("alice", "p");
+    ASSERT_TRUE(reg.ok());
+    EXPECT_FALSE(client->auth().login("alice", "wrong").ok());
+    EXPECT_TRUE(client->auth().login("alice", "p").ok());
+    auto group = client->groups().createGroup(reg.value().token,
+                                              {reg.value().userId});
+    wechat::core::MessageContent content = {wechat::core::TextContent{"hi"}};
+    for (int i = 0; i < 10; ++i) {
+        client->chat().sendMessage(reg.value().token, group.value().id, "",
+                                   content);
+    }
+    client->contacts().searchUser(reg.value().token, "ali");
+
+    auto s = registry.snapshot();
+    EXPECT_EQ(s.histogram("rpc.auth.login")->count, 2u);
+    EXPECT_EQ(s.counter("rpc.auth.login.errors")->value, 1u);
+    EXPECT_EQ(s.histogram("rpc.chat.sendMessage")->count, 10u);
+    EXPECT_EQ(s.counter("rpc.chat.sendMessage.errors")->value, 0u);
+    EXPECT_GT(s.histogram("rpc.chat.sendMessage")->percentile(0.99), 0u);
+    EXPECT_EQ(s.histogram("rpc.contacts.searchUser")->count, 1u);
+    // 所有方法在构造时注册，未调用的计数为 0
+    EXPECT_EQ(s.histogram("rpc.moments.listComments")->count, 0u);
+}
@@ -3,7 +3,12 @@
 #include <wechat/network/NetworkClient.h>
 #include <wechat/network/NetworkTypes.h>
 
+#include "MockDataStore.h"
+
+#include <limits>
+
 using namespace wechat::network;
+using wechat::core::Id;
 
 class MomentTest : public ::testing::Test {
 protected:
@@ -119,3 +124,120 @@ TEST_F(MomentTest, LikeNonExistentMoment) {
     ASSERT_FALSE(r.ok());
     EXPECT_EQ(r.error().code, ErrorCode::NotFound);
 }
+
+TEST_F(MomentTest, FeedFollowsFriendshipChanges) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto regB = client->auth().registerUser("bob", "p");
+    auto tokenA = regA.value().token;
+    auto tokenB = regB.value().token;
+
+    // 先发布、后加好友：历史动态补进收件箱
+    client->moments().postMoment(tokenA, "before", {});
+    client->contacts().addFriend(tokenB, regA.value().userId);
+    client->moments().postMoment(tokenA, "after", {});
+
+    auto list = client->moments().listMoments(tokenB, INT64_MAX, 50);
+    ASSERT_EQ(list.value().size(), 2u);
+    EXPECT_EQ(list.value()[0].text, "after");
+    EXPECT_EQ(list.value()[1].text, "before");
+
+    client->contacts().removeFriend(tokenB, regA.value().userId);
+    EXPECT_TRUE(client->moments().listMoments(tokenB, INT64_MAX, 50)
+                    .value()
+                    .empty());
+}
+
+TEST_F(MomentTest, ListMomentsReturnsCountsAndCommentPreview) {
+    auto regA = client->auth().registerUser("alice", "p");
+    auto regB = client->auth().registerUser("bob", "p");
+    auto tokenA = regA.value().token;
+    auto tokenB = regB.value().token;
+    client->contacts().addFriend(tokenA, regB.value().userId);
+
+    auto momentId = client->moments().postMoment(tokenA, "viral", {}).value().id;
+    client->moments().likeMoment(tokenA, momentId);
+    client->moments().likeMoment(tokenB, momentId);
+    for (int i = 0; i < 10; ++i) {
+        client->moments().commentMoment(tokenB, momentId,
+                                        "c" + std::to_string(i));
+    }
+
+    auto list = client->moments().listMoments(tokenA, INT64_MAX, 50);
+    ASSERT_EQ(list.value().size(), 1u);
+    auto& m = list.value()[0];
+    EXPECT_EQ(m.likeCount, 2u);
+    EXPECT_TRUE(m.likedByMe);
+    EXPECT_EQ(m.commentCount, 10u);
+    ASSERT_EQ(m.comments.size(), static_cast<std::size_t>(Moment::PreviewComments));
+    EXPECT_EQ(m.comments[0].text, "c0");
+}
+
+TEST_F(MomentTest, ListCommentsPagination) {
+    auto token = registerAndLogin("alice", "p");
+    auto momentId = client->moments().postMoment(token, "post", {}).value().id;
+    for (int i = 0; i < 5; ++i) {
+        client->moments().commentMoment(token, momentId, "c" + std::to_string(i));
+    }
+
+    auto page1 = client->moments().listComments(token, momentId, 0, 3);
+    ASSERT_TRUE(page1.ok());
+    ASSERT_EQ(page1.value().comments.size(), 3u);
+    EXPECT_TRUE(page1.value().hasMore);
+    EXPECT_EQ(page1.value().comments[2].text, "c2");
+
+    auto cursor = page1.value().comments.back().timestamp;
+    auto page2 = client->moments().listComments(token, momentId, cursor, 3);
+    ASSERT_TRUE(page2.ok());
+    ASSERT_EQ(page2.value().comments.size(), 2u);
+    EXPECT_FALSE(page2.value().hasMore);
+    EXPECT_EQ(page2.value().comments[0].text, "c3");
+
+    auto missing = client->moments().listComments(token, "nonexistent", 0, 3);
+    ASSERT_FALSE(missing.ok());
+    EXPECT_EQ(missing.error().code, ErrorCode::NotFound);
+}
+
+TEST_F(MomentTest, ListCommentsClampsHugeLimit) {
+    auto token = registerAndLogin("alice", "p");
+    auto momentId = client->moments().postMoment(token, "post", {}).value().id;
+    for (int i = 0; i <= MomentService::MaxCommentPage; ++i)
+        client->moments().commentMoment(token, momentId, "c");
+
+    auto page = client->moments().listComments(
+        token, momentId, 0, std::numeric_limits<int>::max());
+    ASSERT_TRUE(page.ok());
+    EXPECT_EQ(page.value().comments.size(),
+              static_cast<std::size_t>(MomentService::MaxCommentPage));
+    EXPECT_TRUE(page.value().hasMore);
+}
+
+// ── 推拉结合：超过阈值的作者走读时拉取 ──
+
+TEST(MomentFeedTest, HybridFanoutMergesPushedAndPulled) {
+    MockDataStore store;
+    store.setFeedFanoutThreshold(2);
+
+    // star 有 3 个好友（超过阈值，拉模式），pal 只有 1 个（推模式）
+    for (auto f : {"reader", "f2", "f3"})
+        store.addFriendship(Id("star"), Id(f));
+    store.addFriendship(Id("pal"), Id("reader"));
+
+    store.addMoment(Id("pal"), "pal 1", {});
+    store.addMoment(Id("star"), "star 1", {});
+    store.addMoment(Id("reader"), "mine", {});
+    store.addMoment(Id("pal"), "pal 2", {});
+    store.addMoment(Id("star"), "star 2", {});
+
+    auto feed = store.getFeed(Id("reader"), INT64_MAX, 10);
+    std::vector<std::string> texts;
+    for (auto& m : feed) texts.push_back(m.text);
+    EXPECT_EQ(texts, (std::vector<std::string>{"star 2", "pal 2", "mine",
+                                               "star 1", "pal 1"}));
+
+    auto page = store.getFeed(Id("reader"), feed[1].timestamp, 2);
+    ASSERT_EQ(page.size(), 2u);
+    EXPECT_EQ(page[0].text, "mine");
+    EXPECT_EQ(page[1].text, "star 1");
+
+    EXPECT_TRUE(store.getFeed(Id("stranger"), INT64_MAX, 10).empty());
+}
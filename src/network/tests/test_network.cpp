@@ -212,8 +212,8 @@ TEST_F(NetworkTest, SendAndSyncMessages) {
     MessageContent content = {TextContent{"hello bob!"}};
     auto sent = client->chat().sendMessage(tokenA, chatId, "", content);
     ASSERT_TRUE(sent.ok());
-    EXPECT_EQ(sent.value().senderId, regA.value().userId);
-    EXPECT_EQ(sent.value().chatId, chatId);
+    EXPECT_EQ(sent.value()->senderId, regA.value().userId);
+    EXPECT_EQ(sent.value()->chatId, chatId);
 
     // bob 同步
     auto sync = client->chat().syncMessages(tokenB, chatId, 0, 50);
@@ -221,7 +221,7 @@ TEST_F(NetworkTest, SendAndSyncMessages) {
     EXPECT_EQ(sync.value().messages.size(), 1u);
     EXPECT_FALSE(sync.value().hasMore);
 
-    auto* text = std::get_if<TextContent>(&sync.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "hello bob!");
 }
@@ -250,14 +250,14 @@ TEST_F(NetworkTest, RevokeMessage) {
 
     auto sent = client->chat().sendMessage(
         tokenA, chatId, "", MessageContent{TextContent{"oops"}});
-    auto msgId = sent.value().id;
+    auto msgId = sent.value()->id;
 
     auto r = client->chat().revokeMessage(tokenA, msgId);
     ASSERT_TRUE(r.ok());
 
     // 同步后消息应标记为已撤回
     auto sync = client->chat().syncMessages(tokenA, chatId, 0, 50);
-    EXPECT_TRUE(sync.value().messages[0].revoked);
+    EXPECT_TRUE(sync.value().messages[0]->revoked);
 }
 
 TEST_F(NetworkTest, RevokeOtherUserMessage) {
@@ -273,7 +273,7 @@ TEST_F(NetworkTest, RevokeOtherUserMessage) {
         regA.value().token, chatId, "", MessageContent{TextContent{"hi"}});
 
     // bob 不能撤回 alice 的消息
-    auto r = client->chat().revokeMessage(regB.value().token, sent.value().id);
+    auto r = client->chat().revokeMessage(regB.value().token, sent.value()->id);
     ASSERT_FALSE(r.ok());
     EXPECT_EQ(r.error().code, ErrorCode::PermissionDenied);
 }
@@ -287,17 +287,17 @@ TEST_F(NetworkTest, EditMessage) {
 
     auto sent = client->chat().sendMessage(
         tokenA, chatId, "", MessageContent{TextContent{"typo"}});
-    auto msgId = sent.value().id;
+    auto msgId = sent.value()->id;
 
     MessageContent newContent = {TextContent{"fixed"}};
     auto r = client->chat().editMessage(tokenA, msgId, newContent);
     ASSERT_TRUE(r.ok());
 
     auto sync = client->chat().syncMessages(tokenA, chatId, 0, 50);
-    auto* text = std::get_if<TextContent>(&sync.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "fixed");
-    EXPECT_GT(sync.value().messages[0].editedAt, 0);
+    EXPECT_GT(sync.value().messages[0]->editedAt, 0);
 }
 
 TEST_F(NetworkTest, MarkRead) {
@@ -312,11 +312,11 @@ TEST_F(NetworkTest, MarkRead) {
     auto sent = client->chat().sendMessage(
         regA.value().token, chatId, "", MessageContent{TextContent{"hi"}});
 
-    auto r = client->chat().markRead(regB.value().token, chatId, sent.value().id);
+    auto r = client->chat().markRead(regB.value().token, chatId, sent.value()->id);
     ASSERT_TRUE(r.ok());
 
     auto sync = client->chat().syncMessages(regA.value().token, chatId, 0, 50);
-    EXPECT_EQ(sync.value().messages[0].readCount, 1u);
+    EXPECT_EQ(sync.value().messages[0]->readCount, 1u);
 }
 
 TEST_F(NetworkTest, SyncMessagesPagination) {
@@ -338,7 +338,7 @@ TEST_F(NetworkTest, SyncMessagesPagination) {
     EXPECT_TRUE(sync.value().hasMore);
 
     // 用最后一条的 timestamp 继续同步
-    auto lastTs = sync.value().messages.back().timestamp;
+    auto lastTs = sync.value().messages.back()->timestamp;
     auto sync2 = client->chat().syncMessages(tokenA, chatId, lastTs, 3);
     ASSERT_TRUE(sync2.ok());
     EXPECT_EQ(sync2.value().messages.size(), 2u);
@@ -444,18 +444,18 @@ TEST_F(NetworkTest, EndToEndFlow) {
     EXPECT_EQ(sync.value().messages.size(), 1u);
 
     auto msg2 = client->chat().sendMessage(
-        tokenB, chatId, msg1.value().id,
+        tokenB, chatId, msg1.value()->id,
         MessageContent{TextContent{"hey alice!"}});
     ASSERT_TRUE(msg2.ok());
-    EXPECT_EQ(msg2.value().replyTo, msg1.value().id);
+    EXPECT_EQ(msg2.value()->replyTo, msg1.value()->id);
 
     // alice 同步拿到 bob 的回复
     auto sync2 = client->chat().syncMessages(
-        tokenA, chatId, msg1.value().timestamp, 50);
+        tokenA, chatId, msg1.value()->timestamp, 50);
     ASSERT_TRUE(sync2.ok());
     EXPECT_EQ(sync2.value().messages.size(), 1u);
 
-    auto* text = std::get_if<TextContent>(&sync2.value().messages[0].content[0]);
+    auto* text = std::get_if<TextContent>(&sync2.value().messages[0]->content[0]);
     ASSERT_NE(text, nullptr);
     EXPECT_EQ(text->text, "hey alice!");
 
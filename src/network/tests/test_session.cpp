@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+
+#include "SessionCache.h"
+#include "SessionTable.h"
+#include "TimingWheel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace wechat::network;
+using wechat::core::Id;
+using namespace std::chrono_literals;
+
+// ══════════════════════════════════════════════════
+// TimingWheel
+// ══════════════════════════════════════════════════
+
+TEST(TimingWheelTest, FiresAtDeadline) {
+    TimingWheel wheel;
+    wheel.schedule("a", 5);
+    wheel.schedule("b", 10);
+
+    EXPECT_TRUE(wheel.advance(4).empty());
+    EXPECT_EQ(wheel.advance(5), std::vector<std::string>{"a"});
+    EXPECT_TRUE(wheel.advance(9).empty());
+    EXPECT_EQ(wheel.advance(10), std::vector<std::string>{"b"});
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimingWheelTest, CascadesAcrossLevels) {
+    TimingWheel wheel(100);
+    std::vector<uint64_t> deadlines = {101, 163, 164, 4195, 4196,
+                                       300000, 20000000};
+    for (auto d : deadlines) wheel.schedule(std::to_string(d), d);
+
+    for (auto d : deadlines) {
+        EXPECT_TRUE(wheel.advance(d - 1).empty()) << d;
+        EXPECT_EQ(wheel.advance(d), std::vector<std::string>{std::to_string(d)});
+    }
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimingWheelTest, PastDeadlineFiresOnNextTick) {
+    TimingWheel wheel(50);
+    wheel.schedule("late", 10);
+    EXPECT_EQ(wheel.advance(51), std::vector<std::string>{"late"});
+}
+
+// ══════════════════════════════════════════════════
+// SessionTable
+// ══════════════════════════════════════════════════
+
+class SessionTableTest : public ::testing::Test {
+protected:
+    SessionOptions options() {
+        SessionOptions opts;
+        opts.ttl = 1h;
+        opts.idleTimeout = 10min;
+        opts.tick = 1s;
+        return opts;
+    }
+
+    SessionTable::Clock manualClock() {
+        return [this] { return now.load(); };
+    }
+
+    void advance(std::chrono::milliseconds d) { now += d.count(); }
+
+    std::atomic<int64_t> now{1'000'000};
+};
+
+TEST_F(SessionTableTest, CreateResolveRemove) {
+    SessionTable table(options(), manualClock());
+    auto token = table.create(Id("u1"));
+    EXPECT_EQ(table.resolve(token), "u1");
+    EXPECT_EQ(table.resolve("tok_unknown"), "");
+
+    auto session = table.find(token);
+    table.remove(token);
+    EXPECT_EQ(table.resolve(token), "");
+    EXPECT_TRUE(session->revoked);
+    EXPECT_FALSE(table.touch(*session));
+    EXPECT_EQ(table.size(), 0u);
+}
+
+TEST_F(SessionTableTest, IdleTimeoutExpires) {
+    SessionTable table(options(), manualClock());
+    auto token = table.create(Id("u1"));
+
+    advance(9min);
+    EXPECT_EQ(table.resolve(token), "u1"); // 刷新空闲计时
+    advance(9min);
+    EXPECT_EQ(table.resolve(token), "u1");
+    advance(11min);
+    EXPECT_EQ(table.resolve(token), "");
+}
+
+TEST_F(SessionTableTest, TtlExpiresEvenWhenActive) {
+    SessionTable table(options(), manualClock());
+    auto token = table.create(Id("u1"));
+
+    for (int i = 0; i < 6; ++i) {
+        advance(9min);
+        EXPECT_EQ(table.resolve(token), "u1");
+    }
+    advance(7min);
+    EXPECT_EQ(table.resolve(token), "");
+}
+
+TEST_F(SessionTableTest, CollectExpiredReclaimsOnlyDeadSessions) {
+    SessionTable table(options(), manualClock());
+    auto idle = table.create(Id("u1"));
+    auto active = table.create(Id("u2"));
+    EXPECT_EQ(table.size(), 2u);
+
+    advance(6min);
+    table.resolve(active);
+    advance(5min);
+    EXPECT_EQ(table.collectExpired(), 1u);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.resolve(idle), "");
+    EXPECT_EQ(table.resolve(active), "u2");
+
+    advance(11min);
+    EXPECT_EQ(table.collectExpired(), 1u);
+    EXPECT_EQ(table.size(), 0u);
+}
+
+TEST_F(SessionTableTest, PeriodicCollectRunsOnExecutor) {
+    wechat::core::Executor pool(wechat::core::ExecutorOptions{.threads = 1});
+    auto opts = options();
+    opts.executor = &pool;
+    SessionTable table(opts, manualClock());
+
+    auto idle = table.create(Id("u0"));
+    advance(11min);
+    // 第 64 次 create 触发回收，投递到线程池执行
+    for (int i = 1; i < 64; ++i) table.create(Id("u" + std::to_string(i)));
+    pool.waitIdle();
+
+    EXPECT_EQ(pool.stats().completed, 1u);
+    EXPECT_EQ(table.size(), 63u);
+    EXPECT_EQ(table.resolve(idle), "");
+}
+
+TEST_F(SessionTableTest, ConcurrentResolveDuringChurn) {
+    SessionTable table(options(), manualClock());
+    std::vector<std::string> stable;
+    for (int i = 0; i < 100; ++i)
+        stable.push_back(table.create(Id("u" + std::to_string(i))));
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        while (!stop) table.remove(table.create(Id("churn")));
+    });
+
+    std::vector<std::thread> readers;
+    std::atomic<int> mismatches{0};
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            for (int round = 0; round < 200; ++round) {
+                for (int i = 0; i < 100; ++i) {
+                    if (table.resolve(stable[i]) != "u" + std::to_string(i))
+                        ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& r : readers) r.join();
+    stop = true;
+    writer.join();
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_F(SessionTableTest, ResolveWhileShardsGrow) {
+    // 读者不加锁：桶表翻倍与摘链期间，已有会话始终可见
+    SessionTable table(options(), manualClock());
+    std::vector<std::string> stable;
+    for (int i = 0; i < 64; ++i)
+        stable.push_back(table.create(Id("u" + std::to_string(i))));
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        for (int i = 0; i < 20000; ++i) {
+            auto token = table.create(Id("grow"));
+            if (i % 2) table.remove(token);
+        }
+        stop = true;
+    });
+    std::atomic<int> mismatches{0};
+    std::thread reader([&] {
+        while (!stop) {
+            for (int i = 0; i < 64; ++i) {
+                if (table.resolve(stable[i]) != "u" + std::to_string(i))
+                    ++mismatches;
+            }
+        }
+    });
+    writer.join();
+    reader.join();
+    EXPECT_EQ(mismatches, 0);
+    EXPECT_EQ(table.size(), 64u + 10000u);
+}
+
+// ══════════════════════════════════════════════════
+// SessionCache
+// ══════════════════════════════════════════════════
+
+TEST_F(SessionTableTest, CacheInvalidatedByRemove) {
+    SessionTable table(options(), manualClock());
+    SessionCache cache(table, 16);
+    auto token = table.create(Id("u1"));
+
+    EXPECT_EQ(cache.resolve(token), "u1");
+    EXPECT_EQ(cache.resolve(token), "u1");
+    table.remove(token);
+    EXPECT_EQ(cache.resolve(token), "");
+}
+
+TEST_F(SessionTableTest, CacheInvalidatesOnlyTheRemovedToken) {
+    SessionTable table(options(), manualClock());
+    SessionCache cache(table, 16);
+    std::vector<std::string> tokens;
+    for (int i = 0; i < 8; ++i) {
+        tokens.push_back(table.create(Id("u" + std::to_string(i))));
+        EXPECT_EQ(cache.resolve(tokens.back()), "u" + std::to_string(i));
+    }
+
+    table.remove(tokens[3]);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(cache.resolve(tokens[i]),
+                  i == 3 ? "" : "u" + std::to_string(i));
+    }
+}
+
+TEST_F(SessionTableTest, CacheRespectsExpiry) {
+    SessionTable table(options(), manualClock());
+    SessionCache cache(table, 16);
+    auto token = table.create(Id("u1"));
+
+    EXPECT_EQ(cache.resolve(token), "u1");
+    advance(11min);
+    EXPECT_EQ(cache.resolve(token), "");
+}
@@ -1,4 +1,7 @@
 #include "wechat/storage/FriendshipDao.h"
+
+#include <wechat/log/Metrics.h>
+
 #include <algorithm>
 
 namespace wechat {
@@ -12,6 +15,7 @@ std::pair<std::string, std::string> FriendshipDao::ordered(
 }
 
 void FriendshipDao::add(const std::string& userA, const std::string& userB) {
+    WECHAT_TIMED_SCOPE("db.friendship.add");
     auto [a, b] = ordered(userA, userB);
     SQLite::Statement stmt(db_,
         "INSERT OR IGNORE INTO friendships (user_id_a, user_id_b) VALUES (?, ?)");
@@ -21,6 +25,7 @@ void FriendshipDao::add(const std::string& userA, const std::string& userB) {
 }
 
 void FriendshipDao::remove(const std::string& userA, const std::string& userB) {
+    WECHAT_TIMED_SCOPE("db.friendship.remove");
     auto [a, b] = ordered(userA, userB);
     SQLite::Statement stmt(db_,
         "DELETE FROM friendships WHERE user_id_a = ? AND user_id_b = ?");
@@ -30,6 +35,7 @@ void FriendshipDao::remove(const std::string& userA, const std::string& userB) {
 }
 
 bool FriendshipDao::isFriend(const std::string& userA, const std::string& userB) {
+    WECHAT_TIMED_SCOPE("db.friendship.isFriend");
     auto [a, b] = ordered(userA, userB);
     SQLite::Statement stmt(db_,
         "SELECT 1 FROM friendships WHERE user_id_a = ? AND user_id_b = ?");
@@ -39,6 +45,7 @@ bool FriendshipDao::isFriend(const std::string& userA, const std::string& userB)
 }
 
 std::vector<std::string> FriendshipDao::findFriends(const std::string& userId) {
+    WECHAT_TIMED_SCOPE("db.friendship.findFriends");
     std::vector<std::string> friends;
 
     // userId 作为 a
@@ -1,13 +1,25 @@
 #include "wechat/storage/GroupDao.h"
 
+#include <wechat/log/Metrics.h>
+
 namespace wechat {
 namespace storage {
 
+namespace {
+
+/// 数据库里的成员 id 列表 -> 驻留 Id
+std::vector<core::Id> toIds(const std::vector<std::string>& ids) {
+    return {ids.begin(), ids.end()};
+}
+
+} // namespace
+
 GroupDao::GroupDao(SQLite::Database& db) : db_(db) {}
 
 // ── groups_ 表 ──
 
 void GroupDao::insertGroup(const core::Group& group, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.group.insertGroup");
     SQLite::Statement stmt(db_,
         "INSERT OR REPLACE INTO groups_ (id, owner_id, updated_at) VALUES (?, ?, ?)");
     stmt.bind(1, group.id);
@@ -23,6 +35,7 @@ void GroupDao::insertGroup(const core::Group& group, int64_t now) {
 
 void GroupDao::updateOwner(const std::string& groupId,
                            const std::string& ownerId, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.group.updateOwner");
     SQLite::Statement stmt(db_,
         "UPDATE groups_ SET owner_id = ?, updated_at = ? WHERE id = ?");
     stmt.bind(1, ownerId);
@@ -32,20 +45,22 @@ void GroupDao::updateOwner(const std::string& groupId,
 }
 
 void GroupDao::removeGroup(const std::string& groupId) {
+    WECHAT_TIMED_SCOPE("db.group.removeGroup");
     db_.exec("DELETE FROM group_members WHERE group_id = '" + groupId + "'");
     db_.exec("DELETE FROM groups_ WHERE id = '" + groupId + "'");
 }
 
 std::optional<core::Group> GroupDao::findGroupById(const std::string& id) {
+    WECHAT_TIMED_SCOPE("db.group.findGroupById");
     SQLite::Statement stmt(db_,
         "SELECT id, owner_id FROM groups_ WHERE id = ?");
     stmt.bind(1, id);
     if (!stmt.executeStep()) return std::nullopt;
 
     core::Group g;
-    g.id = stmt.getColumn(0).getString();
-    g.ownerId = stmt.getColumn(1).getString();
-    g.memberIds = findMemberIds(id);
+    g.id = core::Id(stmt.getColumn(0).getString());
+    g.ownerId = core::Id(stmt.getColumn(1).getString());
+    g.memberIds = toIds(findMemberIds(id));
     return g;
 }
 
@@ -53,6 +68,7 @@ std::optional<core::Group> GroupDao::findGroupById(const std::string& id) {
 
 void GroupDao::addMember(const std::string& groupId,
                          const std::string& userId, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.group.addMember");
     SQLite::Statement stmt(db_, R"(
         INSERT INTO group_members (group_id, user_id, joined_at, removed, updated_at)
         VALUES (?, ?, ?, 0, ?)
@@ -68,6 +84,7 @@ void GroupDao::addMember(const std::string& groupId,
 
 void GroupDao::removeMember(const std::string& groupId,
                             const std::string& userId, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.group.removeMember");
     SQLite::Statement stmt(db_, R"(
         UPDATE group_members SET removed = 1, updated_at = ?
         WHERE group_id = ? AND user_id = ?
@@ -79,6 +96,7 @@ void GroupDao::removeMember(const std::string& groupId,
 }
 
 std::vector<std::string> GroupDao::findMemberIds(const std::string& groupId) {
+    WECHAT_TIMED_SCOPE("db.group.findMemberIds");
     std::vector<std::string> ids;
     SQLite::Statement stmt(db_,
         "SELECT user_id FROM group_members WHERE group_id = ? AND removed = 0");
@@ -90,6 +108,7 @@ std::vector<std::string> GroupDao::findMemberIds(const std::string& groupId) {
 }
 
 std::vector<std::string> GroupDao::findGroupIdsByUser(const std::string& userId) {
+    WECHAT_TIMED_SCOPE("db.group.findGroupIdsByUser");
     std::vector<std::string> ids;
     SQLite::Statement stmt(db_,
         "SELECT group_id FROM group_members WHERE user_id = ? AND removed = 0");
@@ -103,21 +122,23 @@ std::vector<std::string> GroupDao::findGroupIdsByUser(const std::string& userId)
 // ── 增量同步 ──
 
 std::vector<core::Group> GroupDao::findGroupsUpdatedAfter(int64_t since) {
+    WECHAT_TIMED_SCOPE("db.group.findGroupsUpdatedAfter");
     std::vector<core::Group> result;
     SQLite::Statement stmt(db_,
         "SELECT id, owner_id FROM groups_ WHERE updated_at > ?");
     stmt.bind(1, since);
     while (stmt.executeStep()) {
         core::Group g;
-        g.id = stmt.getColumn(0).getString();
-        g.ownerId = stmt.getColumn(1).getString();
-        g.memberIds = findMemberIds(g.id);
+        g.id = core::Id(stmt.getColumn(0).getString());
+        g.ownerId = core::Id(stmt.getColumn(1).getString());
+        g.memberIds = toIds(findMemberIds(g.id));
         result.push_back(std::move(g));
     }
     return result;
 }
 
 std::vector<GroupDao::MemberChange> GroupDao::findMemberChangesAfter(int64_t since) {
+    WECHAT_TIMED_SCOPE("db.group.findMemberChangesAfter");
     std::vector<MemberChange> result;
     SQLite::Statement stmt(db_, R"(
         SELECT group_id, user_id, removed, updated_at
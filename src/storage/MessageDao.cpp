@@ -1,6 +1,11 @@
 #include "wechat/storage/MessageDao.h"
+#include <wechat/log/Metrics.h>
+#include <wechat/log/Trace.h>
+
 #include <nlohmann/json.hpp>
 
+#include <charconv>
+
 using json = nlohmann::json;
 
 namespace wechat {
@@ -8,16 +13,81 @@ namespace storage {
 
 // ── JSON 序列化 ──
 
+/// 按资源大类构造空的媒体属性
+static core::MediaAttributes mediaFor(core::ResourceType type) {
+    switch (type) {
+    case core::ResourceType::Image: return core::ImageAttributes{};
+    case core::ResourceType::Video: return core::VideoAttributes{};
+    case core::ResourceType::Audio: return core::AudioAttributes{};
+    default: return std::monostate{};
+    }
+}
+
+static constexpr std::string_view MediaKeys[] = {"width", "height", "duration"};
+
+/// 已知属性键对应的字段；该媒体类型没有这个属性时返回 nullptr
+static uint32_t* mediaField(core::MediaAttributes& media, std::string_view key) {
+    return std::visit([key](auto& attrs) -> uint32_t* {
+        if constexpr (requires { attrs.width; attrs.height; }) {
+            if (key == "width") return &attrs.width;
+            if (key == "height") return &attrs.height;
+        }
+        if constexpr (requires { attrs.duration; }) {
+            if (key == "duration") return &attrs.duration;
+        }
+        return nullptr;
+    }, media);
+}
+
 static json metaToJson(const core::ResourceMeta& m) {
-    return {{"size", m.size}, {"filename", m.filename}, {"extra", m.extra}};
+    json j = {{"size", m.size}, {"filename", std::string_view(m.filename)}};
+    std::visit([&j](const auto& attrs) {
+        if constexpr (requires { attrs.width; attrs.height; }) {
+            j["width"] = attrs.width;
+            j["height"] = attrs.height;
+        }
+        if constexpr (requires { attrs.duration; }) {
+            j["duration"] = attrs.duration;
+        }
+    }, m.media);
+    if (!m.extra.empty()) {
+        json extra = json::object();
+        for (const auto& [key, value] : m.extra) {
+            extra[std::string(key)] = std::string_view(value);
+        }
+        j["extra"] = std::move(extra);
+    }
+    return j;
 }
 
-static core::ResourceMeta jsonToMeta(const json& j) {
-    core::ResourceMeta m;
-    m.size = j.value("size", std::size_t{0});
+static core::ResourceMeta jsonToMeta(const json& j, core::ResourceType type,
+                                     std::pmr::polymorphic_allocator<> alloc) {
+    core::ResourceMeta m{j.value("size", std::size_t{0}),
+                         std::pmr::string(alloc), mediaFor(type),
+                         core::ResourceExtra(alloc)};
     m.filename = j.value("filename", "");
-    if (j.contains("extra")) {
-        m.extra = j["extra"].get<std::map<std::string, std::string>>();
+    for (auto key : MediaKeys) {
+        auto* field = mediaField(m.media, key);
+        auto it = j.find(key);
+        if (field && it != j.end() && it->is_number_unsigned())
+            *field = it->get<uint32_t>();
+    }
+    // 旧数据把宽高 / 时长以字符串存在 extra 里，读取时迁移到定长字段
+    if (auto it = j.find("extra"); it != j.end() && it->is_object()) {
+        for (const auto& [key, value] : it->items()) {
+            if (!value.is_string()) continue;
+            const auto& text = value.get_ref<const std::string&>();
+            if (auto* field = mediaField(m.media, key)) {
+                uint32_t parsed = 0;
+                auto* last = text.data() + text.size();
+                auto [end, ec] = std::from_chars(text.data(), last, parsed);
+                if (ec == std::errc() && end == last) {
+                    *field = parsed;
+                    continue;
+                }
+            }
+            m.extra.emplace(key, text);
+        }
     }
     return m;
 }
@@ -28,10 +98,10 @@ static json blockToJson(const core::ContentBlock& block) {
         if constexpr (std::is_same_v<T, std::monostate>) {
             return {{"type", 0}};
         } else if constexpr (std::is_same_v<T, core::TextContent>) {
-            return {{"type", 1}, {"text", arg.text}};
+            return {{"type", 1}, {"text", std::string_view(arg.text)}};
         } else if constexpr (std::is_same_v<T, core::ResourceContent>) {
             return {{"type", 2},
-                    {"resourceId", arg.resourceId},
+                    {"resourceId", std::string_view(arg.resourceId)},
                     {"resType", static_cast<int>(arg.type)},
                     {"resSubtype", static_cast<int>(arg.subtype)},
                     {"meta", metaToJson(arg.meta)}};
@@ -39,25 +109,35 @@ static json blockToJson(const core::ContentBlock& block) {
     }, block);
 }
 
-static core::ContentBlock jsonToBlock(const json& j) {
+/// 解码一个内容块，直接追加到 content（字符串分配在 content 的内存资源上）
+static void appendBlock(const json& j, core::MessageContent& content) {
+    auto alloc = content.get_allocator();
     int type = j.value("type", 0);
     switch (type) {
     case 1:
-        return core::TextContent{j.value("text", "")};
+        content.emplace_back(std::in_place_type<core::TextContent>,
+                             j.value("text", ""), alloc);
+        break;
     case 2: {
-        core::ResourceContent rc;
+        auto& rc = std::get<core::ResourceContent>(content.emplace_back(
+            core::ResourceContent{std::pmr::string(alloc),
+                                  {},
+                                  {},
+                                  {0, std::pmr::string(alloc), {},
+                                   core::ResourceExtra(alloc)}}));
         rc.resourceId = j.value("resourceId", "");
         rc.type = static_cast<core::ResourceType>(j.value("resType", 0));
         rc.subtype = static_cast<core::ResourceSubtype>(j.value("resSubtype", 0));
-        if (j.contains("meta")) rc.meta = jsonToMeta(j["meta"]);
-        return rc;
+        if (j.contains("meta")) rc.meta = jsonToMeta(j["meta"], rc.type, alloc);
+        break;
     }
     default:
-        return std::monostate{};
+        content.emplace_back(std::monostate{});
     }
 }
 
 std::string serializeContent(const core::MessageContent& content) {
+    WECHAT_TRACE_SCOPE("serializeContent", "storage");
     json arr = json::array();
     for (const auto& block : content) {
         arr.push_back(blockToJson(block));
@@ -65,21 +145,34 @@ std::string serializeContent(const core::MessageContent& content) {
     return arr.dump();
 }
 
-core::MessageContent deserializeContent(const std::string& str) {
-    core::MessageContent content;
+core::MessageContent deserializeContent(
+    const std::string& str, std::pmr::polymorphic_allocator<> alloc) {
+    WECHAT_TRACE_SCOPE("deserializeContent", "storage");
+    core::MessageContent content(alloc);
     auto arr = json::parse(str, nullptr, false);
     if (arr.is_discarded() || !arr.is_array()) return content;
+    content.reserve(arr.size());
     for (const auto& item : arr) {
-        content.push_back(jsonToBlock(item));
+        appendBlock(item, content);
     }
     return content;
 }
 
+std::future<core::MessageContent> deserializeContentAsync(
+    core::Executor& executor, std::string json, core::TaskPriority priority,
+    core::CancellationToken token) {
+    return executor.submit(
+        [json = std::move(json)] { return deserializeContent(json); },
+        priority, std::move(token));
+}
+
 // ── MessageDao ──
 
 MessageDao::MessageDao(SQLite::Database& db) : db_(db) {}
 
 void MessageDao::insert(const core::Message& msg) {
+    WECHAT_TIMED_SCOPE("db.message.insert");
+    WECHAT_TRACE_SCOPE("MessageDao::insert", "storage");
     SQLite::Statement stmt(db_, R"(
         INSERT OR REPLACE INTO messages
         (id, sender_id, chat_id, reply_to, content_data, timestamp,
@@ -100,6 +193,8 @@ void MessageDao::insert(const core::Message& msg) {
 }
 
 void MessageDao::update(const core::Message& msg) {
+    WECHAT_TIMED_SCOPE("db.message.update");
+    WECHAT_TRACE_SCOPE("MessageDao::update", "storage");
     SQLite::Statement stmt(db_, R"(
         UPDATE messages SET
             sender_id = ?, chat_id = ?, reply_to = ?, content_data = ?,
@@ -120,12 +215,16 @@ void MessageDao::update(const core::Message& msg) {
 }
 
 void MessageDao::remove(const std::string& id) {
+    WECHAT_TIMED_SCOPE("db.message.remove");
+    WECHAT_TRACE_SCOPE("MessageDao::remove", "storage");
     SQLite::Statement stmt(db_, "DELETE FROM messages WHERE id = ?");
     stmt.bind(1, id);
     stmt.exec();
 }
 
 std::optional<core::Message> MessageDao::findById(const std::string& id) {
+    WECHAT_TIMED_SCOPE("db.message.findById");
+    WECHAT_TRACE_SCOPE("MessageDao::findById", "storage");
     SQLite::Statement stmt(db_, R"(
         SELECT id, sender_id, chat_id, reply_to, content_data,
                timestamp, edited_at, revoked, read_count, updated_at
@@ -136,9 +235,11 @@ std::optional<core::Message> MessageDao::findById(const std::string& id) {
     return rowToMessage(stmt);
 }
 
-std::vector<core::Message> MessageDao::findByChat(
+core::MessagePage MessageDao::findByChat(
     const std::string& chatId, int64_t beforeTimestamp, int limit) {
-    std::vector<core::Message> result;
+    WECHAT_TIMED_SCOPE("db.message.findByChat");
+    WECHAT_TRACE_SCOPE("MessageDao::findByChat", "storage");
+    core::MessagePage result;
     SQLite::Statement stmt(db_, R"(
         SELECT id, sender_id, chat_id, reply_to, content_data,
                timestamp, edited_at, revoked, read_count, updated_at
@@ -150,14 +251,16 @@ std::vector<core::Message> MessageDao::findByChat(
     stmt.bind(2, beforeTimestamp);
     stmt.bind(3, limit);
     while (stmt.executeStep()) {
-        result.push_back(rowToMessage(stmt));
+        result.add(rowToMessage(stmt, result.allocator()));
     }
     return result;
 }
 
-std::vector<core::Message> MessageDao::findAfter(
+core::MessagePage MessageDao::findAfter(
     const std::string& chatId, int64_t afterTs, int limit) {
-    std::vector<core::Message> result;
+    WECHAT_TIMED_SCOPE("db.message.findAfter");
+    WECHAT_TRACE_SCOPE("MessageDao::findAfter", "storage");
+    core::MessagePage result;
     SQLite::Statement stmt(db_, R"(
         SELECT id, sender_id, chat_id, reply_to, content_data,
                timestamp, edited_at, revoked, read_count, updated_at
@@ -169,14 +272,16 @@ std::vector<core::Message> MessageDao::findAfter(
     stmt.bind(2, afterTs);
     stmt.bind(3, limit);
     while (stmt.executeStep()) {
-        result.push_back(rowToMessage(stmt));
+        result.add(rowToMessage(stmt, result.allocator()));
     }
     return result;
 }
 
-std::vector<core::Message> MessageDao::findBefore(
+core::MessagePage MessageDao::findBefore(
     const std::string& chatId, int64_t beforeTs, int limit) {
-    std::vector<core::Message> result;
+    WECHAT_TIMED_SCOPE("db.message.findBefore");
+    WECHAT_TRACE_SCOPE("MessageDao::findBefore", "storage");
+    core::MessagePage result;
     SQLite::Statement stmt(db_, R"(
         SELECT id, sender_id, chat_id, reply_to, content_data,
                timestamp, edited_at, revoked, read_count, updated_at
@@ -188,14 +293,16 @@ std::vector<core::Message> MessageDao::findBefore(
     stmt.bind(2, beforeTs);
     stmt.bind(3, limit);
     while (stmt.executeStep()) {
-        result.push_back(rowToMessage(stmt));
+        result.add(rowToMessage(stmt, result.allocator()));
     }
     return result;
 }
 
-std::vector<core::Message> MessageDao::findUpdatedAfter(
+core::MessagePage MessageDao::findUpdatedAfter(
     const std::string& chatId, int64_t since) {
-    std::vector<core::Message> result;
+    WECHAT_TIMED_SCOPE("db.message.findUpdatedAfter");
+    WECHAT_TRACE_SCOPE("MessageDao::findUpdatedAfter", "storage");
+    core::MessagePage result;
     SQLite::Statement stmt(db_, R"(
         SELECT id, sender_id, chat_id, reply_to, content_data,
                timestamp, edited_at, revoked, read_count, updated_at
@@ -206,27 +313,31 @@ std::vector<core::Message> MessageDao::findUpdatedAfter(
     stmt.bind(1, chatId);
     stmt.bind(2, since);
     while (stmt.executeStep()) {
-        result.push_back(rowToMessage(stmt));
+        result.add(rowToMessage(stmt, result.allocator()));
     }
     return result;
 }
 
-core::Message MessageDao::rowToMessage(SQLite::Statement& stmt) {
-    core::Message msg;
-    msg.id = stmt.getColumn(0).getString();
-    msg.senderId = stmt.getColumn(1).getString();
-    msg.chatId = stmt.getColumn(2).getString();
-    msg.replyTo = stmt.getColumn(3).getString();
-    msg.content = deserializeContent(stmt.getColumn(4).getString());
-    msg.timestamp = stmt.getColumn(5).getInt64();
-    msg.editedAt = stmt.getColumn(6).getInt64();
-    msg.revoked = stmt.getColumn(7).getInt() != 0;
-    msg.readCount = static_cast<uint32_t>(stmt.getColumn(8).getInt());
-    msg.updatedAt = stmt.getColumn(9).getInt64();
-    return msg;
+core::Message MessageDao::rowToMessage(
+    SQLite::Statement& stmt, std::pmr::polymorphic_allocator<> alloc) {
+    // content 必须在构造时带上分配器，赋值会按目标容器的分配器拷贝
+    return core::Message{
+        .id = core::Id(stmt.getColumn(0).getString()),
+        .senderId = core::Id(stmt.getColumn(1).getString()),
+        .chatId = core::Id(stmt.getColumn(2).getString()),
+        .replyTo = core::Id(stmt.getColumn(3).getString()),
+        .content = deserializeContent(stmt.getColumn(4).getString(), alloc),
+        .timestamp = stmt.getColumn(5).getInt64(),
+        .editedAt = stmt.getColumn(6).getInt64(),
+        .revoked = stmt.getColumn(7).getInt() != 0,
+        .readCount = static_cast<uint32_t>(stmt.getColumn(8).getInt()),
+        .updatedAt = stmt.getColumn(9).getInt64(),
+    };
 }
 
 void MessageDao::revoke(const std::string& id, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.message.revoke");
+    WECHAT_TRACE_SCOPE("MessageDao::revoke", "storage");
     SQLite::Statement stmt(db_, R"(
         UPDATE messages SET revoked = 1, updated_at = ? WHERE id = ?
     )");
@@ -237,6 +348,8 @@ void MessageDao::revoke(const std::string& id, int64_t now) {
 
 void MessageDao::editContent(const std::string& id,
                              const core::MessageContent& content, int64_t now) {
+    WECHAT_TIMED_SCOPE("db.message.editContent");
+    WECHAT_TRACE_SCOPE("MessageDao::editContent", "storage");
     SQLite::Statement stmt(db_, R"(
         UPDATE messages SET content_data = ?, edited_at = ?, updated_at = ? WHERE id = ?
     )");
@@ -249,6 +362,8 @@ void MessageDao::editContent(const std::string& id,
 
 void MessageDao::updateReadCount(const std::string& id, uint32_t readCount,
                                  int64_t now) {
+    WECHAT_TIMED_SCOPE("db.message.updateReadCount");
+    WECHAT_TRACE_SCOPE("MessageDao::updateReadCount", "storage");
     SQLite::Statement stmt(db_, R"(
         UPDATE messages SET read_count = ?, updated_at = ? WHERE id = ?
     )");
@@ -1,11 +1,14 @@
 #include "wechat/storage/UserDao.h"
 
+#include <wechat/log/Metrics.h>
+
 namespace wechat {
 namespace storage {
 
 UserDao::UserDao(SQLite::Database& db) : db_(db) {}
 
 void UserDao::insert(const core::User& user) {
+    WECHAT_TIMED_SCOPE("db.user.insert");
     SQLite::Statement stmt(db_,
         "INSERT OR REPLACE INTO users (id) VALUES (?)");
     stmt.bind(1, user.id);
@@ -13,25 +16,28 @@ void UserDao::insert(const core::User& user) {
 }
 
 void UserDao::remove(const std::string& id) {
+    WECHAT_TIMED_SCOPE("db.user.remove");
     SQLite::Statement stmt(db_, "DELETE FROM users WHERE id = ?");
     stmt.bind(1, id);
     stmt.exec();
 }
 
 std::optional<core::User> UserDao::findById(const std::string& id) {
+    WECHAT_TIMED_SCOPE("db.user.findById");
     SQLite::Statement stmt(db_, "SELECT id FROM users WHERE id = ?");
     stmt.bind(1, id);
     if (stmt.executeStep()) {
-        return core::User{stmt.getColumn(0).getString()};
+        return core::User{core::Id(stmt.getColumn(0).getString())};
     }
     return std::nullopt;
 }
 
 std::vector<core::User> UserDao::findAll() {
+    WECHAT_TIMED_SCOPE("db.user.findAll");
     std::vector<core::User> result;
     SQLite::Statement stmt(db_, "SELECT id FROM users");
     while (stmt.executeStep()) {
-        result.push_back(core::User{stmt.getColumn(0).getString()});
+        result.push_back(core::User{core::Id(stmt.getColumn(0).getString())});
     }
     return result;
 }
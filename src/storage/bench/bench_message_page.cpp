@@ -0,0 +1,136 @@
+// 一页消息解码 / 拷贝时的堆分配次数：std::vector + 默认堆 vs MessagePage
+
+#include <wechat/core/MessagePage.h>
+#include <wechat/storage/MessageDao.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace wechat;
+
+// ── 统计 operator new 调用次数（pmr 默认资源走对齐版本，一并统计） ──
+
+namespace {
+std::size_t allocations = 0;
+}
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (auto *p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+    ++allocations;
+    auto alignment = static_cast<std::size_t>(align);
+    auto rounded = (size + alignment - 1) / alignment * alignment;
+    if (auto *p = std::aligned_alloc(alignment, rounded)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int PageSize = 200;
+constexpr int Rounds = 200;
+
+/// 图文混排消息：一段长文本 + 一张带扩展元信息的图片
+core::Message makeMessage(int i) {
+    core::Message msg{};
+    msg.id = core::Id("m" + std::to_string(i));
+    msg.senderId = core::Id("u1");
+    msg.chatId = core::Id("g1");
+    msg.content = {
+        core::TextContent{"a message long enough to leave the small string "
+                          "buffer, number " +
+                          std::to_string(i)},
+        core::ResourceContent{
+            std::pmr::string("resource-0000000000000000-" + std::to_string(i)),
+            core::ResourceType::Image, core::ResourceSubtype::Jpeg,
+            core::ResourceMeta{2048,
+                               "holiday-photo-from-the-beach.jpg",
+                               core::ImageAttributes{1920, 1080},
+                               {}}}};
+    msg.timestamp = i;
+    return msg;
+}
+
+struct Sample {
+    double allocationsPerPage;
+    double microsPerPage;
+};
+
+template <typename F> Sample measure(F &&decodePage) {
+    auto before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < Rounds; ++r) decodePage();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return {static_cast<double>(allocations - before) / Rounds,
+            std::chrono::duration<double, std::micro>(elapsed).count() /
+                Rounds};
+}
+
+void report(char const *name, Sample heap, Sample page) {
+    std::printf("%-24s %14.0f %14.0f %12.1f %12.1f\n", name,
+                heap.allocationsPerPage, page.allocationsPerPage,
+                heap.microsPerPage, page.microsPerPage);
+}
+
+} // namespace
+
+int main() {
+    std::vector<core::Message> source;
+    std::vector<std::string> rows;
+    for (int i = 0; i < PageSize; ++i) {
+        source.push_back(makeMessage(i));
+        rows.push_back(storage::serializeContent(source.back().content));
+    }
+
+    std::printf("%d messages per page, %d pages\n", PageSize, Rounds);
+    std::printf("%-24s %14s %14s %12s %12s\n", "", "allocs (heap)",
+                "allocs (page)", "us (heap)", "us (page)");
+
+    // 从存储解码：content_data JSON -> MessageContent
+    auto decodeHeap = measure([&] {
+        std::vector<core::Message> page;
+        page.reserve(PageSize);
+        for (int i = 0; i < PageSize; ++i) {
+            page.push_back(core::Message{
+                .id = source[i].id,
+                .content = storage::deserializeContent(rows[i])});
+        }
+    });
+    auto decodePage = measure([&] {
+        core::MessagePage page;
+        page.reserve(PageSize);
+        for (int i = 0; i < PageSize; ++i) {
+            page.add(core::Message{
+                .id = source[i].id,
+                .content = storage::deserializeContent(rows[i],
+                                                       page.allocator())});
+        }
+    });
+    report("decode (MessageDao)", decodeHeap, decodePage);
+
+    // 同步响应：从服务端内存拷贝一页
+    auto copyHeap = measure([&] {
+        std::vector<core::Message> page(source.begin(), source.end());
+    });
+    auto copyPage = measure([&] {
+        core::MessagePage page;
+        page.reserve(PageSize);
+        for (auto &msg : source) page.add(msg);
+    });
+    report("copy (syncMessages)", copyHeap, copyPage);
+    return 0;
+}
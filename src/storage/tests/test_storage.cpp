@@ -5,6 +5,7 @@
 #include "wechat/storage/GroupDao.h"
 #include "wechat/storage/MessageDao.h"
 #include "wechat/storage/FriendshipDao.h"
+#include <wechat/log/Metrics.h>
 
 using namespace wechat::core;
 using namespace wechat::storage;
@@ -22,8 +23,8 @@ protected:
 
 TEST_F(StorageDaoTest, UserInsertAndFind) {
     UserDao dao(dbm->db());
-    dao.insert(User{"u1"});
-    dao.insert(User{"u2"});
+    dao.insert(User{Id("u1")});
+    dao.insert(User{Id("u2")});
 
     auto u = dao.findById("u1");
     ASSERT_TRUE(u.has_value());
@@ -37,11 +38,38 @@ TEST_F(StorageDaoTest, UserInsertAndFind) {
 
 TEST_F(StorageDaoTest, UserRemove) {
     UserDao dao(dbm->db());
-    dao.insert(User{"u1"});
+    dao.insert(User{Id("u1")});
     dao.remove("u1");
     EXPECT_FALSE(dao.findById("u1").has_value());
 }
 
+TEST_F(StorageDaoTest, DaoOperationsAreTimed) {
+    // 全局注册表被其他测试共享，只比较增量
+    auto count = [](std::string_view name) -> uint64_t {
+        auto snapshot = wechat::log::MetricsRegistry::global().snapshot();
+        auto* h = snapshot.histogram(name);
+        return h ? h->count : 0;
+    };
+    auto errors = [] {
+        auto snapshot = wechat::log::MetricsRegistry::global().snapshot();
+        auto* c = snapshot.counter("db.user.findById.errors");
+        return c ? c->value : 0;
+    };
+    auto inserts = count("db.user.insert");
+    auto finds = count("db.user.findById");
+    auto failures = errors();
+
+    UserDao dao(dbm->db());
+    dao.insert(User{Id("u1")});
+    dao.findById("u1");
+    dbm->db().exec("DROP TABLE users");
+    EXPECT_THROW(dao.findById("u1"), SQLite::Exception);
+
+    EXPECT_EQ(count("db.user.insert"), inserts + 1);
+    EXPECT_EQ(count("db.user.findById"), finds + 2);
+    EXPECT_EQ(errors(), failures + 1);
+}
+
 // ── Friendship ──
 
 TEST_F(StorageDaoTest, FriendshipAddAndQuery) {
@@ -65,9 +93,9 @@ TEST_F(StorageDaoTest, GroupCreateAndMembers) {
     GroupDao dao(dbm->db());
 
     Group g;
-    g.id = "g1";
-    g.ownerId = "u1";
-    g.memberIds = {"u1", "u2", "u3"};
+    g.id = Id("g1");
+    g.ownerId = Id("u1");
+    g.memberIds = {Id("u1"), Id("u2"), Id("u3")};
     dao.insertGroup(g, 1000);
 
     auto found = dao.findGroupById("g1");
@@ -84,7 +112,7 @@ TEST_F(StorageDaoTest, GroupCreateAndMembers) {
 TEST_F(StorageDaoTest, GroupAddRemoveMember) {
     GroupDao dao(dbm->db());
 
-    Group g{"g1", "u1", {"u1"}};
+    Group g{Id("g1"), Id("u1"), {Id("u1")}};
     dao.insertGroup(g, 1000);
 
     dao.addMember("g1", "u4", 2000);
@@ -105,8 +133,8 @@ TEST_F(StorageDaoTest, GroupAddRemoveMember) {
 TEST_F(StorageDaoTest, GroupIncrementalSync) {
     GroupDao dao(dbm->db());
 
-    dao.insertGroup(Group{"g1", "u1", {"u1"}}, 1000);
-    dao.insertGroup(Group{"g2", "u2", {"u2"}}, 2000);
+    dao.insertGroup(Group{Id("g1"), Id("u1"), {Id("u1")}}, 1000);
+    dao.insertGroup(Group{Id("g2"), Id("u2"), {Id("u2")}}, 2000);
 
     auto updated = dao.findGroupsUpdatedAfter(1500);
     EXPECT_EQ(updated.size(), 1u);
@@ -119,17 +147,17 @@ TEST_F(StorageDaoTest, MessageInsertAndFind) {
     MessageDao dao(dbm->db());
 
     Message msg;
-    msg.id = "m1";
-    msg.senderId = "u1";
-    msg.chatId = "g1";
-    msg.replyTo = "";
+    msg.id = Id("m1");
+    msg.senderId = Id("u1");
+    msg.chatId = Id("g1");
+    msg.replyTo = Id("");
     msg.content = {
         TextContent{"hello"},
         ResourceContent{
             "res001",
             ResourceType::Image,
             ResourceSubtype::Jpeg,
-            ResourceMeta{1024, "photo.jpg", {{"width", "800"}, {"height", "600"}}}
+            ResourceMeta{1024, "photo.jpg", ImageAttributes{800, 600}, {}}
         }
     };
     msg.timestamp = 1000;
@@ -159,7 +187,11 @@ TEST_F(StorageDaoTest, MessageInsertAndFind) {
     EXPECT_EQ(res->subtype, ResourceSubtype::Jpeg);
     EXPECT_EQ(res->meta.size, 1024u);
     EXPECT_EQ(res->meta.filename, "photo.jpg");
-    EXPECT_EQ(res->meta.extra.at("width"), "800");
+    auto* image = std::get_if<ImageAttributes>(&res->meta.media);
+    ASSERT_NE(image, nullptr);
+    EXPECT_EQ(image->width, 800u);
+    EXPECT_EQ(image->height, 600u);
+    EXPECT_TRUE(res->meta.extra.empty());
 }
 
 TEST_F(StorageDaoTest, MessagePagination) {
@@ -167,9 +199,9 @@ TEST_F(StorageDaoTest, MessagePagination) {
 
     for (int i = 1; i <= 5; ++i) {
         Message m;
-        m.id = "m" + std::to_string(i);
-        m.senderId = "u1";
-        m.chatId = "g1";
+        m.id = Id("m" + std::to_string(i));
+        m.senderId = Id("u1");
+        m.chatId = Id("g1");
         m.content = {TextContent{"msg " + std::to_string(i)}};
         m.timestamp = i * 1000;
         m.editedAt = 0;
@@ -186,11 +218,114 @@ TEST_F(StorageDaoTest, MessagePagination) {
     EXPECT_EQ(page[1].id, "m2");
 }
 
+TEST_F(StorageDaoTest, MessagePageDecodesIntoArena) {
+    MessageDao dao(dbm->db());
+
+    for (int i = 1; i <= 3; ++i) {
+        Message m{};
+        m.id = Id("m" + std::to_string(i));
+        m.senderId = Id("u1");
+        m.chatId = Id("g1");
+        m.content = {
+            TextContent{"a text block that does not fit in SSO " +
+                        std::to_string(i)},
+            ResourceContent{std::pmr::string("res" + std::to_string(i)),
+                            ResourceType::Image,
+                            ResourceSubtype::Png,
+                            ResourceMeta{64, "a.png", ImageAttributes{10, 10},
+                                         {{"camera", "x100"}}}}};
+        m.timestamp = i * 1000;
+        dao.insert(m);
+    }
+
+    auto page = dao.findAfter("g1", 0, 10);
+    ASSERT_EQ(page.size(), 3u);
+    auto arena = page.allocator();
+    for (auto& msg : page) {
+        EXPECT_EQ(msg.content.get_allocator(), arena);
+        auto* res = std::get_if<ResourceContent>(&msg.content[1]);
+        ASSERT_NE(res, nullptr);
+        EXPECT_EQ(res->resourceId.get_allocator(), arena);
+        EXPECT_EQ(res->meta.extra.get_allocator(), arena);
+        EXPECT_EQ(std::get<ImageAttributes>(res->meta.media).width, 10u);
+        EXPECT_EQ(res->meta.extra.at("camera"), "x100");
+    }
+
+    // 拷贝出页的消息回到默认堆，页释放后仍然有效
+    auto copies = page.toVector();
+    page = MessagePage();
+    EXPECT_EQ(copies[2].content.get_allocator(),
+              std::pmr::polymorphic_allocator<>());
+    auto* text = std::get_if<TextContent>(&copies[2].content[0]);
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(text->text, "a text block that does not fit in SSO 3");
+}
+
+TEST(ContentSerializationTest, TypedMediaRoundTrip) {
+    MessageContent content = {
+        ResourceContent{"v1", ResourceType::Video, ResourceSubtype::Mp4,
+                        ResourceMeta{10, "a.mp4", VideoAttributes{1920, 1080, 120},
+                                     {}}},
+        ResourceContent{"a1", ResourceType::Audio, ResourceSubtype::Mp3,
+                        ResourceMeta{5, "a.mp3", AudioAttributes{30},
+                                     {{"codec", "lame"}}}},
+        ResourceContent{"f1", ResourceType::File, ResourceSubtype::Pdf,
+                        ResourceMeta{1, "a.pdf", {}, {}}}};
+
+    auto decoded = deserializeContent(serializeContent(content));
+    ASSERT_EQ(decoded.size(), 3u);
+    auto& video = std::get<ResourceContent>(decoded[0]).meta;
+    auto& attrs = std::get<VideoAttributes>(video.media);
+    EXPECT_EQ(attrs.width, 1920u);
+    EXPECT_EQ(attrs.height, 1080u);
+    EXPECT_EQ(attrs.duration, 120u);
+    auto& audio = std::get<ResourceContent>(decoded[1]).meta;
+    EXPECT_EQ(std::get<AudioAttributes>(audio.media).duration, 30u);
+    EXPECT_EQ(audio.extra.at("codec"), "lame");
+    auto& file = std::get<ResourceContent>(decoded[2]).meta;
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(file.media));
+}
+
+TEST(ContentSerializationTest, DecodeOnExecutor) {
+    Executor pool(ExecutorOptions{.threads = 1});
+    MessageContent content = {TextContent{"decoded off the caller thread"}};
+    auto decoded =
+        deserializeContentAsync(pool, serializeContent(content),
+                                TaskPriority::High)
+            .get();
+    ASSERT_EQ(decoded.size(), 1u);
+    EXPECT_EQ(std::get<TextContent>(decoded[0]).text,
+              "decoded off the caller thread");
+
+    CancellationSource cancel;
+    cancel.cancel();
+    auto skipped = deserializeContentAsync(pool, "[]", TaskPriority::Low,
+                                           cancel.token());
+    EXPECT_THROW(skipped.get(), TaskCancelled);
+}
+
+TEST(ContentSerializationTest, LegacyStringExtraMigratesToTypedFields) {
+    // 旧格式：宽高以字符串存在 extra 里
+    auto decoded = deserializeContent(
+        R"([{"type":2,"resourceId":"r","resType":0,"resSubtype":1,)"
+        R"("meta":{"size":3,"filename":"p.jpg","extra":)"
+        R"({"width":"800","height":"600","duration":"9","note":"x"}}}])");
+    ASSERT_EQ(decoded.size(), 1u);
+    auto& meta = std::get<ResourceContent>(decoded[0]).meta;
+    auto& image = std::get<ImageAttributes>(meta.media);
+    EXPECT_EQ(image.width, 800u);
+    EXPECT_EQ(image.height, 600u);
+    // 图片没有时长，未识别的键保留在 extra
+    EXPECT_EQ(meta.extra.size(), 2u);
+    EXPECT_EQ(meta.extra.at("duration"), "9");
+    EXPECT_EQ(meta.extra.at("note"), "x");
+}
+
 TEST_F(StorageDaoTest, MessageIncrementalSync) {
     MessageDao dao(dbm->db());
 
     Message m1;
-    m1.id = "m1"; m1.senderId = "u1"; m1.chatId = "g1";
+    m1.id = Id("m1"); m1.senderId = Id("u1"); m1.chatId = Id("g1");
     m1.content = {TextContent{"v1"}};
     m1.timestamp = 1000; m1.editedAt = 0;
     m1.revoked = false; m1.readCount = 0; m1.updatedAt = 0;
@@ -218,9 +353,9 @@ static void insertMessages(MessageDao& dao, const std::string& chatId,
                            int from, int to) {
     for (int i = from; i <= to; ++i) {
         Message m;
-        m.id = "m" + std::to_string(i);
-        m.senderId = "u1";
-        m.chatId = chatId;
+        m.id = Id("m" + std::to_string(i));
+        m.senderId = Id("u1");
+        m.chatId = Id(chatId);
         m.content = {TextContent{"msg " + std::to_string(i)}};
         m.timestamp = i * 100;  // 有序时间戳
         m.editedAt = 0;
@@ -274,9 +409,9 @@ TEST_F(StorageDaoTest, CacheRealtimePush) {
 
     // 模拟 WS 推送 m51
     Message pushed;
-    pushed.id = "m51";
-    pushed.senderId = "u2";
-    pushed.chatId = "g1";
+    pushed.id = Id("m51");
+    pushed.senderId = Id("u2");
+    pushed.chatId = Id("g1");
     pushed.content = {TextContent{"realtime msg"}};
     pushed.timestamp = 5100;
     pushed.editedAt = 0;
@@ -362,7 +497,7 @@ TEST_F(StorageDaoTest, MessageReadCount) {
 TEST_F(StorageDaoTest, GroupMemberChangeSync) {
     GroupDao dao(dbm->db());
 
-    dao.insertGroup(Group{"g1", "u1", {"u1", "u2"}}, 1000);
+    dao.insertGroup(Group{Id("g1"), Id("u1"), {Id("u1"), Id("u2")}}, 1000);
 
     // t=2000 加入 u3
     dao.addMember("g1", "u3", 2000);
@@ -387,7 +522,7 @@ TEST_F(StorageDaoTest, GroupMemberChangeSync) {
 TEST_F(StorageDaoTest, GroupOwnerChangeSync) {
     GroupDao dao(dbm->db());
 
-    dao.insertGroup(Group{"g1", "u1", {"u1", "u2"}}, 1000);
+    dao.insertGroup(Group{Id("g1"), Id("u1"), {Id("u1"), Id("u2")}}, 1000);
 
     // t=5000 转让群主
     dao.updateOwner("g1", "u2", 5000);